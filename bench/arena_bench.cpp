@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+
+#include "bench_database.h"
+#include "server/memory/memory_tracker.h"
+#include "server/memory/request_arena.h"
+#include "server/service/booking_service.h"
+
+// Przydziały ze sterty na żądanie widoku piętra i odczytu rezerwacji:
+// odpowiedź budowana na stercie oraz w arenie żądania. Licznik zastępuje
+// globalne operatory new, więc plik jest budowany jako osobny cel
+// deskpp_alloc_bench i nie spowalnia pozostałych benchmarków. Licznik
+// obejmuje cały proces, więc benchmarki korzystają z niego jednowątkowo.
+// Przy budowie z DESKPP_MEMORY_TRACKING operatory new zastępuje już serwer
+// i licznikiem są jego przydziały.
+
+namespace {
+#ifdef DESKPP_MEMORY_TRACKING
+    uint64_t heapAllocationCount() {
+        return MemoryTracker::totalAllocations();
+    }
+#else
+    std::atomic<uint64_t> heapAllocations{0};
+
+    uint64_t heapAllocationCount() {
+        return heapAllocations.load(std::memory_order_relaxed);
+    }
+
+    void *countedAllocate(size_t size, size_t alignment) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        size = size == 0 ? 1 : size;
+        void *pointer = alignment <= alignof(std::max_align_t)
+                            ? std::malloc(size)
+                            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (!pointer) {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+#endif
+
+    /**
+     * @brief Wykonuje operację serwisu wraz z serializacją odpowiedzi
+     * @param state Stan benchmarku
+     * @param useArena Czy budować odpowiedź w arenie żądania
+     * @param request Operacja serwisu zwracająca ArenaJson
+     */
+    template<typename Request>
+    void serveRequests(benchmark::State &state, bool useArena, Request request) {
+        uint64_t allocations = 0;
+        uint64_t arenaAllocations = 0;
+        for (auto _: state) {
+            uint64_t before = heapAllocationCount();
+            {
+                std::optional<RequestArena> arena;
+                if (useArena) {
+                    arena.emplace();
+                }
+                std::string body;
+                {
+                    ArenaScope arenaScope(arena ? &*arena : nullptr);
+                    ArenaJson response = request();
+                    body = response.dump();
+                }
+                benchmark::DoNotOptimize(body);
+                arenaAllocations += arena ? arena->allocations() : 0;
+            }
+            allocations += heapAllocationCount() - before;
+        }
+        state.counters["heapAllocs"] = benchmark::Counter(static_cast<double>(allocations),
+                                                          benchmark::Counter::kAvgIterations);
+        state.counters["arenaAllocs"] = benchmark::Counter(static_cast<double>(arenaAllocations),
+                                                           benchmark::Counter::kAvgIterations);
+    }
+
+    struct BenchService {
+        explicit BenchService(int64_t bookingCount)
+            : db(openBenchDatabase(bookingCount)), buildingRepository(db), deskRepository(db),
+              bookingRepository(db), service(buildingRepository, deskRepository, bookingRepository) {
+        }
+
+        std::shared_ptr<SQLite::Database> db;
+        BuildingRepository buildingRepository;
+        DeskRepository deskRepository;
+        BookingRepository bookingRepository;
+        BookingService service;
+    };
+}
+
+#ifndef DESKPP_MEMORY_TRACKING
+void *operator new(size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void *operator new(size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+#endif
+
+static void BM_FloorView(benchmark::State &state) {
+    BenchService bench(state.range(0));
+    int floor = 1;
+    serveRequests(state, state.range(1) != 0, [&] {
+        floor = floor % BenchDatabaseLayout::Floors + 1;
+        return bench.service.getDesksByBuildingAndFloor(BenchDatabaseLayout::BuildingId, floor);
+    });
+}
+BENCHMARK(BM_FloorView)
+    ->ArgNames({"bookings", "arena"})
+    ->ArgsProduct({{10'000, 100'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_UserBookings(benchmark::State &state) {
+    BenchService bench(state.range(0));
+    int userId = 1;
+    serveRequests(state, state.range(1) != 0, [&] {
+        userId = userId % BenchDatabaseLayout::Users + 1;
+        return bench.service.getUserBookings(userId, "", "", BookingService::DefaultUserBookingsPage);
+    });
+}
+BENCHMARK(BM_UserBookings)
+    ->ArgNames({"bookings", "arena"})
+    ->ArgsProduct({{100'000}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_DeskBookings(benchmark::State &state) {
+    BenchService bench(state.range(0));
+    int deskId = 1;
+    serveRequests(state, state.range(1) != 0, [&] {
+        deskId = deskId % (BenchDatabaseLayout::Floors * BenchDatabaseLayout::DesksPerFloor) + 1;
+        return bench.service.getBookingsForDesk(deskId, "2020-01-01", "2020-12-31");
+    });
+}
+BENCHMARK(BM_DeskBookings)
+    ->ArgNames({"bookings", "arena"})
+    ->ArgsProduct({{100'000}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
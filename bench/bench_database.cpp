@@ -0,0 +1,67 @@
+#include "bench_database.h"
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "server/repository/database_schema.h"
+#include "server/repository/data_generator.h"
+
+namespace {
+    std::filesystem::path benchDirectory() {
+        if (const char *dir = std::getenv("DESKPP_BENCH_DIR")) {
+            return dir;
+        }
+        return std::filesystem::temp_directory_path();
+    }
+
+    /**
+     * @brief Wypełnia bazę danymi o stałym układzie budynku i pięter
+     */
+    void seed(SQLite::Database &db, int64_t bookingCount) {
+        using Layout = BenchDatabaseLayout;
+
+        createDatabaseSchema(db);
+
+        DataGenerator::Options options;
+        options.buildings = 1;
+        options.minFloors = Layout::Floors;
+        options.maxFloors = Layout::Floors;
+        options.desksPerFloor = Layout::DesksPerFloor;
+        options.users = Layout::Users;
+        options.bookings = bookingCount;
+        options.startDate = Layout::StartDate;
+        DataGenerator(db, options).generate();
+    }
+}
+
+std::string benchDatabasePath(int64_t bookingCount) {
+    auto path = benchDirectory() / ("deskpp_bench_v" + std::to_string(BenchDatabaseLayout::Version) + "_" +
+                                    std::to_string(bookingCount) + ".sqlite");
+    auto partial = path;
+    partial += ".partial";
+
+    // Wypełniona baza trafia pod docelową nazwę dopiero po zatwierdzeniu transakcji
+    if (!std::filesystem::exists(path)) {
+        std::filesystem::remove(partial);
+        {
+            SQLite::Database db(partial.string(), SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+            seed(db, bookingCount);
+        }
+        std::filesystem::rename(partial, path);
+    }
+    return path.string();
+}
+
+std::shared_ptr<SQLite::Database> openBenchDatabase(int64_t bookingCount) {
+    static std::map<int64_t, std::shared_ptr<SQLite::Database>> databases;
+
+    auto it = databases.find(bookingCount);
+    if (it != databases.end()) {
+        return it->second;
+    }
+
+    auto db = std::make_shared<SQLite::Database>(benchDatabasePath(bookingCount), SQLite::OPEN_READWRITE);
+    databases.emplace(bookingCount, db);
+    return db;
+}
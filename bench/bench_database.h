@@ -0,0 +1,53 @@
+#ifndef BENCH_DATABASE_H
+#define BENCH_DATABASE_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Parametry bazy danych używanej w benchmarkach
+ */
+struct BenchDatabaseLayout {
+    static constexpr int Floors = 10;
+    static constexpr int DesksPerFloor = 50;
+    static constexpr int Users = 2000;
+    static constexpr int BuildingId = 1;
+    static constexpr const char *StartDate = "2020-01-01";
+
+    /**
+     * @brief Wersja układu danych i schematu bazy, zapisywana w nazwie pliku
+     *
+     * Należy ją zwiększyć przy zmianie parametrów powyżej, generatora lub
+     * schematu, aby benchmarki nie używały baz utworzonych w starym układzie.
+     */
+    static constexpr int Version = 3;
+};
+
+/**
+ * @brief Otwiera bazę danych z zadaną liczbą rezerwacji
+ *
+ * Dane tworzy DataGenerator z ustalonym ziarnem. Bazy są zapisywane
+ * w katalogu z DESKPP_BENCH_DIR (domyślnie katalog tymczasowy), pod nazwą
+ * zawierającą wersję układu i liczbę rezerwacji, i tworzone tylko przy
+ * pierwszym użyciu, więc kolejne uruchomienia nie płacą
+ * za wypełnianie dużych tabel. W obrębie procesu
+ * połączenie do bazy danego rozmiaru jest współdzielone.
+ *
+ * @param bookingCount Liczba rezerwacji w bazie
+ * @return Współdzielony wskaźnik do bazy danych
+ */
+std::shared_ptr<SQLite::Database> openBenchDatabase(int64_t bookingCount);
+
+/**
+ * @brief Zwraca ścieżkę bazy danych z zadaną liczbą rezerwacji (tworząc ją w razie potrzeby)
+ *
+ * Pozwala otworzyć osobne połączenia, np. jedno na wątek benchmarku.
+ *
+ * @param bookingCount Liczba rezerwacji w bazie
+ * @return Ścieżka do pliku bazy danych
+ */
+std::string benchDatabasePath(int64_t bookingCount);
+
+#endif
@@ -0,0 +1,223 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "server/repository/booking_record.h"
+
+// Rezerwacje w pamięci serwera: wektor encji Booking, wektor rekordów
+// BookingRecord, kolumnowe bloki BookingBlock biurek oraz dawny stan potoku
+// zapisu (std::map na biurko i indeks położeń). Benchmarki BM_BookingMemory*
+// podają pamięć na rezerwację (licznik bytesPerBooking, bez narzutu malloc),
+// a BM_BookingScan* liczbę przejrzanych rezerwacji na sekundę przy liczeniu
+// zajętych biurek w wybranym dniu.
+
+namespace {
+    constexpr int DeskCount = 1000;
+
+    size_t allocatedBytes = 0;
+
+    /**
+     * @brief Alokator kontenerów standardowych zliczający przydzielone bajty
+     */
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U> &) {
+        }
+
+        T *allocate(size_t count) {
+            allocatedBytes += count * sizeof(T);
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T *pointer, size_t count) {
+            allocatedBytes -= count * sizeof(T);
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U> &) const { return true; }
+    };
+
+    /**
+     * @brief Tworzy nienakładające się rezerwacje biurek, posortowane po biurku i dacie
+     */
+    std::vector<BookingRecord> makeRecords(int64_t count) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> lengthDist(0, 4);
+        std::uniform_int_distribution<int> gapDist(1, 3);
+        std::uniform_int_distribution<int> userDist(1, 5000);
+        std::vector<BookingRecord> records;
+        records.reserve(static_cast<size_t>(count));
+        const int64_t perDesk = (count + DeskCount - 1) / DeskCount;
+        for (int desk = 1; desk <= DeskCount && static_cast<int64_t>(records.size()) < count; ++desk) {
+            int day = BookingRecord::dayOf(Date(2020, 1, 1));
+            for (int64_t i = 0; i < perDesk && static_cast<int64_t>(records.size()) < count; ++i) {
+                int length = lengthDist(rng);
+                records.push_back({static_cast<int32_t>(records.size() + 1), desk, userDist(rng),
+                                   static_cast<uint16_t>(day), static_cast<uint16_t>(day + length)});
+                day += length + gapDist(rng);
+            }
+        }
+        return records;
+    }
+
+    std::vector<BookingBlock> makeBlocks(const std::vector<BookingRecord> &records) {
+        std::vector<BookingBlock> blocks(DeskCount + 1);
+        for (const auto &record: records) {
+            blocks[record.deskId].insert(record);
+        }
+        return blocks;
+    }
+
+    uint16_t scannedDay() {
+        return BookingRecord::dayOf(Date(2021, 6, 15));
+    }
+
+    void setBytesPerBooking(benchmark::State &state, size_t bytes) {
+        state.counters["bytesPerBooking"] = static_cast<double>(bytes) / static_cast<double>(state.range(0));
+    }
+
+    void setItems(benchmark::State &state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void memoryArgs(benchmark::internal::Benchmark *bench) {
+        bench->ArgName("bookings")->Arg(100'000)->Unit(benchmark::kMillisecond);
+    }
+
+    void scanArgs(benchmark::internal::Benchmark *bench) {
+        bench->ArgName("bookings")->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+    }
+}
+
+static void BM_BookingMemoryEntities(benchmark::State &state) {
+    auto records = makeRecords(state.range(0));
+    size_t bytes = 0;
+    for (auto _: state) {
+        size_t before = allocatedBytes;
+        std::vector<Booking, CountingAllocator<Booking>> bookings;
+        for (const auto &record: records) {
+            bookings.push_back(record.toBooking());
+        }
+        bytes = allocatedBytes - before;
+        benchmark::DoNotOptimize(bookings.data());
+    }
+    setBytesPerBooking(state, bytes);
+}
+BENCHMARK(BM_BookingMemoryEntities)->Apply(memoryArgs);
+
+static void BM_BookingMemoryRecords(benchmark::State &state) {
+    auto records = makeRecords(state.range(0));
+    size_t bytes = 0;
+    for (auto _: state) {
+        size_t before = allocatedBytes;
+        std::vector<BookingRecord, CountingAllocator<BookingRecord>> copy;
+        for (const auto &record: records) {
+            copy.push_back(record);
+        }
+        bytes = allocatedBytes - before;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    setBytesPerBooking(state, bytes);
+}
+BENCHMARK(BM_BookingMemoryRecords)->Apply(memoryArgs);
+
+static void BM_BookingMemoryBlocks(benchmark::State &state) {
+    auto records = makeRecords(state.range(0));
+    size_t bytes = 0;
+    for (auto _: state) {
+        auto blocks = makeBlocks(records);
+        bytes = 0;
+        for (const auto &block: blocks) {
+            bytes += block.memoryBytes();
+        }
+        benchmark::DoNotOptimize(blocks.data());
+    }
+    setBytesPerBooking(state, bytes);
+}
+BENCHMARK(BM_BookingMemoryBlocks)->Apply(memoryArgs);
+
+static void BM_BookingMemoryWriterCache(benchmark::State &state) {
+    using Key = std::pair<int, int>;
+    using DeskBookings = std::map<Key, int, std::less<>, CountingAllocator<std::pair<const Key, int>>>;
+    auto records = makeRecords(state.range(0));
+    size_t bytes = 0;
+    for (auto _: state) {
+        size_t before = allocatedBytes;
+        // Dawny stan potoku zapisu: (dzień początkowy, ID) -> dzień końcowy oraz ID -> (biurko, dzień)
+        std::unordered_map<int, DeskBookings, std::hash<int>, std::equal_to<>,
+                           CountingAllocator<std::pair<const int, DeskBookings>>> desks;
+        std::unordered_map<int, Key, std::hash<int>, std::equal_to<>,
+                           CountingAllocator<std::pair<const int, Key>>> locations;
+        for (const auto &record: records) {
+            desks[record.deskId].emplace(Key{record.dayFrom, record.id}, record.dayTo);
+            locations[record.id] = {record.deskId, record.dayFrom};
+        }
+        bytes = allocatedBytes - before;
+        benchmark::DoNotOptimize(desks.size());
+    }
+    setBytesPerBooking(state, bytes);
+}
+BENCHMARK(BM_BookingMemoryWriterCache)->Apply(memoryArgs);
+
+static void BM_BookingScanEntities(benchmark::State &state) {
+    std::vector<Booking> bookings;
+    for (const auto &record: makeRecords(state.range(0))) {
+        bookings.push_back(record.toBooking());
+    }
+    Date date = BookingRecord::dateOf(scannedDay());
+    for (auto _: state) {
+        int64_t occupied = 0;
+        for (const auto &booking: bookings) {
+            occupied += booking.getDateFrom() <= date && booking.getDateTo() >= date;
+        }
+        benchmark::DoNotOptimize(occupied);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_BookingScanEntities)->Apply(scanArgs);
+
+static void BM_BookingScanRecords(benchmark::State &state) {
+    auto records = makeRecords(state.range(0));
+    uint16_t day = scannedDay();
+    for (auto _: state) {
+        int64_t occupied = 0;
+        for (const auto &record: records) {
+            occupied += record.overlaps(day, day);
+        }
+        benchmark::DoNotOptimize(occupied);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_BookingScanRecords)->Apply(scanArgs);
+
+static void BM_BookingScanBlocks(benchmark::State &state) {
+    auto blocks = makeBlocks(makeRecords(state.range(0)));
+    uint16_t day = scannedDay();
+    for (auto _: state) {
+        int64_t occupied = 0;
+        for (const auto &block: blocks) {
+            auto from = block.daysFrom();
+            auto to = block.daysTo();
+            int32_t blockOccupied = 0;
+            for (size_t i = 0; i < from.size(); ++i) {
+                blockOccupied += (from[i] <= day) & (to[i] >= day);
+            }
+            occupied += blockOccupied;
+        }
+        benchmark::DoNotOptimize(occupied);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_BookingScanBlocks)->Apply(scanArgs);
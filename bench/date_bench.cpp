@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/model/date.h"
+
+// Odczyt i zapis dat yyyy-MM-dd: pojedynczo i w pętli po kolumnie. Punktem
+// odniesienia jest sscanf/snprintf (jak w dawnym generatorze danych) oraz
+// pętla po znakach. Licznik items_per_second podaje liczbę dat na sekundę.
+
+namespace {
+    constexpr size_t ColumnSize = 4096;
+
+    std::vector<Date> randomDates() {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> dayDist(Date(2000, 1, 1).toDays(), Date(2040, 12, 31).toDays());
+        std::vector<Date> dates(ColumnSize);
+        for (auto &date: dates) {
+            date = Date::fromDays(dayDist(rng));
+        }
+        return dates;
+    }
+
+    std::vector<std::string> randomTexts() {
+        std::vector<std::string> texts;
+        texts.reserve(ColumnSize);
+        for (Date date: randomDates()) {
+            texts.push_back(date.toString());
+        }
+        return texts;
+    }
+
+    /**
+     * @brief Odczyt pętlą po znakach (wyznaczenie Date::fromString w czasie kompilacji)
+     */
+    Date parseByCharacters(std::string_view text) {
+        if (text.size() != Date::TextLength || text[4] != '-' || text[7] != '-') {
+            return {};
+        }
+        int fields[3] = {0, 0, 0};
+        int field = 0;
+        for (size_t i = 0; i < Date::TextLength; ++i) {
+            if (i == 4 || i == 7) {
+                ++field;
+                continue;
+            }
+            if (text[i] < '0' || text[i] > '9') {
+                return {};
+            }
+            fields[field] = fields[field] * 10 + (text[i] - '0');
+        }
+        return Date(fields[0], fields[1], fields[2]);
+    }
+
+    void setItems(benchmark::State &state) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ColumnSize));
+    }
+}
+
+static void BM_DateParseSscanf(benchmark::State &state) {
+    auto texts = randomTexts();
+    for (auto _: state) {
+        for (const auto &text: texts) {
+            int year = 0, month = 0, day = 0;
+            std::sscanf(text.c_str(), "%d-%d-%d", &year, &month, &day);
+            benchmark::DoNotOptimize(Date(year, month, day));
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateParseSscanf);
+
+static void BM_DateParseCharacters(benchmark::State &state) {
+    auto texts = randomTexts();
+    for (auto _: state) {
+        for (const auto &text: texts) {
+            benchmark::DoNotOptimize(parseByCharacters(text));
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateParseCharacters);
+
+static void BM_DateParse(benchmark::State &state) {
+    auto texts = randomTexts();
+    for (auto _: state) {
+        for (const auto &text: texts) {
+            benchmark::DoNotOptimize(Date::fromString(text));
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateParse);
+
+static void BM_DateParseColumn(benchmark::State &state) {
+    std::string column(ColumnSize * Date::TextLength, ' ');
+    Date::formatColumn(randomDates(), column.data());
+    std::vector<Date> dates(ColumnSize);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(Date::parseColumn(column.data(), ColumnSize, dates.data()));
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateParseColumn);
+
+static void BM_DateFormatSnprintf(benchmark::State &state) {
+    auto dates = randomDates();
+    char buffer[16];
+    for (auto _: state) {
+        for (Date date: dates) {
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", date.year(), date.month(), date.day());
+            benchmark::DoNotOptimize(buffer);
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateFormatSnprintf);
+
+static void BM_DateFormat(benchmark::State &state) {
+    auto dates = randomDates();
+    char buffer[Date::TextLength];
+    for (auto _: state) {
+        for (Date date: dates) {
+            benchmark::DoNotOptimize(date.format(buffer));
+            benchmark::ClobberMemory();
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateFormat);
+
+static void BM_DateFormatColumn(benchmark::State &state) {
+    auto dates = randomDates();
+    std::string column(ColumnSize * Date::TextLength, ' ');
+    for (auto _: state) {
+        Date::formatColumn(dates, column.data());
+        benchmark::DoNotOptimize(column.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_DateFormatColumn);
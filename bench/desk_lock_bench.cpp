@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <random>
+#include <utility>
+
+#include "bench_database.h"
+#include "server/repository/booking_repository.h"
+#include "server/service/desk_lock_table.h"
+
+// Porównanie synchronizacji zapisu rezerwacji (sprawdzenie konfliktów, zapis,
+// a następnie anulowanie) przy wielu wątkach. Blokady biurek i globalny
+// mutex przechodzą tę samą ścieżkę co serwer: sprawdzenie na połączeniu
+// współdzielonym i zapis w transakcji BookingRepository::beginWrite na
+// połączeniu zapisu. BEGIN IMMEDIATE obejmuje też sprawdzenie, na osobnym
+// połączeniu wątku i bez blokad aplikacji. Każda iteracja usuwa dodaną
+// rezerwację, więc baza benchmarków pozostaje bez zmian.
+
+namespace {
+    constexpr int64_t BookingCount = 10'000;
+    constexpr int DeskCount = BenchDatabaseLayout::Floors * BenchDatabaseLayout::DesksPerFloor;
+
+    // Termin, w którym baza benchmarków nie ma rezerwacji
+    constexpr const char *BookingDate = "2099-01-01";
+
+    void threadCounts(benchmark::internal::Benchmark *benchmark) {
+        for (int threads: {1, 2, 4, 8}) {
+            benchmark->Threads(threads);
+        }
+        benchmark->UseRealTime()->Unit(benchmark::kMicrosecond);
+    }
+
+    Booking newBooking(int deskId, int userId) {
+        Booking booking;
+        booking.setDeskId(deskId);
+        booking.setUserId(userId);
+        booking.setDateFrom(BookingDate);
+        booking.setDateTo(BookingDate);
+        return booking;
+    }
+
+    /**
+     * @brief Dodaje rezerwację, jeśli termin jest wolny
+     * @return ID rezerwacji lub 0 przy konflikcie
+     */
+    int checkAndInsert(BookingRepository &repository, int deskId, int userId) {
+        if (repository.hasOverlappingBooking(deskId, BookingDate, BookingDate)) {
+            return 0;
+        }
+        return repository.add(newBooking(deskId, userId)).getId();
+    }
+
+    /**
+     * @brief Dodaje rezerwację tak jak serwer (zapis w transakcji beginWrite)
+     * @return ID rezerwacji lub 0 przy konflikcie
+     */
+    int checkAndWrite(BookingRepository &repository, int deskId, int userId) {
+        if (repository.hasOverlappingBooking(deskId, BookingDate, BookingDate)) {
+            return 0;
+        }
+        auto transaction = repository.beginWrite();
+        int bookingId = transaction.repository().add(newBooking(deskId, userId)).getId();
+        transaction.commit();
+        return bookingId;
+    }
+
+    /**
+     * @brief Usuwa rezerwację tak jak serwer (w transakcji beginWrite)
+     */
+    void removeWritten(BookingRepository &repository, int bookingId) {
+        auto transaction = repository.beginWrite();
+        transaction.repository().remove(bookingId);
+        transaction.commit();
+    }
+
+    /**
+     * @brief Sumuje pobrania blokad (wszystkie i te, które czekały)
+     */
+    std::pair<uint64_t, uint64_t> lockTotals(const DeskLockTable &locks) {
+        uint64_t acquisitions = 0, contended = 0;
+        for (const auto &stripe: locks.stats()) {
+            acquisitions += stripe.acquisitions;
+            contended += stripe.contended;
+        }
+        return {acquisitions, contended};
+    }
+
+    /**
+     * @brief Losuje biurko dla wątku (ziarno zależne od numeru wątku)
+     */
+    class DeskPicker {
+    public:
+        explicit DeskPicker(int thread) : _rng(thread + 1), _desks(1, DeskCount) {
+        }
+
+        int next() { return _desks(_rng); }
+
+    private:
+        std::mt19937 _rng;
+        std::uniform_int_distribution<int> _desks;
+    };
+}
+
+static void BM_DeskWriteStripedLocks(benchmark::State &state) {
+    static DeskLockTable locks;
+    static BookingRepository repository(openBenchDatabase(BookingCount));
+    DeskPicker picker(state.thread_index());
+
+    // Pozostałe wątki czekają na początku pętli, aż wszystkie będą gotowe
+    auto before = state.thread_index() == 0 ? lockTotals(locks) : std::pair<uint64_t, uint64_t>{};
+
+    for (auto _: state) {
+        int deskId = picker.next();
+        int bookingId;
+        {
+            auto lock = locks.lock(deskId);
+            bookingId = checkAndWrite(repository, deskId, 1);
+        }
+        if (bookingId) {
+            auto lock = locks.lock(deskId);
+            removeWritten(repository, bookingId);
+        }
+    }
+
+    if (state.thread_index() == 0) {
+        auto after = lockTotals(locks);
+        uint64_t acquisitions = after.first - before.first;
+        uint64_t contended = after.second - before.second;
+        state.counters["contended%"] = acquisitions ? 100.0 * static_cast<double>(contended) / acquisitions : 0.0;
+    }
+}
+BENCHMARK(BM_DeskWriteStripedLocks)->Apply(threadCounts);
+
+static void BM_DeskWriteGlobalMutex(benchmark::State &state) {
+    static std::mutex mutex;
+    static BookingRepository repository(openBenchDatabase(BookingCount));
+    DeskPicker picker(state.thread_index());
+
+    for (auto _: state) {
+        int deskId = picker.next();
+        int bookingId;
+        {
+            std::lock_guard lock(mutex);
+            bookingId = checkAndWrite(repository, deskId, 1);
+        }
+        if (bookingId) {
+            std::lock_guard lock(mutex);
+            removeWritten(repository, bookingId);
+        }
+    }
+}
+BENCHMARK(BM_DeskWriteGlobalMutex)->Apply(threadCounts);
+
+static void BM_DeskWriteBeginImmediate(benchmark::State &state) {
+    static const std::string path = benchDatabasePath(BookingCount);
+    auto db = std::make_shared<SQLite::Database>(path, SQLite::OPEN_READWRITE);
+    db->setBusyTimeout(10000);
+    BookingRepository repository(db);
+    DeskPicker picker(state.thread_index());
+
+    for (auto _: state) {
+        int deskId = picker.next();
+        int bookingId;
+        {
+            SQLite::Transaction transaction(*db, SQLite::TransactionBehavior::IMMEDIATE);
+            bookingId = checkAndInsert(repository, deskId, 1);
+            transaction.commit();
+        }
+        if (bookingId) {
+            SQLite::Transaction transaction(*db, SQLite::TransactionBehavior::IMMEDIATE);
+            repository.remove(bookingId);
+            transaction.commit();
+        }
+    }
+}
+BENCHMARK(BM_DeskWriteBeginImmediate)->Apply(threadCounts);
@@ -0,0 +1,107 @@
+#include <QApplication>
+#include <QScrollArea>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "client/ui/desk_map_widget.h"
+#include "client/ui/qt_date.h"
+
+namespace {
+    /**
+     * @brief Generuje piętro z losowymi rezerwacjami w zadanym okresie
+     */
+    std::vector<Desk> makeFloor(int deskCount, Date start, int days) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> dayDist(0, days - 1);
+        std::uniform_int_distribution<int> lengthDist(0, 4);
+        std::uniform_int_distribution<int> userDist(1, 200);
+
+        std::vector<Desk> desks;
+        desks.reserve(deskCount);
+        int bookingId = 1;
+        for (int i = 0; i < deskCount; ++i) {
+            Desk desk(i + 1, "D-" + std::to_string(i + 1), 1, 1);
+            for (int b = 0; b < 6; ++b) {
+                Date from = start.addDays(dayDist(rng));
+                Date to = from.addDays(lengthDist(rng));
+                if (!desk.hasOverlappingBooking(from, to)) {
+                    desk.addBooking(Booking(bookingId++, desk.getId(), userDist(rng), from, to));
+                }
+            }
+            desks.push_back(desk);
+        }
+        return desks;
+    }
+
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values.empty() ? 0.0 : values[values.size() / 2];
+    }
+}
+
+/**
+ * @brief Mierzy czas klatki mapy biurek przy zmianie daty na platformie offscreen
+ *
+ * Porównuje pełną przebudowę kafelków z aktualizacją przyrostową. Kod wyjścia
+ * jest niezerowy, jeśli mediana aktualizacji przyrostowej przekracza 10 ms.
+ */
+int main(int argc, char *argv[]) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    const int deskCount = argc > 1 ? std::max(1, atoi(argv[1])) : 2000;
+    const int days = 60;
+    const QDate start(2025, 1, 1);
+    const int currentUserId = 7;
+    auto desks = makeFloor(deskCount, toDate(start), days);
+
+    QScrollArea scrollArea;
+    scrollArea.setWidgetResizable(true);
+    auto deskMap = new DeskMapWidget();
+    scrollArea.setWidget(deskMap);
+    scrollArea.resize(1280, 900);
+    scrollArea.show();
+    deskMap->setDesks(desks, start, currentUserId);
+    QApplication::processEvents();
+
+    std::vector<double> fullFrames, incrementalFrames;
+    qint64 incrementalTiles = 0;
+    QElapsedTimer timer;
+
+    for (int day = 1; day < days; ++day) {
+        QDate date = start.addDays(day);
+
+        // Pełna przebudowa: komunikat czyści kafelki, jak przy dawnym updateDeskMap
+        deskMap->setMessage("...");
+        QApplication::processEvents();
+        timer.start();
+        deskMap->setDesks(desks, date, currentUserId);
+        QApplication::processEvents();
+        fullFrames.push_back(timer.nsecsElapsed() / 1e6);
+
+        // Aktualizacja przyrostowa względem poprzedniego dnia
+        deskMap->setDesks(desks, date.addDays(-1), currentUserId);
+        QApplication::processEvents();
+        qint64 paintedBefore = deskMap->getPaintedTileCount();
+        timer.start();
+        deskMap->setDesks(desks, date, currentUserId);
+        QApplication::processEvents();
+        incrementalFrames.push_back(timer.nsecsElapsed() / 1e6);
+        incrementalTiles += deskMap->getPaintedTileCount() - paintedBefore;
+    }
+
+    double fullMedian = median(fullFrames);
+    double incrementalMedian = median(incrementalFrames);
+    std::printf("desks=%d frames=%zu\n", deskCount, incrementalFrames.size());
+    std::printf("full_rebuild_median_ms=%.3f\n", fullMedian);
+    std::printf("incremental_median_ms=%.3f\n", incrementalMedian);
+    std::printf("incremental_max_ms=%.3f\n",
+                *std::max_element(incrementalFrames.begin(), incrementalFrames.end()));
+    std::printf("incremental_painted_tiles_per_frame=%.1f\n",
+                static_cast<double>(incrementalTiles) / incrementalFrames.size());
+
+    return incrementalMedian < 10.0 ? 0 : 1;
+}
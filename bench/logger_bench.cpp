@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+
+#include "common/logger.h"
+
+// Czas wywołania LOG_INFO w wątku obsługującym żądanie przy zapisie do pliku
+// z rotacją: logger synchroniczny (zapis pod blokadą ujścia) oraz logger
+// asynchroniczny z różnym zachowaniem przy pełnej kolejce. Komunikat ma
+// rozmiar typowego komunikatu serwera z polami strukturalnymi.
+
+namespace {
+    std::string logPath(const std::string &name) {
+        return (std::filesystem::temp_directory_path() / ("deskpp_bench_" + name + ".log")).string();
+    }
+
+    void threadCounts(benchmark::internal::Benchmark *benchmark) {
+        for (int threads: {1, 2, 4, 8}) {
+            benchmark->Threads(threads);
+        }
+        benchmark->UseRealTime()->Unit(benchmark::kNanosecond);
+    }
+
+    /**
+     * @brief Tworzy logger zapisujący tylko do pliku
+     */
+    std::shared_ptr<spdlog::logger> fileLogger(const std::string &name, bool async, LogOverflowPolicy overflow) {
+        LogOptions options;
+        options.console = false;
+        options.async = async;
+        options.overflow = overflow;
+        options.filePath = logPath(name);
+        options.maxFileSize = 64 * 1024 * 1024;
+        options.maxFiles = 1;
+        return makeLogger("DeskPP-Bench", options);
+    }
+
+    void logMessages(benchmark::State &state, spdlog::logger &logger) {
+        int deskId = state.thread_index();
+        std::string key = "c0ffee-" + std::to_string(deskId);
+        for (auto _: state) {
+            logger.info("Dodano rezerwację{}", logFields("deskId", deskId, "userId", 42, "idempotencyKey", key));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+static void BM_LogSync(benchmark::State &state) {
+    static auto logger = fileLogger("sync", false, LogOverflowPolicy::Block);
+    logMessages(state, *logger);
+}
+BENCHMARK(BM_LogSync)->Apply(threadCounts);
+
+static void BM_LogAsyncBlock(benchmark::State &state) {
+    static auto logger = fileLogger("async_block", true, LogOverflowPolicy::Block);
+    logMessages(state, *logger);
+}
+BENCHMARK(BM_LogAsyncBlock)->Apply(threadCounts);
+
+static void BM_LogAsyncDrop(benchmark::State &state) {
+    static auto logger = fileLogger("async_drop", true, LogOverflowPolicy::Drop);
+    logMessages(state, *logger);
+}
+BENCHMARK(BM_LogAsyncDrop)->Apply(threadCounts);
+
+static void BM_LogAsyncSample(benchmark::State &state) {
+    static auto logger = fileLogger("async_sample", true, LogOverflowPolicy::Sample);
+    logMessages(state, *logger);
+}
+BENCHMARK(BM_LogAsyncSample)->Apply(threadCounts);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "common/model/model.h"
+
+namespace {
+    /**
+     * @brief Tworzy biurko z podaną liczbą kolejnych jednodniowych rezerwacji
+     */
+    Desk makeDesk(int bookingCount) {
+        Desk desk(1, "A1-01", 1, 1);
+        const Date start(2025, 1, 1);
+        for (int i = 0; i < bookingCount; ++i) {
+            Date date = start.addDays(i);
+            desk.addBooking(Booking(i + 1, desk.getId(), 1 + i % 50, date, date));
+        }
+        return desk;
+    }
+
+    const json bookingJson = {
+        {"id", 123},
+        {"deskId", 17},
+        {"userId", 42},
+        {"dateFrom", "2025-03-14"},
+        {"dateTo", "2025-03-21"}
+    };
+}
+
+static void BM_BookingFromJson(benchmark::State &state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(Booking::fromJson(bookingJson));
+    }
+}
+BENCHMARK(BM_BookingFromJson);
+
+static void BM_BookingToJson(benchmark::State &state) {
+    Booking booking = Booking::fromJson(bookingJson);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(booking.toJson());
+    }
+}
+BENCHMARK(BM_BookingToJson);
+
+static void BM_BookingToJsonDump(benchmark::State &state) {
+    Booking booking = Booking::fromJson(bookingJson);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(booking.toJson().dump());
+    }
+}
+BENCHMARK(BM_BookingToJsonDump);
+
+static void BM_BookingSetDateFrom(benchmark::State &state) {
+    Booking booking;
+    const std::string date = "2025-03-14";
+    for (auto _: state) {
+        booking.setDateFrom(date);
+        benchmark::DoNotOptimize(booking);
+    }
+}
+BENCHMARK(BM_BookingSetDateFrom);
+
+static void BM_DeskIsAvailableOn(benchmark::State &state) {
+    const int bookingCount = static_cast<int>(state.range(0));
+    Desk desk = makeDesk(bookingCount);
+    // Dzień po ostatniej rezerwacji wymaga przejrzenia całej listy
+    const Date date = Date(2025, 1, 1).addDays(bookingCount);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(desk.isAvailableOn(date));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DeskIsAvailableOn)->RangeMultiplier(8)->Range(1, 1 << 15)->Complexity();
+
+static void BM_DeskBookingsContainingDate(benchmark::State &state) {
+    const int bookingCount = static_cast<int>(state.range(0));
+    Desk desk = makeDesk(bookingCount);
+    const Date date = Date(2025, 1, 1).addDays(bookingCount / 2);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(desk.getBookingsContainingDate(date));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DeskBookingsContainingDate)->RangeMultiplier(8)->Range(1, 1 << 15)->Complexity();
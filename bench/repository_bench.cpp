@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_database.h"
+#include "server/repository/booking_repository.h"
+
+namespace {
+    /**
+     * @brief Rozmiary baz danych (liczba rezerwacji) używane w benchmarkach
+     */
+    void bookingCounts(benchmark::internal::Benchmark *benchmark) {
+        for (int64_t count: {10'000LL, 100'000LL, 1'000'000LL, 10'000'000LL}) {
+            benchmark->Arg(count);
+        }
+        benchmark->Unit(benchmark::kMicrosecond);
+    }
+
+    constexpr int DeskCount = BenchDatabaseLayout::Floors * BenchDatabaseLayout::DesksPerFloor;
+}
+
+static void BM_BookingRepositoryFindById(benchmark::State &state) {
+    BookingRepository repository(openBenchDatabase(state.range(0)));
+    const int count = static_cast<int>(state.range(0));
+    int id = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(repository.findById(id));
+        // Krok o liczbę pierwszą rozrzuca odczyty po całej tabeli, a ID pozostaje w zakresie 1..count
+        id = (id + 7919) % count + 1;
+    }
+}
+BENCHMARK(BM_BookingRepositoryFindById)->Apply(bookingCounts);
+
+static void BM_BookingRepositoryFindByDeskId(benchmark::State &state) {
+    BookingRepository repository(openBenchDatabase(state.range(0)));
+    int deskId = 1;
+    int64_t rows = 0;
+    for (auto _: state) {
+        auto bookings = repository.findByDeskId(deskId);
+        rows += static_cast<int64_t>(bookings.size());
+        deskId = deskId % DeskCount + 1;
+    }
+    state.counters["rows"] = benchmark::Counter(static_cast<double>(rows), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BookingRepositoryFindByDeskId)->Apply(bookingCounts);
+
+static void BM_BookingRepositoryFindByUserId(benchmark::State &state) {
+    BookingRepository repository(openBenchDatabase(state.range(0)));
+    int userId = 1;
+    int64_t rows = 0;
+    for (auto _: state) {
+        auto bookings = repository.findByUserId(userId);
+        rows += static_cast<int64_t>(bookings.size());
+        userId = userId % BenchDatabaseLayout::Users + 1;
+    }
+    state.counters["rows"] = benchmark::Counter(static_cast<double>(rows), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BookingRepositoryFindByUserId)->Apply(bookingCounts);
+
+static void BM_BookingRepositoryHasOverlappingBooking(benchmark::State &state) {
+    BookingRepository repository(openBenchDatabase(state.range(0)));
+    int deskId = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(repository.hasOverlappingBooking(deskId, "2020-06-01", "2020-06-07"));
+        deskId = deskId % DeskCount + 1;
+    }
+}
+BENCHMARK(BM_BookingRepositoryHasOverlappingBooking)->Apply(bookingCounts);
+
+static void BM_BookingRepositoryCursorByUserId(benchmark::State &state) {
+    BookingRepository repository(openBenchDatabase(state.range(0)));
+    int userId = 1;
+    int64_t rows = 0;
+    for (auto _: state) {
+        for (const auto &booking: repository.cursorByUserId(userId)) {
+            benchmark::DoNotOptimize(booking.deskId);
+            ++rows;
+        }
+        userId = userId % BenchDatabaseLayout::Users + 1;
+    }
+    state.counters["rows"] = benchmark::Counter(static_cast<double>(rows), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BookingRepositoryCursorByUserId)->Apply(bookingCounts);
+
+static void BM_BookingRepositoryFindPage(benchmark::State &state) {
+    const int64_t count = state.range(0);
+    const int pageSize = static_cast<int>(state.range(1));
+    BookingRepository repository(openBenchDatabase(count));
+
+    // Kolejne strony zaczynają się w różnych miejscach tabeli, także pod jej koniec
+    int afterId = 0;
+    for (auto _: state) {
+        auto page = repository.findPage(afterId, pageSize);
+        afterId = page.empty() ? 0 : (page.back().getId() + 104729) % static_cast<int>(count);
+    }
+    state.SetItemsProcessed(state.iterations() * pageSize);
+}
+BENCHMARK(BM_BookingRepositoryFindPage)
+    ->ArgsProduct({{100'000, 10'000'000}, {100, 1000}})
+    ->Unit(benchmark::kMicrosecond);
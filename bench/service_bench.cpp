@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_database.h"
+#include "server/service/booking_service.h"
+
+static void BM_BookingServiceFloorAssembly(benchmark::State &state) {
+    auto db = openBenchDatabase(state.range(0));
+    BuildingRepository buildingRepository(db);
+    DeskRepository deskRepository(db);
+    BookingRepository bookingRepository(db);
+    BookingService service(buildingRepository, deskRepository, bookingRepository);
+
+    int floor = 1;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(service.getDesksByBuildingAndFloor(BenchDatabaseLayout::BuildingId, floor));
+        floor = floor % BenchDatabaseLayout::Floors + 1;
+    }
+}
+BENCHMARK(BM_BookingServiceFloorAssembly)
+    ->Arg(10'000)->Arg(100'000)->Arg(1'000'000)->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BookingServiceFloorAssemblyDump(benchmark::State &state) {
+    auto db = openBenchDatabase(state.range(0));
+    BuildingRepository buildingRepository(db);
+    DeskRepository deskRepository(db);
+    BookingRepository bookingRepository(db);
+    BookingService service(buildingRepository, deskRepository, bookingRepository);
+
+    for (auto _: state) {
+        auto response = service.getDesksByBuildingAndFloor(BenchDatabaseLayout::BuildingId, 1);
+        benchmark::DoNotOptimize(response.dump());
+    }
+}
+BENCHMARK(BM_BookingServiceFloorAssemblyDump)
+    ->Arg(10'000)->Arg(100'000)
+    ->Unit(benchmark::kMillisecond);
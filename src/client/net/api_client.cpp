@@ -1,26 +1,59 @@
 #include "api_client.h"
 #include <QUrl>
+#include <QUrlQuery>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QEventLoop>
 #include <QMessageBox>
+#include <QStandardPaths>
+#include <QUuid>
 
 #include "common/logger.h"
 
+namespace {
+    /**
+     * @brief Zwraca katalog danych lokalnych klienta
+     */
+    QString localDataDirectory() {
+        return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    }
+}
+
 ApiClient::ApiClient(QObject *parent)
-    : QObject(parent), _serverUrl("http://localhost:8080") {
+    : QObject(parent), _serverUrl("http://localhost:8080"),
+      _snapshots(localDataDirectory() + "/snapshots"),
+      _outbox(localDataDirectory() + "/outbox.json") {
+    setupReplayTimer();
 }
 
 ApiClient::ApiClient(const std::string &serverAddress, int port, QObject *parent)
-    : QObject(parent) {
+    : QObject(parent),
+      _snapshots(localDataDirectory() + "/snapshots"),
+      _outbox(localDataDirectory() + "/outbox.json") {
     _serverUrl = QString("http://%1:%2").arg(QString::fromStdString(serverAddress)).arg(port);
     LOG_INFO("API URL: {}", _serverUrl.toStdString());
+    setupReplayTimer();
+}
+
+void ApiClient::setupReplayTimer() {
+    _replayTimer.setInterval(ReplayIntervalMs);
+    connect(&_replayTimer, &QTimer::timeout, this, &ApiClient::replayOutbox);
+
+    // Operacje z poprzedniej sesji zostaną wysłane po uruchomieniu pętli zdarzeń
+    if (!_outbox.isEmpty()) {
+        _replayTimer.start();
+        QTimer::singleShot(0, this, &ApiClient::replayOutbox);
+    }
 }
 
-json ApiClient::executeRequest(const QString &method, const QString &endpoint, const json &data) {
+QNetworkReply *ApiClient::sendRequest(const QString &method, const QString &endpoint, const json &data,
+                                      const QString &idempotencyKey) {
     QUrl url(_serverUrl + endpoint);
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    if (!idempotencyKey.isEmpty()) {
+        request.setRawHeader("Idempotency-Key", idempotencyKey.toUtf8());
+    }
 
     QByteArray requestData;
     if (!data.empty()) {
@@ -37,21 +70,105 @@ json ApiClient::executeRequest(const QString &method, const QString &endpoint, c
     } else if (method == "DELETE") {
         reply = _networkManager.deleteResource(request);
     }
+    return reply;
+}
+
+json ApiClient::executeRequest(const QString &method, const QString &endpoint, const json &data,
+                               const QString &idempotencyKey) {
+    QNetworkReply *reply = sendRequest(method, endpoint, data, idempotencyKey);
 
     QEventLoop loop;
     QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
     loop.exec();
 
+    json response = parseReply(reply);
+    reply->deleteLater();
+    return handleResponse(method, endpoint, std::move(response));
+}
+
+QString ApiClient::executeRequestAsync(const QString &method, const QString &endpoint, JsonCallback callback,
+                                       const json &data, const QString &idempotencyKey) {
+    // Ten sam GET w locie obsługuje wszystkich oczekujących (singleflight)
+    QString key = method + " " + endpoint;
+    if (method == "GET") {
+        auto it = _inFlight.find(key);
+        if (it != _inFlight.end()) {
+            it->callbacks.push_back(std::move(callback));
+            return key;
+        }
+    }
+
+    QNetworkReply *reply = sendRequest(method, endpoint, data, idempotencyKey);
+
+    if (method != "GET") {
+        // Żądania modyfikujące nie są łączone
+        connect(reply, &QNetworkReply::finished, this,
+                [this, method, endpoint, reply, callback = std::move(callback)]() {
+                    json response = handleResponse(method, endpoint, parseReply(reply));
+                    reply->deleteLater();
+                    callback(response);
+                });
+        return QString();
+    }
+
+    InFlightRequest &pending = _inFlight[key];
+    pending.reply = reply;
+    pending.callbacks.push_back(std::move(callback));
+
+    connect(reply, &QNetworkReply::finished, this, [this, key, endpoint, reply]() {
+        auto it = _inFlight.find(key);
+        if (it == _inFlight.end() || it->reply != reply) {
+            reply->deleteLater();
+            return;
+        }
+        auto callbacks = std::move(it->callbacks);
+        _inFlight.erase(it);
+
+        json response = handleResponse("GET", endpoint, parseReply(reply));
+        reply->deleteLater();
+        for (const auto &pendingCallback: callbacks) {
+            pendingCallback(response);
+        }
+    });
+    return key;
+}
+
+void ApiClient::abortRequest(const QString &requestKey) {
+    auto it = _inFlight.find(requestKey);
+    if (it != _inFlight.end() && it->reply) {
+        it->reply->abort();
+    }
+}
+
+json ApiClient::parseReply(QNetworkReply *reply) {
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return {{"status", "error"}, {"message", "Żądanie anulowane"}, {"canceled", true}};
+    }
+
+    QByteArray responseData = reply->readAll();
+
     if (reply->error() != QNetworkReply::NoError) {
         QString errorMsg = reply->errorString();
         int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
         LOG_ERROR("Network error {}: {}", statusCode, errorMsg.toStdString());
-        reply->deleteLater();
-        return {{"status", "error"}, {"message", errorMsg.toStdString()}};
-    }
 
-    QByteArray responseData = reply->readAll();
-    reply->deleteLater();
+        // Brak kodu HTTP oznacza, że serwer jest nieosiągalny
+        if (statusCode == 0) {
+            return {{"status", "error"}, {"message", errorMsg.toStdString()}, {"offline", true}};
+        }
+
+        json response = {{"status", "error"}, {"message", errorMsg.toStdString()}};
+        try {
+            json body = json::parse(responseData.toStdString());
+            if (body.contains("message")) {
+                response["message"] = body["message"];
+            }
+        } catch (...) {
+            // Treść odpowiedzi nie jest JSON-em
+        }
+        response["httpStatus"] = statusCode;
+        return response;
+    }
 
     if (responseData.isEmpty()) {
         return {{"status", "error"}, {"message", "Pusta odpowiedź"}};
@@ -65,8 +182,118 @@ json ApiClient::executeRequest(const QString &method, const QString &endpoint, c
     }
 }
 
+json ApiClient::handleResponse(const QString &method, const QString &endpoint, json response) {
+    if (isOfflineResponse(response)) {
+        setOnline(false);
+
+        // Odczyty są obsługiwane z ostatniej migawki
+        if (method == "GET") {
+            if (auto snapshot = _snapshots.load(endpoint)) {
+                json cached = *snapshot;
+                cached["fromCache"] = true;
+                return cached;
+            }
+        }
+        return response;
+    }
+
+    if (!response.contains("canceled")) {
+        setOnline(true);
+    }
+    if (method == "GET" && response.contains("status") && response["status"] == "success") {
+        _snapshots.store(endpoint, response);
+    }
+    return response;
+}
+
+bool ApiClient::isOfflineResponse(const json &response) {
+    return response.contains("offline") && response["offline"].is_boolean() && response["offline"].get<bool>();
+}
+
+bool ApiClient::isRetryableResponse(const json &response) {
+    if (isOfflineResponse(response)) {
+        return true;
+    }
+    // Tylko odpowiedzi 4xx (poza przekroczeniem czasu i limitem żądań) są ostateczne
+    int httpStatus = response.value("httpStatus", 0);
+    return httpStatus < 400 || httpStatus >= 500 || httpStatus == 408 || httpStatus == 429;
+}
+
+void ApiClient::setOnline(bool online) {
+    if (_online == online) return;
+
+    _online = online;
+    LOG_INFO(online ? "Połączenie z serwerem przywrócone" : "Brak połączenia z serwerem - tryb offline");
+    emit connectivityChanged(online);
+
+    if (!online) {
+        _replayTimer.start();
+    } else if (!_outbox.isEmpty()) {
+        QTimer::singleShot(0, this, &ApiClient::replayOutbox);
+    }
+}
+
+void ApiClient::replayOutbox() {
+    if (_replaying) return;
+    _replaying = true;
+
+    // Sprawdź połączenie, jeśli kolejka jest pusta
+    if (_outbox.isEmpty() && !_online) {
+        executeRequest("GET", "/api/buildings");
+    }
+
+    int sent = 0;
+    while (const BookingOutbox::Item *item = _outbox.front()) {
+        json response;
+        if (item->action == BookingOutbox::Action::AddBooking) {
+            response = executeRequest("POST", "/api/bookings", item->payload, item->key);
+        } else {
+            QString endpoint = "/api/bookings/" + QString::number(item->payload.value("bookingId", 0));
+            response = executeRequest("DELETE", endpoint, json::object(), item->key);
+        }
+
+        bool success = response.contains("status") && response["status"] == "success";
+
+        // Serwer nieosiągalny lub chwilowo niedostępny - operacja zostaje w kolejce
+        if (!success && isRetryableResponse(response)) {
+            if (!_replayTimer.isActive()) {
+                _replayTimer.start();
+            }
+            break;
+        }
+
+        bool alreadyCancelled = item->action == BookingOutbox::Action::CancelBooking &&
+                                response.value("httpStatus", 0) == 404;
+        if (!success && !alreadyCancelled) {
+            QString message = QString::fromStdString(response.value("message", "Nieznany błąd"));
+            LOG_WARNING("Konflikt przy wysyłaniu z kolejki offline: {} - {}",
+                        BookingOutbox::describe(*item).toStdString(), message.toStdString());
+            emit outboxItemFailed(BookingOutbox::describe(*item), message);
+        } else {
+            ++sent;
+        }
+        _outbox.popFront();
+    }
+
+    if (_outbox.isEmpty() && _online) {
+        _replayTimer.stop();
+    }
+    _replaying = false;
+
+    if (sent > 0) {
+        emit outboxReplayed(sent);
+    }
+}
+
 std::vector<Building> ApiClient::getBuildings() {
     json response = executeRequest("GET", "/api/buildings");
+    std::vector<Building> buildings = parseBuildings(response);
+
+    emit requestCompleted();
+    return buildings;
+}
+
+std::vector<Building> ApiClient::parseBuildings(const json &response) {
     std::vector<Building> buildings;
 
     if (response.contains("buildings") && response["buildings"].is_array()) {
@@ -80,12 +307,59 @@ std::vector<Building> ApiClient::getBuildings() {
             buildings.push_back(building);
         }
     }
-
-    emit requestCompleted();
     return buildings;
 }
 
 std::vector<Desk> ApiClient::getDesks(int buildingId, int floor) {
+    json response = executeRequest("GET", desksEndpoint(buildingId, floor));
+    std::vector<Desk> desks = parseDesks(response);
+
+    emit requestCompleted();
+    return desks;
+}
+
+QString ApiClient::getDesksAsync(int buildingId, int floor, std::function<void(std::vector<Desk>)> callback) {
+    return executeRequestAsync("GET", desksEndpoint(buildingId, floor),
+                               [this, callback = std::move(callback)](const json &response) {
+                                   callback(parseDesks(response));
+                                   emit requestCompleted();
+                               });
+}
+
+QString ApiClient::getUserBookingsAsync(int userId, const QDate &from, const QString &cursor, int limit,
+                                       std::function<void(UserBookingsPage)> callback) {
+    QUrlQuery query;
+    query.addQueryItem("limit", QString::number(limit));
+    if (from.isValid()) {
+        query.addQueryItem("from", from.toString("yyyy-MM-dd"));
+    }
+    if (!cursor.isEmpty()) {
+        query.addQueryItem("cursor", cursor);
+    }
+    QString endpoint = "/api/users/" + QString::number(userId) + "/bookings?" + query.toString(QUrl::FullyEncoded);
+
+    return executeRequestAsync("GET", endpoint, [callback = std::move(callback)](const json &response) {
+        UserBookingsPage page;
+        page.ok = response.contains("status") && response["status"] == "success";
+
+        if (page.ok && response.contains("bookings") && response["bookings"].is_array()) {
+            for (const auto &bookingJson: response["bookings"]) {
+                UserBookingEntry entry;
+                entry.booking = Booking::fromJson(bookingJson);
+                entry.deskName = QString::fromStdString(bookingJson.value("deskName", std::string()));
+                entry.buildingName = QString::fromStdString(bookingJson.value("buildingName", std::string()));
+                entry.floor = bookingJson.value("floor", 0);
+                page.entries.push_back(std::move(entry));
+            }
+        }
+        if (page.ok && response.contains("nextCursor") && response["nextCursor"].is_string()) {
+            page.nextCursor = QString::fromStdString(response["nextCursor"].get<std::string>());
+        }
+        callback(std::move(page));
+    });
+}
+
+QString ApiClient::desksEndpoint(int buildingId, int floor) {
     QString endpoint = "/api/desks";
 
     if (buildingId > 0) {
@@ -95,8 +369,10 @@ std::vector<Desk> ApiClient::getDesks(int buildingId, int floor) {
             endpoint += "&floor=" + QString::number(floor);
         }
     }
+    return endpoint;
+}
 
-    json response = executeRequest("GET", endpoint);
+std::vector<Desk> ApiClient::parseDesks(const json &response) {
     std::vector<Desk> desks;
 
     if (response.contains("desks") && response["desks"].is_array()) {
@@ -117,8 +393,6 @@ std::vector<Desk> ApiClient::getDesks(int buildingId, int floor) {
             desks.push_back(desk);
         }
     }
-
-    emit requestCompleted();
     return desks;
 }
 
@@ -136,7 +410,14 @@ std::pair<bool, QString> ApiClient::addBooking(int deskId, int userId, const std
         {"dateTo", dateTo}
     };
 
-    json response = executeRequest("POST", "/api/bookings", data);
+    // Klucz idempotencji pozwala bezpiecznie ponowić żądanie
+    QString idempotencyKey = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    json response = executeRequest("POST", "/api/bookings", data, idempotencyKey);
+
+    if (isOfflineResponse(response)) {
+        _outbox.enqueue(BookingOutbox::Action::AddBooking, data, idempotencyKey);
+        return {true, "Brak połączenia z serwerem. Rezerwacja zostanie wysłana po przywróceniu połączenia."};
+    }
 
     bool success = response.contains("status") && response["status"] == "success";
 
@@ -160,11 +441,38 @@ std::pair<bool, QString> ApiClient::addBooking(int deskId, int userId, const std
 bool ApiClient::cancelBooking(int bookingId) {
     if (!isLoggedIn()) return false;
 
+    QString idempotencyKey = QUuid::createUuid().toString(QUuid::WithoutBraces);
     QString endpoint = "/api/bookings/" + QString::number(bookingId);
-    json response = executeRequest("DELETE", endpoint);
+    json response = executeRequest("DELETE", endpoint, json::object(), idempotencyKey);
+
+    if (isOfflineResponse(response)) {
+        _outbox.enqueue(BookingOutbox::Action::CancelBooking, {{"bookingId", bookingId}}, idempotencyKey);
+        return true;
+    }
     return response.contains("status") && response["status"] == "success";
 }
 
+void ApiClient::cancelBookingAsync(int bookingId, std::function<void(bool)> callback) {
+    if (!isLoggedIn()) {
+        callback(false);
+        return;
+    }
+
+    QString idempotencyKey = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    QString endpoint = "/api/bookings/" + QString::number(bookingId);
+    executeRequestAsync("DELETE", endpoint,
+                        [this, bookingId, idempotencyKey, callback = std::move(callback)](const json &response) {
+                            if (isOfflineResponse(response)) {
+                                _outbox.enqueue(BookingOutbox::Action::CancelBooking, {{"bookingId", bookingId}},
+                                                idempotencyKey);
+                                callback(true);
+                                return;
+                            }
+                            callback(response.contains("status") && response["status"] == "success");
+                        },
+                        json::object(), idempotencyKey);
+}
+
 std::optional<User> ApiClient::registerUser(const std::string &username, const std::string &password,
                                             const std::string &email) {
     json data = {
@@ -191,11 +499,14 @@ std::optional<User> ApiClient::registerUser(const std::string &username, const s
 }
 
 std::optional<User> ApiClient::loginUser(const std::string &username, const std::string &password) {
+    // Poproś o dane startowe, aby pierwszy widok nie wymagał kolejnych zapytań
     json data = {
         {"username", username},
-        {"password", password}
+        {"password", password},
+        {"bootstrap", true}
     };
 
+    _bootstrap.reset();
     json response = executeRequest("POST", "/api/users/login", data);
 
     if (response.contains("status") && response["status"] == "success" &&
@@ -220,8 +531,42 @@ std::optional<User> ApiClient::loginUser(const std::string &username, const std:
 
         User user(id, username, email);
         _currentUser = user;
+
+        if (response.contains("bootstrap") && response["bootstrap"].is_object()) {
+            _bootstrap = parseBootstrap(response["bootstrap"]);
+        }
         return user;
     }
 
     return std::nullopt;
 }
+
+std::optional<ApiClient::BootstrapData> ApiClient::takeBootstrap() {
+    auto bootstrap = std::move(_bootstrap);
+    _bootstrap.reset();
+    return bootstrap;
+}
+
+ApiClient::BootstrapData ApiClient::parseBootstrap(const json &bootstrap) {
+    BootstrapData data;
+    data.buildings = parseBuildings(bootstrap);
+    _snapshots.store("/api/buildings", {{"status", "success"}, {"buildings", bootstrap.value("buildings", json::array())}});
+
+    if (bootstrap.contains("upcomingBookings") && bootstrap["upcomingBookings"].is_array()) {
+        for (const auto &bookingJson: bootstrap["upcomingBookings"]) {
+            data.upcomingBookings.push_back(Booking::fromJson(bookingJson));
+        }
+    }
+
+    if (bootstrap.contains("floorView") && bootstrap["floorView"].is_object()) {
+        const auto &floorView = bootstrap["floorView"];
+        data.buildingId = floorView.value("buildingId", -1);
+        data.floor = floorView.value("floor", -1);
+        data.desks = parseDesks(floorView);
+
+        // Widok piętra trafia do migawek, tak jak odpowiedź /api/desks
+        _snapshots.store(desksEndpoint(data.buildingId, data.floor),
+                         {{"status", "success"}, {"desks", floorView.value("desks", json::array())}});
+    }
+    return data;
+}
@@ -2,9 +2,15 @@
 #define API_CLIENT_H
 
 #include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <functional>
 #include <optional>
 #include "common/model/model.h"
+#include "snapshot_cache.h"
+#include "booking_outbox.h"
 
 /**
  * @class ApiClient
@@ -13,11 +19,50 @@
  * ApiClient zapewnia funkcje do komunikacji z serwerem REST API,
  * umożliwiając pobieranie danych o budynkach, biurkach, zarządzanie rezerwacjami
  * oraz operacje użytkownika takie jak logowanie i rejestracja.
+ *
+ * Bez połączenia z serwerem odczyty są obsługiwane z lokalnych migawek,
+ * a rezerwacje i anulowania trafiają do trwałej kolejki wysyłanej
+ * po przywróceniu połączenia.
  */
 class ApiClient : public QObject {
     Q_OBJECT
 
 public:
+    /**
+     * @brief Funkcja wywoływana z odpowiedzią JSON żądania asynchronicznego
+     */
+    using JsonCallback = std::function<void(const json &)>;
+
+    /**
+     * @brief Dane startowe zwracane razem z logowaniem
+     */
+    struct BootstrapData {
+        std::vector<Building> buildings;
+        std::vector<Booking> upcomingBookings;
+        int buildingId = -1;
+        int floor = -1;
+        std::vector<Desk> desks;
+    };
+
+    /**
+     * @brief Rezerwacja użytkownika wraz z opisem biurka
+     */
+    struct UserBookingEntry {
+        Booking booking;
+        QString deskName;
+        QString buildingName;
+        int floor = 0;
+    };
+
+    /**
+     * @brief Strona listy rezerwacji użytkownika
+     */
+    struct UserBookingsPage {
+        bool ok = false;
+        std::vector<UserBookingEntry> entries;
+        QString nextCursor;
+    };
+
     /**
      * @brief Konstruktor domyślny
      * @param parent Obiekt rodzica (opcjonalny)
@@ -37,9 +82,33 @@ public:
      * @param method Metoda HTTP (GET, POST, PUT, DELETE)
      * @param endpoint Punkt końcowy API
      * @param data Dane JSON do wysłania (opcjonalne)
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
      * @return Odpowiedź JSON z serwera
      */
-    json executeRequest(const QString &method, const QString &endpoint, const json &data = json::object());
+    json executeRequest(const QString &method, const QString &endpoint, const json &data = json::object(),
+                        const QString &idempotencyKey = QString());
+
+    /**
+     * @brief Wykonuje żądanie HTTP bez blokowania pętli zdarzeń
+     *
+     * Identyczne żądania GET będące w locie są łączone w jedno, a odpowiedź
+     * trafia do wszystkich oczekujących.
+     *
+     * @param method Metoda HTTP (GET, POST, PUT, DELETE)
+     * @param endpoint Punkt końcowy API
+     * @param callback Funkcja wywoływana z odpowiedzią
+     * @param data Dane JSON do wysłania (opcjonalne)
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
+     * @return Klucz żądania GET (do anulowania) lub pusty napis
+     */
+    QString executeRequestAsync(const QString &method, const QString &endpoint, JsonCallback callback,
+                                const json &data = json::object(), const QString &idempotencyKey = QString());
+
+    /**
+     * @brief Przerywa żądanie w locie
+     * @param requestKey Klucz zwrócony przez executeRequestAsync
+     */
+    void abortRequest(const QString &requestKey);
 
     /**
      * @brief Pobiera listę budynków
@@ -55,13 +124,34 @@ public:
      */
     std::vector<Desk> getDesks(int buildingId = -1, int floor = -1);
 
+    /**
+     * @brief Pobiera listę biurek asynchronicznie
+     * @param buildingId ID budynku
+     * @param floor Piętro
+     * @param callback Funkcja wywoływana z listą biurek
+     * @return Klucz żądania (do anulowania)
+     */
+    QString getDesksAsync(int buildingId, int floor, std::function<void(std::vector<Desk>)> callback);
+
+    /**
+     * @brief Pobiera stronę rezerwacji użytkownika asynchronicznie
+     * @param userId ID użytkownika
+     * @param from Najwcześniejsza data zakończenia rezerwacji (nieprawidłowa - bez ograniczenia)
+     * @param cursor Kursor następnej strony (pusty - pierwsza strona)
+     * @param limit Liczba rezerwacji na stronie
+     * @param callback Funkcja wywoływana z pobraną stroną
+     * @return Klucz żądania (do anulowania)
+     */
+    QString getUserBookingsAsync(int userId, const QDate &from, const QString &cursor, int limit,
+                                 std::function<void(UserBookingsPage)> callback);
+
     /**
      * @brief Dodaje rezerwację
      * @param deskId ID biurka
      * @param userId ID użytkownika
      * @param dateFrom Data początkowa (format: yyyy-MM-dd)
      * @param dateTo Data końcowa (format: yyyy-MM-dd)
-     * @return Para (sukces, komunikat błędu)
+     * @return Para (sukces, komunikat błędu lub informacja o zakolejkowaniu)
      */
     std::pair<bool, QString> addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo);
 
@@ -72,6 +162,17 @@ public:
      */
     bool cancelBooking(int bookingId);
 
+    /**
+     * @brief Anuluje rezerwację bez blokowania pętli zdarzeń
+     *
+     * Bez połączenia z serwerem operacja trafia do kolejki offline
+     * i jest traktowana jak udana.
+     *
+     * @param bookingId ID rezerwacji
+     * @param callback Funkcja wywoływana z informacją, czy operacja się powiodła
+     */
+    void cancelBookingAsync(int bookingId, std::function<void(bool)> callback);
+
     /**
      * @brief Rejestruje nowego użytkownika
      * @param username Nazwa użytkownika
@@ -90,6 +191,15 @@ public:
      */
     std::optional<User> loginUser(const std::string &username, const std::string &password);
 
+    /**
+     * @brief Pobiera dane startowe otrzymane przy ostatnim logowaniu
+     *
+     * Dane są zwracane tylko raz, kolejne wywołanie zwraca brak wartości.
+     *
+     * @return Opcjonalne dane startowe
+     */
+    std::optional<BootstrapData> takeBootstrap();
+
     /**
      * @brief Pobiera aktualnie zalogowanego użytkownika
      * @return Opcjonalny obiekt User
@@ -99,7 +209,10 @@ public:
     /**
      * @brief Wylogowuje użytkownika
      */
-    void logoutUser() { _currentUser = std::nullopt; }
+    void logoutUser() {
+        _currentUser = std::nullopt;
+        _bootstrap.reset();
+    }
 
     /**
      * @brief Sprawdza czy użytkownik jest zalogowany
@@ -107,6 +220,24 @@ public:
      */
     bool isLoggedIn() const { return _currentUser.has_value(); }
 
+    /**
+     * @brief Sprawdza czy serwer jest osiągalny
+     * @return Czy ostatnie żądanie dotarło do serwera
+     */
+    bool isOnline() const { return _online; }
+
+    /**
+     * @brief Pobiera liczbę operacji oczekujących w kolejce offline
+     * @return Liczba oczekujących operacji
+     */
+    size_t getPendingOperationCount() const { return _outbox.size(); }
+
+public slots:
+    /**
+     * @brief Wysyła po kolei operacje z kolejki offline
+     */
+    void replayOutbox();
+
 signals:
     /**
      * @brief Sygnał emitowany po zakończeniu żądania
@@ -119,10 +250,132 @@ signals:
      */
     void networkError(const QString &error);
 
+    /**
+     * @brief Sygnał emitowany przy zmianie dostępności serwera
+     * @param online Czy serwer jest osiągalny
+     */
+    void connectivityChanged(bool online);
+
+    /**
+     * @brief Sygnał emitowany, gdy serwer odrzuci operację z kolejki offline
+     * @param item Opis operacji
+     * @param message Komunikat serwera
+     */
+    void outboxItemFailed(const QString &item, const QString &message);
+
+    /**
+     * @brief Sygnał emitowany po wysłaniu operacji z kolejki offline
+     * @param count Liczba wysłanych operacji
+     */
+    void outboxReplayed(int count);
+
 private:
+    /**
+     * @brief Żądanie GET w locie wraz z oczekującymi odbiorcami
+     */
+    struct InFlightRequest {
+        QNetworkReply *reply = nullptr;
+        std::vector<JsonCallback> callbacks;
+    };
+
+    /**
+     * @brief Wysyła żądanie HTTP
+     * @param method Metoda HTTP
+     * @param endpoint Punkt końcowy API
+     * @param data Dane JSON do wysłania
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
+     * @return Obiekt odpowiedzi sieciowej
+     */
+    QNetworkReply *sendRequest(const QString &method, const QString &endpoint, const json &data,
+                               const QString &idempotencyKey = QString());
+
+    /**
+     * @brief Przetwarza zakończoną odpowiedź sieciową na JSON
+     * @param reply Zakończona odpowiedź
+     * @return Odpowiedź JSON lub obiekt błędu
+     */
+    static json parseReply(QNetworkReply *reply);
+
+    /**
+     * @brief Aktualizuje stan połączenia i migawki na podstawie odpowiedzi
+     * @param method Metoda HTTP
+     * @param endpoint Punkt końcowy API
+     * @param response Odpowiedź JSON
+     * @return Odpowiedź lub migawka, jeśli serwer jest nieosiągalny
+     */
+    json handleResponse(const QString &method, const QString &endpoint, json response);
+
+    /**
+     * @brief Sprawdza czy odpowiedź oznacza brak połączenia z serwerem
+     * @param response Odpowiedź JSON
+     * @return Czy serwer był nieosiągalny
+     */
+    static bool isOfflineResponse(const json &response);
+
+    /**
+     * @brief Sprawdza czy nieudaną operację z kolejki offline należy ponowić
+     *
+     * Ponawiane są operacje bez odpowiedzi serwera, z błędem 5xx, 408 lub 429
+     * oraz z odpowiedzią bez kodu HTTP; pozostałe błędy 4xx są ostateczne.
+     *
+     * @param response Odpowiedź JSON nieudanej operacji
+     * @return Czy operacja powinna zostać w kolejce
+     */
+    static bool isRetryableResponse(const json &response);
+
+    /**
+     * @brief Ustawia stan połączenia z serwerem
+     * @param online Czy serwer jest osiągalny
+     */
+    void setOnline(bool online);
+
+    /**
+     * @brief Konfiguruje cykliczne ponawianie kolejki offline
+     */
+    void setupReplayTimer();
+
+    /**
+     * @brief Buduje adres listy biurek
+     * @param buildingId ID budynku
+     * @param floor Piętro
+     * @return Punkt końcowy API
+     */
+    static QString desksEndpoint(int buildingId, int floor);
+
+    /**
+     * @brief Tworzy listę biurek z odpowiedzi serwera
+     * @param response Odpowiedź JSON
+     * @return Wektor obiektów Desk
+     */
+    static std::vector<Desk> parseDesks(const json &response);
+
+    /**
+     * @brief Tworzy listę budynków z odpowiedzi serwera
+     * @param response Odpowiedź JSON
+     * @return Wektor obiektów Building
+     */
+    static std::vector<Building> parseBuildings(const json &response);
+
+    /**
+     * @brief Przetwarza dane startowe i zapisuje je w migawkach
+     * @param bootstrap Obiekt JSON z danymi startowymi
+     * @return Dane startowe
+     */
+    BootstrapData parseBootstrap(const json &bootstrap);
+
     QString _serverUrl;
     QNetworkAccessManager _networkManager;
     std::optional<User> _currentUser;
+    std::optional<BootstrapData> _bootstrap;
+    QHash<QString, InFlightRequest> _inFlight;
+
+    // Tryb offline
+    static constexpr int ReplayIntervalMs = 10000;
+    SnapshotCache _snapshots;
+    BookingOutbox _outbox;
+    QTimer _replayTimer;
+    bool _online = true;
+    bool _replaying = false;
 };
 
 #endif
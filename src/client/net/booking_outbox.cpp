@@ -0,0 +1,81 @@
+#include "booking_outbox.h"
+#include <QFile>
+#include <QSaveFile>
+
+#include "common/logger.h"
+
+namespace {
+    const char *actionName(BookingOutbox::Action action) {
+        return action == BookingOutbox::Action::CancelBooking ? "cancel" : "add";
+    }
+}
+
+BookingOutbox::BookingOutbox(const QString &filePath)
+    : _filePath(filePath) {
+    load();
+}
+
+void BookingOutbox::enqueue(Action action, const json &payload, const QString &key) {
+    _items.push_back({key, action, payload});
+    persist();
+    LOG_INFO("Dodano do kolejki offline: {} (oczekujące: {})", describe(_items.back()).toStdString(),
+             _items.size());
+}
+
+void BookingOutbox::popFront() {
+    if (_items.empty()) return;
+    _items.pop_front();
+    persist();
+}
+
+QString BookingOutbox::describe(const Item &item) {
+    if (item.action == Action::CancelBooking) {
+        return QString("Anulowanie rezerwacji #%1").arg(item.payload.value("bookingId", 0));
+    }
+    return QString("Rezerwacja biurka #%1 (%2 - %3)")
+        .arg(item.payload.value("deskId", 0))
+        .arg(QString::fromStdString(item.payload.value("dateFrom", "")))
+        .arg(QString::fromStdString(item.payload.value("dateTo", "")));
+}
+
+void BookingOutbox::load() {
+    QFile file(_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    try {
+        json stored = json::parse(file.readAll().toStdString());
+        for (const auto &entry: stored) {
+            Item item;
+            item.key = QString::fromStdString(entry.value("key", ""));
+            item.action = entry.value("action", "add") == "cancel" ? Action::CancelBooking : Action::AddBooking;
+            item.payload = entry.value("payload", json::object());
+            _items.push_back(item);
+        }
+    } catch (const std::exception &e) {
+        LOG_ERROR("Nie można wczytać kolejki offline: {}", e.what());
+    }
+}
+
+void BookingOutbox::persist() const {
+    json stored = json::array();
+    for (const auto &item: _items) {
+        stored.push_back({
+            {"key", item.key.toStdString()},
+            {"action", actionName(item.action)},
+            {"payload", item.payload}
+        });
+    }
+
+    // Zapis atomowy: plik jest podmieniany dopiero po pełnym zapisie
+    QSaveFile file(_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_ERROR("Nie można zapisać kolejki offline: {}", _filePath.toStdString());
+        return;
+    }
+    file.write(QByteArray::fromStdString(stored.dump()));
+    if (!file.commit()) {
+        LOG_ERROR("Nie można zapisać kolejki offline: {}", _filePath.toStdString());
+    }
+}
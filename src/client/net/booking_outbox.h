@@ -0,0 +1,94 @@
+#ifndef BOOKING_OUTBOX_H
+#define BOOKING_OUTBOX_H
+
+#include <QString>
+#include <deque>
+#include "common/model/entity.h"
+
+/**
+ * @class BookingOutbox
+ * @brief Trwała kolejka rezerwacji i anulowań oczekujących na wysłanie.
+ *
+ * Operacje wykonane bez połączenia z serwerem są dopisywane do kolejki
+ * zapisywanej atomowo na dysku. Każda pozycja ma klucz idempotencji,
+ * dzięki któremu ponowne wysłanie nie tworzy duplikatów po stronie serwera.
+ */
+class BookingOutbox {
+public:
+    /**
+     * @brief Rodzaj operacji w kolejce
+     */
+    enum class Action {
+        AddBooking,
+        CancelBooking
+    };
+
+    /**
+     * @brief Pozycja kolejki
+     */
+    struct Item {
+        QString key;
+        Action action = Action::AddBooking;
+        json payload;
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param filePath Ścieżka pliku kolejki
+     */
+    explicit BookingOutbox(const QString &filePath);
+
+    /**
+     * @brief Dopisuje operację na koniec kolejki
+     * @param action Rodzaj operacji
+     * @param payload Dane operacji
+     * @param key Klucz idempotencji
+     */
+    void enqueue(Action action, const json &payload, const QString &key);
+
+    /**
+     * @brief Pobiera najstarszą pozycję kolejki
+     * @return Wskaźnik do pozycji lub nullptr, jeśli kolejka jest pusta
+     */
+    const Item *front() const { return _items.empty() ? nullptr : &_items.front(); }
+
+    /**
+     * @brief Usuwa najstarszą pozycję kolejki
+     */
+    void popFront();
+
+    /**
+     * @brief Sprawdza czy kolejka jest pusta
+     * @return Czy kolejka jest pusta
+     */
+    bool isEmpty() const { return _items.empty(); }
+
+    /**
+     * @brief Pobiera liczbę pozycji w kolejce
+     * @return Liczba pozycji
+     */
+    size_t size() const { return _items.size(); }
+
+    /**
+     * @brief Pobiera opis pozycji do wyświetlenia użytkownikowi
+     * @param item Pozycja kolejki
+     * @return Opis operacji
+     */
+    static QString describe(const Item &item);
+
+private:
+    /**
+     * @brief Wczytuje kolejkę z dysku
+     */
+    void load();
+
+    /**
+     * @brief Zapisuje kolejkę na dysk
+     */
+    void persist() const;
+
+    QString _filePath;
+    std::deque<Item> _items;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "snapshot_cache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "common/logger.h"
+
+SnapshotCache::SnapshotCache(const QString &directory)
+    : _directory(directory) {
+    QDir().mkpath(_directory);
+}
+
+void SnapshotCache::store(const QString &endpoint, const json &response) {
+    _snapshots.insert(endpoint, response);
+
+    QSaveFile file(filePath(endpoint));
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARNING("Nie można zapisać migawki {}", endpoint.toStdString());
+        return;
+    }
+    file.write(QByteArray::fromStdString(response.dump()));
+    file.commit();
+}
+
+std::optional<json> SnapshotCache::load(const QString &endpoint) {
+    auto it = _snapshots.find(endpoint);
+    if (it != _snapshots.end()) {
+        return *it;
+    }
+
+    QFile file(filePath(endpoint));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    try {
+        json response = json::parse(file.readAll().toStdString());
+        _snapshots.insert(endpoint, response);
+        return response;
+    } catch (const std::exception &e) {
+        LOG_WARNING("Uszkodzona migawka {}: {}", endpoint.toStdString(), e.what());
+        return std::nullopt;
+    }
+}
+
+QString SnapshotCache::filePath(const QString &endpoint) const {
+    QByteArray hash = QCryptographicHash::hash(endpoint.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return _directory + "/" + QString::fromLatin1(hash) + ".json";
+}
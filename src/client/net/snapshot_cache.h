@@ -0,0 +1,51 @@
+#ifndef SNAPSHOT_CACHE_H
+#define SNAPSHOT_CACHE_H
+
+#include <QHash>
+#include <QString>
+#include <optional>
+#include "common/model/entity.h"
+
+/**
+ * @class SnapshotCache
+ * @brief Lokalna pamięć podręczna ostatnich odpowiedzi serwera.
+ *
+ * Przechowuje ostatnią udaną odpowiedź dla każdego punktu końcowego GET
+ * w pamięci oraz na dysku, dzięki czemu widoki mogą być wyświetlane
+ * także bez połączenia z serwerem.
+ */
+class SnapshotCache {
+public:
+    /**
+     * @brief Konstruktor
+     * @param directory Katalog plików migawek
+     */
+    explicit SnapshotCache(const QString &directory);
+
+    /**
+     * @brief Zapisuje migawkę odpowiedzi
+     * @param endpoint Punkt końcowy API
+     * @param response Odpowiedź JSON
+     */
+    void store(const QString &endpoint, const json &response);
+
+    /**
+     * @brief Odczytuje migawkę odpowiedzi
+     * @param endpoint Punkt końcowy API
+     * @return Opcjonalna odpowiedź JSON (brak, jeśli nie zapisano)
+     */
+    std::optional<json> load(const QString &endpoint);
+
+private:
+    /**
+     * @brief Wyznacza ścieżkę pliku migawki dla punktu końcowego
+     * @param endpoint Punkt końcowy API
+     * @return Ścieżka pliku
+     */
+    QString filePath(const QString &endpoint) const;
+
+    QString _directory;
+    QHash<QString, json> _snapshots;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <QGroupBox>
 #include <QMessageBox>
 #include "common/logger.h"
+#include "qt_date.h"
 
 BookingDialog::BookingDialog(Desk &desk, const QDate &date, ApiClient &apiClient, QWidget *parent)
     : QDialog(parent), desk(desk), bookingDate(date), apiClient(apiClient), bookingId(0) {
@@ -18,7 +19,7 @@ BookingDialog::BookingDialog(Desk &desk, const QDate &date, ApiClient &apiClient
         .arg(desk.getFloor())));
 
     // Sprawdź czy biurko jest zarezerwowane
-    isBooked = desk.isBookedOnDate(date);
+    isBooked = desk.isBookedOnDate(toDate(date));
 
     // Pobierz ID aktualnego użytkownika
     int currentUserId = apiClient.getCurrentUser() ? apiClient.getCurrentUser()->getId() : -1;
@@ -30,7 +31,7 @@ BookingDialog::BookingDialog(Desk &desk, const QDate &date, ApiClient &apiClient
 
     // Jeśli biurko jest zarezerwowane, wyświetl szczegóły
     if (isBooked) {
-        auto bookings = desk.getBookingsContainingDate(date);
+        auto bookings = desk.getBookingsContainingDate(toDate(date));
         if (!bookings.empty()) {
             const auto &booking = bookings[0];
             bookingId = booking.getId();
@@ -143,6 +144,10 @@ void BookingDialog::bookDesk() {
     auto [success, errorMsg] = apiClient.addBooking(deskId, userId, dateFromStr, dateToStr);
 
     if (success) {
+        // Niepusty komunikat oznacza rezerwację zapisaną w kolejce offline
+        if (!errorMsg.isEmpty()) {
+            QMessageBox::information(this, "Tryb offline", errorMsg);
+        }
         accept();
     } else {
         QMessageBox::warning(this, "Błąd rezerwacji", errorMsg);
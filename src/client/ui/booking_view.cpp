@@ -1,11 +1,15 @@
 #include "booking_view.h"
 #include "booking_dialog.h"
 #include "login_dialog.h"
+#include "my_bookings_dialog.h"
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <QScrollArea>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QPointer>
+#include <QSignalBlocker>
 #include "common/logger.h"
 
 BookingView::BookingView(QWidget *parent, ApiClient &apiClient)
@@ -14,8 +18,20 @@ BookingView::BookingView(QWidget *parent, ApiClient &apiClient)
     setupMenus();
     setWindowTitle("Biurko++ - System rezerwacji biurek");
 
+    // Szybka nawigacja jest wygaszana, aby obsłużyć tylko ostatni wybór
+    navigationTimer = new QTimer(this);
+    navigationTimer->setSingleShot(true);
+    navigationTimer->setInterval(NavigationDebounceMs);
+    connect(navigationTimer, &QTimer::timeout, this, &BookingView::applyNavigation);
+
     // Połącz sygnały
     connect(&apiClient, &ApiClient::networkError, this, &BookingView::handleNetworkError);
+    connect(&apiClient, &ApiClient::connectivityChanged, this, &BookingView::handleConnectivityChanged);
+    connect(&apiClient, &ApiClient::outboxItemFailed, this, &BookingView::handleOutboxItemFailed);
+    connect(&apiClient, &ApiClient::outboxReplayed, this, [this](int count) {
+        statusBar()->showMessage(QString("Wysłano %1 operacji z kolejki offline").arg(count), 5000);
+        refreshView();
+    });
 }
 
 BookingView::BookingView(QWidget *parent)
@@ -83,14 +99,14 @@ void BookingView::setupUi() {
     auto mapPanel = new QGroupBox("Mapa biurek", this);
     auto mapLayout = new QVBoxLayout(mapPanel);
 
-    // Przewijalna mapa biurek
-    deskMapLayout = new QGridLayout();
-    deskMapContainer = new QWidget(this);
-    deskMapContainer->setLayout(deskMapLayout);
+    // Przewijalna mapa biurek rysowana przez jeden widżet
+    deskMap = new DeskMapWidget(this);
+    connect(deskMap, &DeskMapWidget::deskClicked, this, &BookingView::deskClicked);
+    connect(deskMap, &DeskMapWidget::messageClicked, this, &BookingView::showLoginDialog);
 
     auto scrollArea = new QScrollArea(this);
     scrollArea->setWidgetResizable(true);
-    scrollArea->setWidget(deskMapContainer);
+    scrollArea->setWidget(deskMap);
 
     mapLayout->addWidget(scrollArea);
     mainLayout->addWidget(mapPanel, 1);
@@ -104,6 +120,10 @@ void BookingView::setupMenus() {
     connect(loginAction, &QAction::triggered, this, &BookingView::showLoginDialog);
     userMenu->addAction(loginAction);
 
+    myBookingsAction = new QAction("Moje rezerwacje", this);
+    connect(myBookingsAction, &QAction::triggered, this, &BookingView::showMyBookings);
+    userMenu->addAction(myBookingsAction);
+
     logoutAction = new QAction("Wyloguj", this);
     connect(logoutAction, &QAction::triggered, this, &BookingView::handleUserLogout);
     userMenu->addAction(logoutAction);
@@ -127,45 +147,85 @@ bool BookingView::checkLogin(const QString &action) {
 void BookingView::dateChanged(const QDate &date) {
     selectedDate = date;
     infoLabel->setText(QString("Plan biurek na %1").arg(date.toString("dd.MM.yyyy")));
-    updateDeskMap();
+
+    // Rezerwacje biurek są już pobrane, wystarczy odświeżyć mapę
+    scheduleNavigation(false);
 }
 
 void BookingView::buildingChanged(int index) {
     if (index >= 0 && index < buildingSelect->count()) {
         selectedBuildingId = buildingSelect->itemData(index).toInt();
         loadFloors(selectedBuildingId);
-
-        // Odśwież widok tylko jeśli wybrano konkretny budynek
-        if (selectedBuildingId > 0) {
-            refreshView();
-        } else {
-            // Wyczyść widok biurek jeśli wybrano "Wybierz budynek"
-            desks.clear();
-            updateDeskMap();
-        }
+        scheduleNavigation(true);
     }
 }
 
 void BookingView::floorChanged(int index) {
     if (index >= 0 && index < floorSelect->count()) {
         selectedFloor = floorSelect->itemData(index).toInt();
+        scheduleNavigation(true);
+    }
+}
 
-        // Odśwież tylko jeśli wybrano budynek i piętro
-        if (selectedBuildingId > 0 && selectedFloor > 0) {
-            refreshView();
-        } else {
-            // Wyczyść widok biurek jeśli wybrano "Wybierz piętro"
-            desks.clear();
-            updateDeskMap();
+void BookingView::scheduleNavigation(bool fetchDesks) {
+    pendingFetch = pendingFetch || fetchDesks;
+    navigationTimer->start();
+}
+
+void BookingView::applyNavigation() {
+    if (pendingFetch) {
+        pendingFetch = false;
+        requestDesks();
+    } else {
+        updateDeskMap();
+    }
+}
+
+void BookingView::requestDesks() {
+    navigationTimer->stop();
+    pendingFetch = false;
+
+    // Odpowiedzi dla wcześniejszych wyborów zostaną pominięte
+    quint64 generation = ++navigationGeneration;
+
+    // Pobierz biurka tylko jeśli użytkownik jest zalogowany ORAZ wybrano budynek/piętro
+    if (!apiClient.isLoggedIn() || selectedBuildingId <= 0 || selectedFloor <= 0) {
+        if (!pendingDesksRequest.isEmpty()) {
+            apiClient.abortRequest(pendingDesksRequest);
+            pendingDesksRequest.clear();
         }
+        desks.clear();
+        updateDeskMap();
+        return;
+    }
+
+    QPointer<BookingView> self(this);
+    QString requestKey = apiClient.getDesksAsync(
+        selectedBuildingId, selectedFloor,
+        [self, generation](std::vector<Desk> result) {
+            if (!self || generation != self->navigationGeneration) {
+                return;
+            }
+            self->pendingDesksRequest.clear();
+            self->desks = std::move(result);
+            self->updateDeskMap();
+        });
+
+    // Przerwij żądanie dla nieaktualnego piętra
+    if (!pendingDesksRequest.isEmpty() && pendingDesksRequest != requestKey) {
+        apiClient.abortRequest(pendingDesksRequest);
     }
+    pendingDesksRequest = requestKey;
 }
 
 void BookingView::loadBuildings() {
-    buildingSelect->clear();
-
     // Pobierz budynki z serwera
     buildings = apiClient.getBuildings();
+    populateBuildings();
+}
+
+void BookingView::populateBuildings() {
+    buildingSelect->clear();
 
     // Dodaj budynki do combobox
     buildingSelect->addItem("Wybierz budynek", -1);
@@ -207,7 +267,7 @@ void BookingView::loadFloors(int buildingId) {
     }
 }
 
-void BookingView::refreshView() {
+void BookingView::updateUserStatus() {
     // Aktualizacja statusu logowania w UI
     if (apiClient.isLoggedIn() && apiClient.getCurrentUser()) {
         userLabel->setText(QString("Zalogowano jako: %1")
@@ -218,124 +278,58 @@ void BookingView::refreshView() {
 
     // Aktualizuj widoczność opcji menu
     updateMenuVisibility();
+}
+
+void BookingView::refreshView() {
+    updateUserStatus();
 
     // Załaduj budynki jeśli potrzeba
     if (buildings.empty()) {
         loadBuildings();
     }
 
-    // Zawsze wyczyść istniejące biurka, aby pobrać świeże dane
-    desks.clear();
-
-    // Pobierz biurka tylko jeśli użytkownik jest zalogowany ORAZ wybrano budynek/piętro
-    if (apiClient.isLoggedIn() && selectedBuildingId > 0 && selectedFloor > 0) {
-        desks = apiClient.getDesks(selectedBuildingId, selectedFloor);
-    }
-
-    // Aktualizuj widok biurek
-    updateDeskMap();
+    // Pobierz świeże dane biurek dla bieżącego wyboru
+    requestDesks();
 }
 
 void BookingView::updateMenuVisibility() {
     bool isLoggedIn = apiClient.isLoggedIn();
     loginAction->setVisible(!isLoggedIn);
+    myBookingsAction->setVisible(isLoggedIn);
     logoutAction->setVisible(isLoggedIn);
 }
 
 void BookingView::updateDeskMap() {
-    // Wyczyść istniejące elementy
-    while (QLayoutItem *item = deskMapLayout->takeAt(0)) {
-        if (QWidget *widget = item->widget()) {
-            widget->deleteLater();
-        }
-        delete item;
-    }
-
     // Sprawdź status logowania
     if (!apiClient.isLoggedIn()) {
-        auto loginButton = new QPushButton("Zaloguj się, aby zobaczyć biurka", this);
-        connect(loginButton, &QPushButton::clicked, this, &BookingView::showLoginDialog);
-        deskMapLayout->addWidget(loginButton, 0, 0);
+        deskMap->setMessage("Zaloguj się, aby zobaczyć biurka", true);
         return;
     }
 
     // Jeśli nie wybrano budynku lub piętra, pokaż komunikat
     if (selectedBuildingId <= 0 || selectedFloor <= 0) {
-        auto promptLabel = new QLabel("Wybierz budynek i piętro, aby zobaczyć dostępne biurka", this);
-        promptLabel->setAlignment(Qt::AlignCenter);
-        promptLabel->setWordWrap(true);
-        deskMapLayout->addWidget(promptLabel, 0, 0);
+        deskMap->setMessage("Wybierz budynek i piętro, aby zobaczyć dostępne biurka");
         return;
     }
 
     // Brak biurek dla tej kombinacji
     if (desks.empty()) {
-        auto noDesksLabel = new QLabel(QString("Nie znaleziono biurek dla Budynku ID %1, Piętro %2")
-                                       .arg(selectedBuildingId).arg(selectedFloor), this);
-        noDesksLabel->setAlignment(Qt::AlignCenter);
-        noDesksLabel->setWordWrap(true);
-        deskMapLayout->addWidget(noDesksLabel, 0, 0);
+        deskMap->setMessage(QString("Nie znaleziono biurek dla Budynku ID %1, Piętro %2")
+            .arg(selectedBuildingId).arg(selectedFloor));
         return;
     }
 
     // Wyświetl biurka
     int currentUserId = apiClient.getCurrentUser() ? apiClient.getCurrentUser()->getId() : -1;
-
-    for (size_t i = 0; i < desks.size(); ++i) {
-        const auto &desk = desks[i];
-        bool isBooked = desk.isBookedOnDate(selectedDate);
-
-        // Utwórz przycisk
-        auto button = new QPushButton(this);
-        button->setMinimumSize(100, 80);
-
-        // Przycisk z informacją o piętrze
-        QString deskName = QString::fromStdString(desk.getName());
-        QString floorInfo = QString("Piętro %1").arg(desk.getFloor());
-
-        if (isBooked) {
-            auto bookings = desk.getBookingsContainingDate(selectedDate);
-            if (!bookings.empty()) {
-                const auto &booking = bookings[0];
-                int bookingUserId = booking.getUserId();
-
-                if (currentUserId == bookingUserId) {
-                    // Niebieski dla własnych rezerwacji
-                    button->setStyleSheet("background-color: #2196F3; color: white;");
-                    button->setText(deskName + "\n" + floorInfo + "\nZarezerwowane przez Ciebie");
-                } else {
-                    // Czerwony dla rezerwacji innych osób
-                    button->setStyleSheet("background-color: #F44336; color: white;");
-                    button->setText(deskName + "\n" + floorInfo + "\nZarezerwowane przez Użytkownika #" +
-                                    QString::number(bookingUserId));
-                }
-            }
-        } else {
-            // Zielony dla dostępnych biurek
-            button->setText(deskName + "\n" + floorInfo + "\nDostępne");
-            button->setStyleSheet("background-color: #4CAF50; color: white;");
-        }
-
-        // Przechowaj indeks biurka dla obsługi kliknięcia
-        button->setProperty("index", static_cast<int>(i));
-        button->setProperty("is_booked", isBooked);
-        connect(button, &QPushButton::clicked, this, &BookingView::deskClicked);
-
-        // Użyj domyślnego układu siatki - 4 kolumny
-        deskMapLayout->addWidget(button, i / 4, i % 4);
-    }
+    deskMap->setDesks(desks, selectedDate, currentUserId);
 }
 
-void BookingView::deskClicked() {
+void BookingView::deskClicked(int deskIndex) {
     // Najpierw sprawdź logowanie
     if (!checkLogin("zobaczyć szczegóły biurka")) {
         return;
     }
 
-    QPushButton *button = qobject_cast<QPushButton *>(sender());
-    if (!button) return;
-
-    int deskIndex = button->property("index").toInt();
     if (deskIndex < 0 || deskIndex >= static_cast<int>(desks.size())) return;
 
     // Pokaż dialog rezerwacji z aktualnymi danymi biurka
@@ -349,6 +343,59 @@ void BookingView::deskClicked() {
 void BookingView::showLoginDialog() {
     LoginDialog dialog(apiClient, this);
     if (dialog.exec() == QDialog::Accepted) {
+        // Dane startowe z odpowiedzi logowania pozwalają pominąć kolejne zapytania
+        if (auto bootstrap = apiClient.takeBootstrap()) {
+            applyBootstrap(*bootstrap);
+        } else {
+            refreshView();
+        }
+    }
+}
+
+void BookingView::applyBootstrap(const ApiClient::BootstrapData &bootstrap) {
+    updateUserStatus();
+
+    // Pomiń odpowiedzi na wcześniejsze zapytania o biurka
+    navigationTimer->stop();
+    pendingFetch = false;
+    ++navigationGeneration;
+
+    buildings = bootstrap.buildings;
+    {
+        // Zmiany list wyboru nie mogą wywołać nawigacji
+        QSignalBlocker buildingBlocker(buildingSelect);
+        QSignalBlocker floorBlocker(floorSelect);
+
+        populateBuildings();
+        int buildingIndex = buildingSelect->findData(bootstrap.buildingId);
+        buildingSelect->setCurrentIndex(std::max(0, buildingIndex));
+        selectedBuildingId = buildingIndex > 0 ? bootstrap.buildingId : -1;
+
+        loadFloors(selectedBuildingId);
+        int floorIndex = floorSelect->findData(bootstrap.floor);
+        floorSelect->setCurrentIndex(std::max(0, floorIndex));
+        selectedFloor = floorIndex > 0 ? bootstrap.floor : -1;
+    }
+
+    desks = bootstrap.desks;
+    updateDeskMap();
+
+    if (!bootstrap.upcomingBookings.empty()) {
+        statusBar()->showMessage(QString("Nadchodzące rezerwacje: %1").arg(bootstrap.upcomingBookings.size()),
+                                 5000);
+    }
+}
+
+void BookingView::showMyBookings() {
+    if (!checkLogin("zobaczyć swoje rezerwacje")) {
+        return;
+    }
+
+    MyBookingsDialog dialog(apiClient, this);
+    dialog.exec();
+
+    // Anulowane rezerwacje znikają z mapy biurek
+    if (dialog.bookingsChanged()) {
         refreshView();
     }
 }
@@ -365,3 +412,16 @@ void BookingView::handleNetworkError(const QString &error) {
         LOG_ERROR("Błąd sieci: {}", error.toStdString());
     }
 }
+
+void BookingView::handleConnectivityChanged(bool online) {
+    if (online) {
+        statusBar()->showMessage("Połączono z serwerem", 3000);
+    } else {
+        statusBar()->showMessage("Tryb offline - dane z pamięci podręcznej, rezerwacje trafią do kolejki");
+    }
+}
+
+void BookingView::handleOutboxItemFailed(const QString &item, const QString &message) {
+    QMessageBox::warning(this, "Konflikt rezerwacji",
+                         QString("Serwer odrzucił operację z kolejki offline:\n%1\n\n%2").arg(item, message));
+}
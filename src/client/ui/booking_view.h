@@ -5,14 +5,15 @@
 #include <QCalendarWidget>
 #include <QComboBox>
 #include <QLabel>
-#include <QGridLayout>
 #include <QDate>
 #include <QPushButton>
 #include <QMenu>
 #include <QAction>
+#include <QTimer>
 
 #include "common/model/model.h"
 #include "../net/api_client.h"
+#include "desk_map_widget.h"
 
 /**
  * @class BookingView
@@ -58,14 +59,20 @@ private slots:
 
     /**
      * @brief Obsługuje kliknięcie na biurko
+     * @param deskIndex Indeks biurka na mapie
      */
-    void deskClicked();
+    void deskClicked(int deskIndex);
 
     /**
      * @brief Pokazuje dialog logowania
      */
     void showLoginDialog();
 
+    /**
+     * @brief Pokazuje listę rezerwacji zalogowanego użytkownika
+     */
+    void showMyBookings();
+
     /**
      * @brief Obsługuje wylogowanie użytkownika
      */
@@ -77,6 +84,24 @@ private slots:
      */
     void handleNetworkError(const QString &error);
 
+    /**
+     * @brief Stosuje ostatni wybór po wygaszeniu nawigacji
+     */
+    void applyNavigation();
+
+    /**
+     * @brief Obsługuje zmianę dostępności serwera
+     * @param online Czy serwer jest osiągalny
+     */
+    void handleConnectivityChanged(bool online);
+
+    /**
+     * @brief Informuje o operacji z kolejki offline odrzuconej przez serwer
+     * @param item Opis operacji
+     * @param message Komunikat serwera
+     */
+    void handleOutboxItemFailed(const QString &item, const QString &message);
+
 private:
     /**
      * @brief Inicjalizuje interfejs użytkownika
@@ -103,6 +128,33 @@ private:
      */
     void loadBuildings();
 
+    /**
+     * @brief Wypełnia listę wyboru budynków na podstawie pobranych danych
+     */
+    void populateBuildings();
+
+    /**
+     * @brief Aktualizuje informacje o zalogowanym użytkowniku
+     */
+    void updateUserStatus();
+
+    /**
+     * @brief Wyświetla widok na podstawie danych startowych z logowania
+     * @param bootstrap Dane startowe
+     */
+    void applyBootstrap(const ApiClient::BootstrapData &bootstrap);
+
+    /**
+     * @brief Planuje odświeżenie widoku po wygaszeniu szybkiej nawigacji
+     * @param fetchDesks Czy wymagane jest pobranie biurek z serwera
+     */
+    void scheduleNavigation(bool fetchDesks);
+
+    /**
+     * @brief Pobiera biurka dla bieżącego wyboru bez blokowania interfejsu
+     */
+    void requestDesks();
+
     /**
      * @brief Sprawdza czy użytkownik jest zalogowany
      * @param action Opis akcji wymagającej logowania (opcjonalny)
@@ -117,10 +169,11 @@ private:
     QLabel *infoLabel;
     QLabel *userLabel;
     QPushButton *refreshButton;
-    QGridLayout *deskMapLayout;
-    QWidget *deskMapContainer;
+    DeskMapWidget *deskMap;
+    QTimer *navigationTimer;
     QMenu *userMenu;
     QAction *loginAction;
+    QAction *myBookingsAction;
     QAction *logoutAction;
 
     // Dane
@@ -133,6 +186,12 @@ private:
     int selectedFloor = -1;
     QDate selectedDate;
 
+    // Nawigacja
+    static constexpr int NavigationDebounceMs = 150;
+    bool pendingFetch = false;
+    quint64 navigationGeneration = 0;
+    QString pendingDesksRequest;
+
     /**
      * @brief Ładuje listę pięter dla budynku
      * @param buildingId ID budynku
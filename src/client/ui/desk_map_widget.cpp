@@ -0,0 +1,273 @@
+#include "desk_map_widget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <algorithm>
+#include "qt_date.h"
+
+namespace {
+    /**
+     * @brief Zwraca kolor tła kafelka dla stanu biurka
+     */
+    QColor tileColor(DeskMapWidget::DeskState state) {
+        switch (state) {
+            case DeskMapWidget::DeskState::Mine:
+                return QColor("#2196F3");
+            case DeskMapWidget::DeskState::Taken:
+                return QColor("#F44336");
+            case DeskMapWidget::DeskState::Free:
+            default:
+                return QColor("#4CAF50");
+        }
+    }
+
+    /**
+     * @brief Zwraca opis stanu biurka
+     */
+    QString tileStatus(DeskMapWidget::DeskState state, int bookingUserId) {
+        switch (state) {
+            case DeskMapWidget::DeskState::Mine:
+                return "Zarezerwowane przez Ciebie";
+            case DeskMapWidget::DeskState::Taken:
+                return "Zarezerwowane przez Użytkownika #" + QString::number(bookingUserId);
+            case DeskMapWidget::DeskState::Free:
+            default:
+                return "Dostępne";
+        }
+    }
+
+    /**
+     * @brief Przygotowuje tekst statyczny wyśrodkowany w szerokości kafelka
+     */
+    QStaticText makeGlyphs(const QString &text, int width) {
+        QStaticText glyphs(text);
+        glyphs.setTextOption(QTextOption(Qt::AlignHCenter));
+        glyphs.setTextWidth(width);
+        glyphs.setPerformanceHint(QStaticText::AggressiveCaching);
+        return glyphs;
+    }
+}
+
+DeskMapWidget::DeskMapWidget(QWidget *parent)
+    : QWidget(parent) {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+int DeskMapWidget::setDesks(const std::vector<Desk> &desks, const QDate &date, int currentUserId) {
+    bool wasMessage = !_message.isEmpty();
+    _message.clear();
+    _messageClickable = false;
+    setCursor(Qt::PointingHandCursor);
+
+    // Inny układ biurek (także przeniesienie biurka do innego budynku) wymaga pełnej przebudowy kafelków
+    bool rebuild = wasMessage || !hasSameLayout(desks);
+    if (rebuild) {
+        _tiles.clear();
+        _tiles.resize(desks.size());
+    }
+
+    Date day = toDate(date);
+    int changed = 0;
+    for (size_t i = 0; i < desks.size(); ++i) {
+        const auto &desk = desks[i];
+        auto &tile = _tiles[i];
+
+        // Nagłówek jest budowany z nazwy i piętra, więc zmiana któregokolwiek wymaga nowego tekstu
+        bool headerChanged = rebuild || tile.name != desk.getName() || tile.floor != desk.getFloor();
+        if (headerChanged) {
+            tile.deskId = desk.getId();
+            tile.buildingId = desk.getBuildingId();
+            tile.floor = desk.getFloor();
+            tile.name = desk.getName();
+            tile.header = makeGlyphs(QString("%1\nPiętro %2")
+                                     .arg(QString::fromStdString(desk.getName()))
+                                     .arg(desk.getFloor()), TileWidth - 8);
+        }
+
+        DeskState state = DeskState::Free;
+        int bookingUserId = 0;
+        if (desk.isBookedOnDate(day)) {
+            bookingUserId = desk.getBookingForDate(day).getUserId();
+            state = (currentUserId == bookingUserId) ? DeskState::Mine : DeskState::Taken;
+        }
+
+        if (headerChanged || tile.state != state || tile.bookingUserId != bookingUserId) {
+            applyState(tile, state, bookingUserId);
+            ++changed;
+            if (!rebuild) {
+                update(tileRect(static_cast<int>(i)));
+            }
+        }
+    }
+
+    if (rebuild) {
+        updateGeometryForTiles();
+        update();
+    }
+    return changed;
+}
+
+bool DeskMapWidget::hasSameLayout(const std::vector<Desk> &desks) const {
+    if (desks.size() != _tiles.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < desks.size(); ++i) {
+        if (desks[i].getId() != _tiles[i].deskId || desks[i].getBuildingId() != _tiles[i].buildingId) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DeskMapWidget::applyState(DeskTile &tile, DeskState state, int bookingUserId) {
+    // Teksty stanów wolnych i własnych są wspólne, więc QStaticText współdzieli dane
+    static const QStaticText freeStatus = makeGlyphs(tileStatus(DeskState::Free, 0), TileWidth - 8);
+    static const QStaticText mineStatus = makeGlyphs(tileStatus(DeskState::Mine, 0), TileWidth - 8);
+
+    tile.state = state;
+    tile.bookingUserId = bookingUserId;
+    switch (state) {
+        case DeskState::Free:
+            tile.status = freeStatus;
+            break;
+        case DeskState::Mine:
+            tile.status = mineStatus;
+            break;
+        case DeskState::Taken:
+            tile.status = makeGlyphs(tileStatus(state, bookingUserId), TileWidth - 8);
+            break;
+    }
+}
+
+void DeskMapWidget::setMessage(const QString &message, bool clickable) {
+    _tiles.clear();
+    _message = message;
+    _messageClickable = clickable;
+    setCursor(clickable ? Qt::PointingHandCursor : Qt::ArrowCursor);
+
+    updateGeometryForTiles();
+    update();
+}
+
+QRect DeskMapWidget::tileRect(int index) const {
+    int row = index / _columns;
+    int column = index % _columns;
+    return {
+        TileSpacing + column * (TileWidth + TileSpacing),
+        TileSpacing + row * (TileHeight + TileSpacing),
+        TileWidth,
+        TileHeight
+    };
+}
+
+int DeskMapWidget::tileAt(const QPoint &pos) const {
+    if (pos.x() < TileSpacing || pos.y() < TileSpacing) {
+        return -1;
+    }
+
+    int column = (pos.x() - TileSpacing) / (TileWidth + TileSpacing);
+    int row = (pos.y() - TileSpacing) / (TileHeight + TileSpacing);
+    if (column >= _columns) {
+        return -1;
+    }
+
+    int index = row * _columns + column;
+    if (index < 0 || index >= static_cast<int>(_tiles.size())) {
+        return -1;
+    }
+
+    // Odstępy między kafelkami nie należą do żadnego biurka
+    return tileRect(index).contains(pos) ? index : -1;
+}
+
+QSize DeskMapWidget::sizeHint() const {
+    return {4 * (TileWidth + TileSpacing) + TileSpacing, 3 * (TileHeight + TileSpacing) + TileSpacing};
+}
+
+void DeskMapWidget::updateGeometryForTiles() {
+    _columns = std::max(1, (width() - TileSpacing) / (TileWidth + TileSpacing));
+
+    int rows = (static_cast<int>(_tiles.size()) + _columns - 1) / _columns;
+    setMinimumHeight(TileSpacing + rows * (TileHeight + TileSpacing));
+}
+
+void DeskMapWidget::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+
+    int columns = std::max(1, (width() - TileSpacing) / (TileWidth + TileSpacing));
+    if (columns != _columns) {
+        updateGeometryForTiles();
+        update();
+    }
+}
+
+void DeskMapWidget::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+    painter.fillRect(dirty, palette().window());
+
+    if (!_message.isEmpty()) {
+        painter.setPen(palette().color(_messageClickable ? QPalette::Link : QPalette::WindowText));
+        painter.drawText(rect().adjusted(TileSpacing, TileSpacing, -TileSpacing, -TileSpacing),
+                         Qt::AlignCenter | Qt::TextWordWrap, _message);
+        return;
+    }
+
+    if (_tiles.empty()) {
+        return;
+    }
+
+    // Rysuj tylko wiersze przecinające odświeżany obszar
+    const int rowHeight = TileHeight + TileSpacing;
+    const int rowCount = (static_cast<int>(_tiles.size()) + _columns - 1) / _columns;
+    const int firstRow = std::max(0, (dirty.top() - TileSpacing) / rowHeight);
+    const int lastRow = std::min(rowCount - 1, dirty.bottom() / rowHeight);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = 0; column < _columns; ++column) {
+            int index = row * _columns + column;
+            if (index >= static_cast<int>(_tiles.size())) {
+                break;
+            }
+
+            QRect rect = tileRect(index);
+            if (!rect.intersects(dirty)) {
+                continue;
+            }
+
+            const auto &tile = _tiles[index];
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(tileColor(tile.state));
+            painter.drawRoundedRect(rect, 4, 4);
+
+            // Teksty kafelków są przygotowane wcześniej i rysowane bez ponownego układania
+            painter.setPen(Qt::white);
+            qreal textHeight = tile.header.size().height() + tile.status.size().height();
+            QPointF origin(rect.left() + 4, rect.top() + (rect.height() - textHeight) / 2);
+            painter.drawStaticText(origin, tile.header);
+            painter.drawStaticText(origin + QPointF(0, tile.header.size().height()), tile.status);
+            ++_paintedTiles;
+        }
+    }
+}
+
+void DeskMapWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
+    if (!_message.isEmpty()) {
+        if (_messageClickable && rect().contains(event->position().toPoint())) {
+            emit messageClicked();
+        }
+        return;
+    }
+
+    int index = tileAt(event->position().toPoint());
+    if (index >= 0) {
+        emit deskClicked(index);
+    }
+}
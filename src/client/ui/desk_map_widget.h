@@ -0,0 +1,154 @@
+#ifndef DESK_MAP_WIDGET_H
+#define DESK_MAP_WIDGET_H
+
+#include <QWidget>
+#include <QDate>
+#include <QString>
+#include <QStaticText>
+#include <vector>
+
+#include "common/model/model.h"
+
+/**
+ * @class DeskMapWidget
+ * @brief Widżet rysujący mapę biurek w jednym przebiegu malowania.
+ *
+ * Zamiast osobnego przycisku dla każdego biurka przechowuje stan biurek
+ * w płaskiej tablicy i rysuje jedynie kafelki widoczne w obszarze przewijania.
+ * Kolejne migawki piętra są porównywane z poprzednią, więc odświeżane są
+ * tylko kafelki, których stan się zmienił. Kliknięcie kafelka jest
+ * rozpoznawane na podstawie pozycji kursora.
+ */
+class DeskMapWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Stan biurka w wybranym dniu
+     */
+    enum class DeskState : quint8 {
+        Free,
+        Mine,
+        Taken
+    };
+
+    /**
+     * @brief Dane pojedynczego kafelka mapy
+     */
+    struct DeskTile {
+        int deskId = 0;
+        int buildingId = 0;
+        int floor = 0;
+        int bookingUserId = 0;
+        DeskState state = DeskState::Free;
+        std::string name;
+        QStaticText header; ///< Nazwa i piętro biurka
+        QStaticText status;
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param parent Obiekt rodzica (opcjonalny)
+     */
+    explicit DeskMapWidget(QWidget *parent = nullptr);
+
+    /**
+     * @brief Ustawia biurka do wyświetlenia
+     *
+     * Jeśli lista biurek jest taka sama jak poprzednio, przerysowywane są
+     * tylko kafelki o zmienionym stanie.
+     *
+     * @param desks Lista biurek
+     * @param date Data, dla której wyznaczany jest stan biurek
+     * @param currentUserId ID zalogowanego użytkownika
+     * @return Liczba kafelków oznaczonych do przerysowania
+     */
+    int setDesks(const std::vector<Desk> &desks, const QDate &date, int currentUserId);
+
+    /**
+     * @brief Zastępuje mapę komunikatem tekstowym
+     * @param message Treść komunikatu
+     * @param clickable Czy komunikat reaguje na kliknięcie
+     */
+    void setMessage(const QString &message, bool clickable = false);
+
+    /**
+     * @brief Pobiera kafelki mapy
+     * @return Płaska tablica kafelków
+     */
+    const std::vector<DeskTile> &getTiles() const { return _tiles; }
+
+    /**
+     * @brief Wyznacza indeks kafelka pod wskazanym punktem
+     * @param pos Punkt we współrzędnych widżetu
+     * @return Indeks kafelka lub -1, jeśli punkt nie trafia w kafelek
+     */
+    int tileAt(const QPoint &pos) const;
+
+    /**
+     * @brief Pobiera łączną liczbę narysowanych kafelków
+     * @return Liczba kafelków narysowanych od utworzenia widżetu
+     */
+    qint64 getPaintedTileCount() const { return _paintedTiles; }
+
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Sygnał emitowany po kliknięciu biurka
+     * @param index Indeks biurka w przekazanej liście
+     */
+    void deskClicked(int index);
+
+    /**
+     * @brief Sygnał emitowany po kliknięciu komunikatu
+     */
+    void messageClicked();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    static constexpr int TileWidth = 140;
+    static constexpr int TileHeight = 80;
+    static constexpr int TileSpacing = 8;
+
+    /**
+     * @brief Wyznacza prostokąt kafelka o podanym indeksie
+     * @param index Indeks kafelka
+     * @return Prostokąt kafelka
+     */
+    QRect tileRect(int index) const;
+
+    /**
+     * @brief Przelicza liczbę kolumn i wysokość widżetu
+     */
+    void updateGeometryForTiles();
+
+    /**
+     * @brief Sprawdza czy nowa lista biurek ma ten sam układ co bieżące kafelki
+     * @param desks Nowa lista biurek
+     * @return Czy identyfikatory i budynki biurek są takie same i w tej samej kolejności
+     */
+    bool hasSameLayout(const std::vector<Desk> &desks) const;
+
+    /**
+     * @brief Ustawia stan kafelka i przygotowuje tekst statusu
+     * @param tile Kafelek do aktualizacji
+     * @param state Nowy stan
+     * @param bookingUserId ID użytkownika rezerwującego
+     */
+    static void applyState(DeskTile &tile, DeskState state, int bookingUserId);
+
+    std::vector<DeskTile> _tiles;
+    QString _message;
+    bool _messageClickable = false;
+    int _columns = 1;
+    qint64 _paintedTiles = 0;
+};
+
+#endif
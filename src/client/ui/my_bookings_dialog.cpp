@@ -0,0 +1,134 @@
+#include "my_bookings_dialog.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QMessageBox>
+#include <QPointer>
+#include "common/logger.h"
+
+MyBookingsDialog::MyBookingsDialog(ApiClient &apiClient, QWidget *parent)
+    : QDialog(parent), apiClient(apiClient) {
+    setWindowTitle("Moje rezerwacje");
+    resize(520, 480);
+
+    auto layout = new QVBoxLayout(this);
+
+    // Data początkowa listy
+    auto filterLayout = new QHBoxLayout();
+    filterLayout->addWidget(new QLabel("Rezerwacje od:", this));
+    fromEdit = new QDateEdit(QDate::currentDate(), this);
+    fromEdit->setCalendarPopup(true);
+    connect(fromEdit, &QDateEdit::dateChanged, this, &MyBookingsDialog::reload);
+    filterLayout->addWidget(fromEdit);
+    filterLayout->addStretch();
+    layout->addLayout(filterLayout);
+
+    // Wszystkie wiersze mają tę samą wysokość, więc widok nie mierzy każdego z nich
+    model = new UserBookingsModel(apiClient, this);
+    listView = new QListView(this);
+    listView->setModel(model);
+    listView->setUniformItemSizes(true);
+    listView->setSelectionMode(QAbstractItemView::SingleSelection);
+    listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    layout->addWidget(listView, 1);
+
+    statusLabel = new QLabel(this);
+    layout->addWidget(statusLabel);
+
+    auto buttonLayout = new QHBoxLayout();
+    cancelButton = new QPushButton("Anuluj rezerwację", this);
+    connect(cancelButton, &QPushButton::clicked, this, &MyBookingsDialog::cancelSelected);
+    buttonLayout->addWidget(cancelButton);
+    buttonLayout->addStretch();
+
+    auto closeButton = new QPushButton("Zamknij", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
+    buttonLayout->addWidget(closeButton);
+    layout->addLayout(buttonLayout);
+
+    connect(model, &UserBookingsModel::pageLoaded, this, &MyBookingsDialog::updateStatus);
+    connect(listView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &MyBookingsDialog::updateButtons);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &MyBookingsDialog::updateButtons);
+
+    reload();
+}
+
+void MyBookingsDialog::reload() {
+    auto user = apiClient.getCurrentUser();
+    if (!user) {
+        return;
+    }
+
+    statusLabel->setText("Wczytywanie...");
+    model->reload(user->getId(), fromEdit->date());
+    updateButtons();
+}
+
+void MyBookingsDialog::cancelSelected() {
+    QModelIndex index = listView->currentIndex();
+    if (!index.isValid()) {
+        return;
+    }
+
+    auto answer = QMessageBox::question(this, "Anulowanie rezerwacji",
+                                        "Czy na pewno anulować rezerwację?\n" + index.data().toString());
+    if (answer != QMessageBox::Yes) {
+        return;
+    }
+
+    int bookingId = index.data(UserBookingsModel::BookingIdRole).toInt();
+    canceling = true;
+    updateButtons();
+
+    QPointer<MyBookingsDialog> self(this);
+    apiClient.cancelBookingAsync(bookingId, [self, bookingId](bool ok) {
+        if (!self) {
+            return;
+        }
+        self->canceling = false;
+        if (ok) {
+            LOG_INFO("Anulowano rezerwację {} z listy rezerwacji", bookingId);
+            self->removeBooking(bookingId);
+            self->changed = true;
+            self->updateStatus(true);
+        } else {
+            QMessageBox::warning(self, "Błąd", "Nie udało się anulować rezerwacji");
+        }
+        self->updateButtons();
+    });
+}
+
+void MyBookingsDialog::removeBooking(int bookingId) {
+    // Lista mogła zostać przeładowana w trakcie anulowania, więc wiersz jest szukany po ID
+    for (int row = 0; row < model->rowCount(); ++row) {
+        if (model->index(row).data(UserBookingsModel::BookingIdRole).toInt() == bookingId) {
+            model->removeEntry(row);
+            return;
+        }
+    }
+}
+
+void MyBookingsDialog::updateStatus(bool ok) {
+    if (!ok) {
+        statusLabel->setText("Nie udało się pobrać rezerwacji");
+        return;
+    }
+
+    int count = model->rowCount();
+    if (count == 0 && model->isComplete()) {
+        statusLabel->setText("Brak rezerwacji");
+    } else if (model->isComplete()) {
+        statusLabel->setText(QString("Rezerwacje: %1").arg(count));
+    } else {
+        statusLabel->setText(QString("Wczytano %1 rezerwacji, przewiń, aby zobaczyć kolejne").arg(count));
+    }
+}
+
+void MyBookingsDialog::updateButtons() {
+    QModelIndex index = listView->currentIndex();
+    bool selected = index.isValid() && listView->selectionModel()->isSelected(index);
+
+    // Zakończonych rezerwacji nie można anulować; kolejne anulowanie czeka na poprzednie
+    cancelButton->setEnabled(selected && !canceling &&
+                             index.data(UserBookingsModel::DateToRole).toDate() >= QDate::currentDate());
+}
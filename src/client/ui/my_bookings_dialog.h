@@ -0,0 +1,76 @@
+#ifndef MY_BOOKINGS_DIALOG_H
+#define MY_BOOKINGS_DIALOG_H
+
+#include <QDialog>
+#include <QDateEdit>
+#include <QLabel>
+#include <QListView>
+#include <QPushButton>
+
+#include "../net/api_client.h"
+#include "user_bookings_model.h"
+
+/**
+ * @class MyBookingsDialog
+ * @brief Dialog z listą rezerwacji zalogowanego użytkownika.
+ *
+ * Lista jest wczytywana stronami podczas przewijania i pozwala
+ * anulować wybraną rezerwację.
+ */
+class MyBookingsDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param apiClient Referencja do klienta API
+     * @param parent Obiekt rodzica (opcjonalny)
+     */
+    explicit MyBookingsDialog(ApiClient &apiClient, QWidget *parent = nullptr);
+
+    /**
+     * @brief Sprawdza czy w dialogu anulowano jakąś rezerwację
+     * @return Czy rezerwacje uległy zmianie
+     */
+    bool bookingsChanged() const { return changed; }
+
+private slots:
+    /**
+     * @brief Wczytuje listę od nowa dla wybranej daty
+     */
+    void reload();
+
+    /**
+     * @brief Anuluje zaznaczoną rezerwację
+     */
+    void cancelSelected();
+
+    /**
+     * @brief Aktualizuje opis stanu listy
+     * @param ok Czy ostatnia strona została pobrana
+     */
+    void updateStatus(bool ok);
+
+    /**
+     * @brief Aktualizuje dostępność przycisku anulowania
+     */
+    void updateButtons();
+
+private:
+    /**
+     * @brief Usuwa rezerwację z listy
+     * @param bookingId ID rezerwacji
+     */
+    void removeBooking(int bookingId);
+
+    ApiClient &apiClient;
+    UserBookingsModel *model;
+    QDateEdit *fromEdit;
+    QListView *listView;
+    QLabel *statusLabel;
+    QPushButton *cancelButton;
+    bool changed = false;
+    bool canceling = false; ///< Czy anulowanie czeka na odpowiedź serwera
+};
+
+#endif
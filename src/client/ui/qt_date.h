@@ -0,0 +1,25 @@
+#ifndef QT_DATE_H
+#define QT_DATE_H
+
+#include <QDate>
+#include "common/model/date.h"
+
+/**
+ * @brief Konwertuje datę Qt na datę modelu
+ * @param date Data Qt
+ * @return Data modelu (niepoprawna dla niepoprawnej daty Qt)
+ */
+inline Date toDate(const QDate &date) {
+    return date.isValid() ? Date::fromJulianDay(date.toJulianDay()) : Date();
+}
+
+/**
+ * @brief Konwertuje datę modelu na datę Qt
+ * @param date Data modelu
+ * @return Data Qt (niepoprawna dla niepoprawnej daty modelu)
+ */
+inline QDate toQDate(Date date) {
+    return date.isValid() ? QDate::fromJulianDay(date.toJulianDay()) : QDate();
+}
+
+#endif
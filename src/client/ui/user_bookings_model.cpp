@@ -0,0 +1,112 @@
+#include "user_bookings_model.h"
+#include <QPointer>
+#include "qt_date.h"
+
+UserBookingsModel::UserBookingsModel(ApiClient &apiClient, QObject *parent)
+    : QAbstractListModel(parent), _apiClient(apiClient) {
+}
+
+void UserBookingsModel::reload(int userId, const QDate &from) {
+    // Odpowiedzi na żądania sprzed przeładowania są pomijane
+    ++_generation;
+    if (_loading) {
+        _apiClient.abortRequest(_pendingRequest);
+    }
+
+    beginResetModel();
+    _entries.clear();
+    _userId = userId;
+    _from = from;
+    _nextCursor.clear();
+    _hasMore = true;
+    _loading = false;
+    endResetModel();
+
+    requestPage();
+}
+
+void UserBookingsModel::removeEntry(int row) {
+    if (row < 0 || row >= static_cast<int>(_entries.size())) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    _entries.erase(_entries.begin() + row);
+    endRemoveRows();
+}
+
+int UserBookingsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(_entries.size());
+}
+
+QVariant UserBookingsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(_entries.size())) {
+        return {};
+    }
+
+    const auto &entry = _entries[index.row()];
+    switch (role) {
+        case Qt::DisplayRole: {
+            QDate dateFrom = toQDate(entry.booking.getDateFrom());
+            QDate dateTo = toQDate(entry.booking.getDateTo());
+            QString period = dateFrom == dateTo
+                                 ? dateFrom.toString("dd.MM.yyyy")
+                                 : dateFrom.toString("dd.MM.yyyy") + " - " + dateTo.toString("dd.MM.yyyy");
+            return QString("%1   %2, piętro %3, biurko %4")
+                .arg(period, entry.buildingName)
+                .arg(entry.floor)
+                .arg(entry.deskName);
+        }
+        case BookingIdRole:
+            return entry.booking.getId();
+        case DateToRole:
+            return toQDate(entry.booking.getDateTo());
+        default:
+            return {};
+    }
+}
+
+bool UserBookingsModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && _hasMore && !_loading && _userId > 0;
+}
+
+void UserBookingsModel::fetchMore(const QModelIndex &parent) {
+    if (canFetchMore(parent)) {
+        requestPage();
+    }
+}
+
+void UserBookingsModel::requestPage() {
+    _loading = true;
+    quint64 generation = _generation;
+    QPointer<UserBookingsModel> self(this);
+
+    _pendingRequest = _apiClient.getUserBookingsAsync(
+        _userId, _from, _nextCursor, PageSize,
+        [self, generation](ApiClient::UserBookingsPage page) {
+            // Model mógł zostać usunięty lub przeładowany w trakcie żądania
+            if (!self || generation != self->_generation) {
+                return;
+            }
+            self->_loading = false;
+
+            if (!page.ok) {
+                // Bez tego widok ponawiałby żądanie przy każdym przewinięciu
+                self->_hasMore = false;
+                emit self->pageLoaded(false);
+                return;
+            }
+
+            if (!page.entries.empty()) {
+                int first = static_cast<int>(self->_entries.size());
+                self->beginInsertRows(QModelIndex(), first, first + static_cast<int>(page.entries.size()) - 1);
+                for (auto &entry: page.entries) {
+                    self->_entries.push_back(std::move(entry));
+                }
+                self->endInsertRows();
+            }
+
+            self->_nextCursor = page.nextCursor;
+            self->_hasMore = !page.nextCursor.isEmpty();
+            emit self->pageLoaded(true);
+        });
+}
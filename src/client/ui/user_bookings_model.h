@@ -0,0 +1,93 @@
+#ifndef USER_BOOKINGS_MODEL_H
+#define USER_BOOKINGS_MODEL_H
+
+#include <QAbstractListModel>
+#include <QDate>
+#include <vector>
+
+#include "../net/api_client.h"
+
+/**
+ * @class UserBookingsModel
+ * @brief Model listy rezerwacji użytkownika pobieranej stronami.
+ *
+ * Kolejne strony są pobierane z serwera dopiero, gdy widok dojdzie do końca
+ * listy (canFetchMore/fetchMore), więc otwarcie listy nie zależy od liczby
+ * wszystkich rezerwacji użytkownika.
+ */
+class UserBookingsModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Dodatkowe role danych modelu
+     */
+    enum Roles {
+        BookingIdRole = Qt::UserRole + 1,
+        DateToRole
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param apiClient Referencja do klienta API
+     * @param parent Obiekt rodzica (opcjonalny)
+     */
+    explicit UserBookingsModel(ApiClient &apiClient, QObject *parent = nullptr);
+
+    /**
+     * @brief Czyści listę i pobiera pierwszą stronę rezerwacji
+     * @param userId ID użytkownika
+     * @param from Najwcześniejsza data zakończenia rezerwacji
+     */
+    void reload(int userId, const QDate &from);
+
+    /**
+     * @brief Usuwa rezerwację z listy (np. po anulowaniu)
+     * @param row Numer wiersza
+     */
+    void removeEntry(int row);
+
+    /**
+     * @brief Sprawdza czy trwa pobieranie strony
+     * @return Czy trwa pobieranie
+     */
+    bool isLoading() const { return _loading; }
+
+    /**
+     * @brief Sprawdza czy pobrano już wszystkie rezerwacje
+     * @return Czy lista jest kompletna
+     */
+    bool isComplete() const { return !_hasMore; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+signals:
+    /**
+     * @brief Sygnał emitowany po zakończeniu pobierania strony
+     * @param ok Czy strona została pobrana
+     */
+    void pageLoaded(bool ok);
+
+private:
+    /**
+     * @brief Wysyła żądanie następnej strony
+     */
+    void requestPage();
+
+    static constexpr int PageSize = 50;
+
+    ApiClient &_apiClient;
+    std::vector<ApiClient::UserBookingEntry> _entries;
+    int _userId = -1;
+    QDate _from;
+    QString _nextCursor;
+    QString _pendingRequest;
+    bool _hasMore = false;
+    bool _loading = false;
+    quint64 _generation = 0;
+};
+
+#endif
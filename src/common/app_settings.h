@@ -10,8 +10,9 @@
  * @class AppSettings
  * @brief Klasa zarządzająca ustawieniami aplikacji.
  *
- * Implementuje wzorzec Singleton i zapewnia dostęp do ustawień aplikacji.
- * Obsługuje parametry linii poleceń i stałe konfiguracyjne.
+ * Implementuje wzorzec Singleton i zapewnia dostęp do ustawień aplikacji
+ * klienta. Obsługuje parametry linii poleceń i ustawienia zapisane przez Qt.
+ * Ustawienia serwera zawiera ServerSettings.
  */
 class AppSettings {
 public:
@@ -49,26 +50,6 @@ public:
         _initialized = true;
     }
 
-    /**
-     * @brief Parsuje argumenty linii poleceń dla serwera
-     * @param argc Liczba argumentów
-     * @param argv Tablica argumentów
-     */
-    void parseCommandLine(int argc, char *argv[]) {
-        for (int i = 1; i < argc; i++) {
-            if ((strcmp(argv[i], "--port") == 0 || strcmp(argv[i], "-p") == 0) && i + 1 < argc) {
-                _port = std::stoi(argv[i + 1]);
-                i++;
-            } else if ((strcmp(argv[i], "--database") == 0 || strcmp(argv[i], "-db") == 0) && i + 1 < argc) {
-                _dbPath = argv[i + 1];
-                i++;
-            } else if (strcmp(argv[i], "--verbose") == 0 || strcmp(argv[i], "-v") == 0) {
-                _verbose = true;
-            }
-        }
-        _initialized = true;
-    }
-
     /**
      * @brief Pobiera adres serwera
      * @return Adres serwera
@@ -83,23 +64,11 @@ public:
      */
     int getServerPort() const { return _settings.value("server/port", 8080).toInt(); }
 
-    /**
-     * @brief Pobiera port serwera (konfiguracja serwera)
-     * @return Port serwera
-     */
-    int getPort() const { return _port; }
-
-    /**
-     * @brief Pobiera ścieżkę do pliku bazy danych
-     * @return Ścieżka do pliku bazy danych
-     */
-    std::string getDatabasePath() const { return _dbPath; }
-
     /**
      * @brief Sprawdza czy włączone jest szczegółowe logowanie
      * @return Czy włączone jest szczegółowe logowanie
      */
-    bool isVerboseLogging() const { return _settings.value("logging/verbose", false).toBool() || _verbose; }
+    bool isVerboseLogging() const { return _settings.value("logging/verbose", false).toBool(); }
 
     /**
      * @brief Sprawdza czy ustawienia zostały zainicjalizowane
@@ -108,8 +77,7 @@ public:
     bool isInitialized() const { return _initialized; }
 
 private:
-    AppSettings() : _settings("DeskPP", "Application"), _initialized(false), _port(8080),
-                    _dbPath("deskpp.sqlite"), _verbose(false) {
+    AppSettings() : _settings("DeskPP", "Application"), _initialized(false) {
     }
 
     AppSettings(const AppSettings &) = delete;
@@ -118,9 +86,6 @@ private:
 
     QSettings _settings;
     bool _initialized;
-    int _port;
-    std::string _dbPath;
-    bool _verbose;
 };
 
 #endif
@@ -1,20 +1,278 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+
+/**
+ * @brief Zachowanie logowania asynchronicznego przy pełnej kolejce
+ */
+enum class LogOverflowPolicy {
+    Block,  ///< Wątek logujący czeka na miejsce w kolejce
+    Drop,   ///< Najstarszy komunikat w kolejce jest odrzucany
+    Sample  ///< Przy zapełnionej kolejce przechodzi co N-ty komunikat poniżej poziomu warn
+};
+
+/**
+ * @brief Opcje loggera
+ */
+struct LogOptions {
+    bool verbose = false;
+    bool console = true;      ///< Ujście konsoli
+    bool useStderr = false;   ///< Konsola na standardowym wyjściu błędów (gdy stdout przenosi dane)
+    bool async = false;       ///< Zapis przez kolejkę i wątek w tle
+    size_t queueSize = 8192;  ///< Pojemność kolejki (alokowana z góry)
+    LogOverflowPolicy overflow = LogOverflowPolicy::Block;
+    std::string filePath;     ///< Plik z rotacją (pusty - bez pliku)
+    size_t maxFileSize = 10 * 1024 * 1024;
+    size_t maxFiles = 5;
+};
+
+/**
+ * @brief Parsuje nazwę zachowania przy pełnej kolejce
+ * @param name "block", "drop" lub "sample"
+ * @return Zachowanie (domyślnie Block)
+ */
+inline LogOverflowPolicy parseLogOverflowPolicy(const std::string &name) {
+    if (name == "drop") {
+        return LogOverflowPolicy::Drop;
+    }
+    if (name == "sample") {
+        return LogOverflowPolicy::Sample;
+    }
+    return LogOverflowPolicy::Block;
+}
+
+namespace logging {
+    /**
+     * @brief Stan logowania asynchronicznego współdzielony przez loggery
+     */
+    struct State {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<spdlog::details::thread_pool>> pools;
+        std::atomic<size_t> sampledOut{0};
+    };
+
+    inline State &state() {
+        static State state;
+        return state;
+    }
+
+    /**
+     * @class SamplingLogger
+     * @brief Logger przekazujący komunikaty do loggera asynchronicznego, który
+     *        przy zapełnionej kolejce przepuszcza tylko co N-ty komunikat
+     *        poniżej poziomu warn.
+     *
+     * Ostrzeżenia i błędy zawsze trafiają do kolejki (w razie potrzeby
+     * czekając na miejsce), więc nie giną nawet przy dużym obciążeniu.
+     */
+    class SamplingLogger : public spdlog::logger {
+    public:
+        SamplingLogger(std::string name, std::shared_ptr<spdlog::async_logger> target,
+                       std::weak_ptr<spdlog::details::thread_pool> pool, size_t queueSize)
+            : spdlog::logger(std::move(name)), _target(std::move(target)), _pool(std::move(pool)),
+              _threshold(queueSize - queueSize / 4) {
+        }
+
+        static constexpr size_t SampleEvery = 16;
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg &msg) override {
+            if (msg.level < spdlog::level::warn) {
+                auto pool = _pool.lock();
+                if (pool && pool->queue_size() >= _threshold &&
+                    _sampled.fetch_add(1, std::memory_order_relaxed) % SampleEvery != 0) {
+                    state().sampledOut.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            _target->log(msg.time, msg.source, msg.level, msg.payload);
+        }
+
+        void flush_() override { _target->flush(); }
+
+    private:
+        std::shared_ptr<spdlog::async_logger> _target;
+        std::weak_ptr<spdlog::details::thread_pool> _pool;
+        size_t _threshold;
+        std::atomic<size_t> _sampled{0};
+    };
+
+    /**
+     * @brief Pola komunikatu formatowane jako " klucz=wartość"
+     */
+    template<typename... Args>
+    struct Fields {
+        std::tuple<const Args &...> values;
+    };
+}
+
+/**
+ * @brief Tworzy pola strukturalne komunikatu (pary klucz, wartość)
+ *
+ * Pola są formatowane dopiero wtedy, gdy komunikat przechodzi filtr poziomu:
+ * LOG_INFO("Dodano rezerwację{}", logFields("deskId", deskId, "userId", userId))
+ * daje "Dodano rezerwację deskId=5 userId=3". Teksty ze spacjami są ujmowane
+ * w cudzysłów.
+ *
+ * @param args Naprzemiennie klucze i wartości
+ * @return Pola do przekazania jako argument formatowania
+ */
+template<typename... Args>
+logging::Fields<Args...> logFields(const Args &... args) {
+    static_assert(sizeof...(Args) % 2 == 0, "logFields wymaga par klucz, wartość");
+    return {std::tie(args...)};
+}
+
+template<typename... Args>
+struct fmt::formatter<logging::Fields<Args...>> {
+    constexpr auto parse(format_parse_context &ctx) { return ctx.begin(); }
+
+    template<typename FormatContext>
+    auto format(const logging::Fields<Args...> &fields, FormatContext &ctx) const {
+        auto out = ctx.out();
+        std::apply([&](const auto &... values) { out = formatPairs(out, values...); }, fields.values);
+        return out;
+    }
+
+private:
+    template<typename Out>
+    static Out formatPairs(Out out) { return out; }
+
+    template<typename Out, typename Key, typename Value, typename... Rest>
+    static Out formatPairs(Out out, const Key &key, const Value &value, const Rest &... rest) {
+        out = fmt::format_to(out, " {}=", key);
+        if constexpr (std::is_convertible_v<const Value &, std::string_view>) {
+            std::string_view text = value;
+            if (text.empty() || text.find_first_of(" \"=") != std::string_view::npos) {
+                out = fmt::format_to(out, "\"{}\"", text);
+            } else {
+                out = fmt::format_to(out, "{}", text);
+            }
+        } else {
+            out = fmt::format_to(out, "{}", value);
+        }
+        return formatPairs(out, rest...);
+    }
+};
+
+/**
+ * @brief Tworzy logger z ujściem konsoli i (lub) plikiem z rotacją
+ *
+ * W trybie asynchronicznym komunikat jest formatowany w wątku wywołującym
+ * i trafia do kolejki o stałej pojemności, a zapis (konsola, plik) wykonuje
+ * wątek w tle.
+ *
+ * @param appName Nazwa aplikacji
+ * @param options Opcje loggera
+ * @return Logger
+ */
+inline std::shared_ptr<spdlog::logger> makeLogger(const std::string &appName, const LogOptions &options) {
+    std::vector<spdlog::sink_ptr> sinks;
+    if (options.console && options.useStderr) {
+        sinks.push_back(std::make_shared<spdlog::sinks::stderr_color_sink_mt>());
+    } else if (options.console) {
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    }
+    if (!options.filePath.empty()) {
+        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+            options.filePath, options.maxFileSize, options.maxFiles));
+    }
+    for (auto &sink: sinks) {
+        sink->set_formatter(std::make_unique<spdlog::pattern_formatter>("[%H:%M:%S %z] [%^%l%$] %v",
+                                                                        spdlog::pattern_time_type::utc));
+    }
+
+    std::shared_ptr<spdlog::logger> logger;
+    if (options.async) {
+        // Pula żyje do końca programu, bo komunikaty w kolejce wskazują na logger
+        auto pool = std::make_shared<spdlog::details::thread_pool>(options.queueSize, 1);
+        {
+            auto &state = logging::state();
+            std::lock_guard lock(state.mutex);
+            state.pools.push_back(pool);
+        }
+
+        auto policy = options.overflow == LogOverflowPolicy::Drop
+                          ? spdlog::async_overflow_policy::overrun_oldest
+                          : spdlog::async_overflow_policy::block;
+        auto asyncLogger = std::make_shared<spdlog::async_logger>(appName, sinks.begin(), sinks.end(), pool, policy);
+        if (options.overflow == LogOverflowPolicy::Sample) {
+            // Poziom i opróżnianie są ustawiane w loggerze zewnętrznym
+            asyncLogger->set_level(spdlog::level::trace);
+            logger = std::make_shared<logging::SamplingLogger>(appName, asyncLogger, pool, options.queueSize);
+        } else {
+            logger = asyncLogger;
+        }
+    } else {
+        logger = std::make_shared<spdlog::logger>(appName, sinks.begin(), sinks.end());
+    }
+
+    logger->set_level(options.verbose ? spdlog::level::debug : spdlog::level::info);
+    logger->flush_on(spdlog::level::warn);
+    return logger;
+}
+
+/**
+ * @brief Inicjalizuje logger
+ * @param appName Nazwa aplikacji
+ * @param options Opcje loggera
+ */
+inline void initLogger(const std::string &appName, const LogOptions &options) {
+    spdlog::set_default_logger(makeLogger(appName, options));
+    if (options.async || !options.filePath.empty()) {
+        spdlog::flush_every(std::chrono::seconds(1));
+    }
+}
 
 /**
  * @brief Inicjalizuje logger
  * @param appName Nazwa aplikacji
  * @param verbose Czy włączyć szczegółowe logowanie
+ * @param useStderr Czy pisać na standardowe wyjście błędów (gdy stdout przenosi dane)
+ */
+inline void initLogger(const std::string &appName, bool verbose = false, bool useStderr = false) {
+    LogOptions options;
+    options.verbose = verbose;
+    options.useStderr = useStderr;
+    initLogger(appName, options);
+}
+
+/**
+ * @brief Zapisuje komunikaty oczekujące w kolejkach i zatrzymuje wątki loggerów
+ */
+inline void shutdownLogger() {
+    spdlog::shutdown();
+    auto &state = logging::state();
+    std::lock_guard lock(state.mutex);
+    state.pools.clear();
+}
+
+/**
+ * @brief Zwraca liczbę komunikatów odrzuconych przy pełnej kolejce
+ * @return Liczba odrzuconych komunikatów (Drop i Sample)
  */
-inline void initLogger(const std::string &appName, bool verbose = false) {
-    auto console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    auto logger = std::make_shared<spdlog::logger>(appName, console);
-    logger->set_level(verbose ? spdlog::level::debug : spdlog::level::info);
-    logger->set_pattern("[%H:%M:%S %z] [%^%l%$] %v", spdlog::pattern_time_type::utc);
-    spdlog::set_default_logger(logger);
+inline size_t droppedLogMessages() {
+    auto &state = logging::state();
+    std::lock_guard lock(state.mutex);
+    size_t dropped = state.sampledOut.load(std::memory_order_relaxed);
+    for (const auto &pool: state.pools) {
+        dropped += pool->overrun_counter();
+    }
+    return dropped;
 }
 
 #define LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
@@ -1,32 +1,29 @@
 #include "booking.h"
 
-Booking::Booking(int id, int deskId, int userId, const QDate &dateFrom, const QDate &dateTo)
+Booking::Booking(int id, int deskId, int userId, Date dateFrom, Date dateTo)
     : Entity(id), _deskId(deskId), _userId(userId), _dateFrom(dateFrom), _dateTo(dateTo) {
 }
 
-Booking::Booking(int id, int deskId, int userId, const std::string &dateFrom, const std::string &dateTo)
+Booking::Booking(int id, int deskId, int userId, std::string_view dateFrom, std::string_view dateTo)
     : Entity(id), _deskId(deskId), _userId(userId) {
     setDateFrom(dateFrom);
     setDateTo(dateTo);
 }
 
-bool Booking::containsDate(const QDate &date) const {
+bool Booking::containsDate(Date date) const {
     return date >= _dateFrom && date <= _dateTo;
 }
 
-bool Booking::containsDate(const std::string &date) const {
-    return containsDate(QDate::fromString(QString::fromStdString(date), "yyyy-MM-dd"));
+bool Booking::containsDate(std::string_view date) const {
+    return containsDate(Date::fromString(date));
 }
 
-bool Booking::overlapsWithPeriod(const QDate &dateFrom, const QDate &dateTo) const {
+bool Booking::overlapsWithPeriod(Date dateFrom, Date dateTo) const {
     return !(dateTo < _dateFrom || dateFrom > _dateTo);
 }
 
-bool Booking::overlapsWithPeriod(const std::string &dateFrom, const std::string &dateTo) const {
-    return overlapsWithPeriod(
-        QDate::fromString(QString::fromStdString(dateFrom), "yyyy-MM-dd"),
-        QDate::fromString(QString::fromStdString(dateTo), "yyyy-MM-dd")
-    );
+bool Booking::overlapsWithPeriod(std::string_view dateFrom, std::string_view dateTo) const {
+    return overlapsWithPeriod(Date::fromString(dateFrom), Date::fromString(dateTo));
 }
 
 Booking Booking::fromJson(const json &j) {
@@ -60,13 +57,7 @@ Booking Booking::fromJson(const json &j) {
 }
 
 json Booking::toJson() const {
-    return {
-        {"id", getId()},
-        {"deskId", _deskId},
-        {"userId", _userId},
-        {"dateFrom", getDateFromString()},
-        {"dateTo", getDateToString()}
-    };
+    return toJsonAs<json>();
 }
 
 std::string Booking::toString() const {
@@ -74,10 +65,10 @@ std::string Booking::toString() const {
            ", from " + getDateFromString() + " to " + getDateToString() + ")";
 }
 
-void Booking::setDateFrom(const std::string &dateFrom) {
-    _dateFrom = QDate::fromString(QString::fromStdString(dateFrom), "yyyy-MM-dd");
+void Booking::setDateFrom(std::string_view dateFrom) {
+    _dateFrom = Date::fromString(dateFrom);
 }
 
-void Booking::setDateTo(const std::string &dateTo) {
-    _dateTo = QDate::fromString(QString::fromStdString(dateTo), "yyyy-MM-dd");
+void Booking::setDateTo(std::string_view dateTo) {
+    _dateTo = Date::fromString(dateTo);
 }
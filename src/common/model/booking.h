@@ -2,7 +2,8 @@
 #define BOOKING_H
 
 #include "entity.h"
-#include <QDate>
+#include "date.h"
+#include <string_view>
 
 /**
  * @class Booking
@@ -26,7 +27,7 @@ public:
      * @param dateFrom Data początkowa
      * @param dateTo Data końcowa
      */
-    Booking(int id, int deskId, int userId, const QDate &dateFrom, const QDate &dateTo);
+    Booking(int id, int deskId, int userId, Date dateFrom, Date dateTo);
 
     /**
      * @brief Konstruktor z parametrami (wersja tekstowa dat)
@@ -36,33 +37,43 @@ public:
      * @param dateFrom Data początkowa (format: yyyy-MM-dd)
      * @param dateTo Data końcowa (format: yyyy-MM-dd)
      */
-    Booking(int id, int deskId, int userId, const std::string &dateFrom, const std::string &dateTo);
+    Booking(int id, int deskId, int userId, std::string_view dateFrom, std::string_view dateTo);
 
     /**
      * @brief Konwertuje obiekt na format JSON
      * @return Reprezentacja JSON obiektu
      */
-    json toJson() const override;
+    json toJson() const;
+
+    /**
+     * @brief Konwertuje obiekt na dokument JSON wskazanego typu
+     * @tparam BasicJson Specjalizacja nlohmann::basic_json (np. z innym alokatorem)
+     * @return Reprezentacja JSON obiektu
+     */
+    template<typename BasicJson>
+    BasicJson toJsonAs() const {
+        return entityToJson<BasicJson>(*this);
+    }
 
     /**
      * @brief Konwertuje obiekt na string
      * @return Tekstowa reprezentacja obiektu
      */
-    std::string toString() const override;
+    std::string toString() const;
 
     /**
      * @brief Sprawdza czy rezerwacja zawiera określoną datę
      * @param date Data do sprawdzenia
      * @return Czy data mieści się w okresie rezerwacji
      */
-    bool containsDate(const QDate &date) const;
+    bool containsDate(Date date) const;
 
     /**
      * @brief Sprawdza czy rezerwacja zawiera określoną datę (wersja tekstowa)
      * @param date Data do sprawdzenia (format: yyyy-MM-dd)
      * @return Czy data mieści się w okresie rezerwacji
      */
-    bool containsDate(const std::string &date) const;
+    bool containsDate(std::string_view date) const;
 
     /**
      * @brief Sprawdza czy rezerwacja nakłada się z określonym okresem
@@ -70,7 +81,7 @@ public:
      * @param dateTo Data końcowa okresu
      * @return Czy okresy się nakładają
      */
-    bool overlapsWithPeriod(const QDate &dateFrom, const QDate &dateTo) const;
+    bool overlapsWithPeriod(Date dateFrom, Date dateTo) const;
 
     /**
      * @brief Sprawdza czy rezerwacja nakłada się z określonym okresem (wersja tekstowa)
@@ -78,7 +89,7 @@ public:
      * @param dateTo Data końcowa okresu (format: yyyy-MM-dd)
      * @return Czy okresy się nakładają
      */
-    bool overlapsWithPeriod(const std::string &dateFrom, const std::string &dateTo) const;
+    bool overlapsWithPeriod(std::string_view dateFrom, std::string_view dateTo) const;
 
     /**
      * @brief Tworzy obiekt rezerwacji z danych JSON
@@ -103,25 +114,25 @@ public:
      * @brief Pobiera datę początkową
      * @return Data początkowa
      */
-    QDate getDateFrom() const { return _dateFrom; }
+    Date getDateFrom() const { return _dateFrom; }
 
     /**
      * @brief Pobiera datę końcową
      * @return Data końcowa
      */
-    QDate getDateTo() const { return _dateTo; }
+    Date getDateTo() const { return _dateTo; }
 
     /**
      * @brief Pobiera datę początkową jako tekst
      * @return Data początkowa w formacie yyyy-MM-dd
      */
-    std::string getDateFromString() const { return _dateFrom.toString("yyyy-MM-dd").toStdString(); }
+    std::string getDateFromString() const { return _dateFrom.toString(); }
 
     /**
      * @brief Pobiera datę końcową jako tekst
      * @return Data końcowa w formacie yyyy-MM-dd
      */
-    std::string getDateToString() const { return _dateTo.toString("yyyy-MM-dd").toStdString(); }
+    std::string getDateToString() const { return _dateTo.toString(); }
 
     /**
      * @brief Ustawia identyfikator biurka
@@ -139,28 +150,46 @@ public:
      * @brief Ustawia datę początkową
      * @param dateFrom Nowa data początkowa
      */
-    void setDateFrom(const QDate &dateFrom) { _dateFrom = dateFrom; }
+    void setDateFrom(Date dateFrom) { _dateFrom = dateFrom; }
 
     /**
      * @brief Ustawia datę końcową
      * @param dateTo Nowa data końcowa
      */
-    void setDateTo(const QDate &dateTo) { _dateTo = dateTo; }
+    void setDateTo(Date dateTo) { _dateTo = dateTo; }
 
     /**
      * @brief Ustawia datę początkową (wersja tekstowa)
      * @param dateFrom Nowa data początkowa (format: yyyy-MM-dd)
      */
-    void setDateFrom(const std::string &dateFrom);
+    void setDateFrom(std::string_view dateFrom);
 
     /**
      * @brief Ustawia datę końcową (wersja tekstowa)
      * @param dateTo Nowa data końcowa (format: yyyy-MM-dd)
      */
-    void setDateTo(const std::string &dateTo);
+    void setDateTo(std::string_view dateTo);
 
 private:
+    friend struct EntityTraits<Booking>;
+
     int _deskId = 0, _userId = 0;
-    QDate _dateFrom, _dateTo;
+    Date _dateFrom, _dateTo;
+};
+
+/**
+ * @brief Opis rezerwacji (tabela bookings)
+ */
+template<>
+struct EntityTraits<Booking> {
+    static constexpr std::string_view table = "bookings";
+    static constexpr std::string_view orderBy = "date";
+    static constexpr auto fields = std::make_tuple(
+        EntityField<&Booking::_id>{"id", "id"},
+        EntityField<&Booking::_deskId>{"desk_id", "deskId"},
+        EntityField<&Booking::_userId>{"user_id", "userId"},
+        EntityField<&Booking::_dateFrom>{"date", "dateFrom"},
+        EntityField<&Booking::_dateTo>{"date_to", "dateTo"}
+    );
 };
 #endif
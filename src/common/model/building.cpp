@@ -5,13 +5,8 @@ Building::Building(int id, const std::string &name, const std::string &address,
 }
 
 json Building::toJson() const {
-    json j = {
-        {"id", getId()},
-        {"name", _name},
-        {"address", _address},
-        {"numFloors", _numFloors},
-        {"floors", getFloors()}
-    };
+    json j = entityToJson<json>(*this);
+    j["floors"] = getFloors();
     return j;
 }
 
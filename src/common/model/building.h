@@ -30,13 +30,13 @@ public:
      * @brief Konwertuje obiekt na format JSON
      * @return Reprezentacja JSON obiektu
      */
-    json toJson() const override;
+    json toJson() const;
 
     /**
      * @brief Konwertuje obiekt na string
      * @return Tekstowa reprezentacja obiektu
      */
-    std::string toString() const override;
+    std::string toString() const;
 
     /**
      * @brief Pobiera nazwę budynku
@@ -81,8 +81,25 @@ public:
     void setNumFloors(int numFloors) { _numFloors = numFloors; }
 
 private:
+    friend struct EntityTraits<Building>;
+
     std::string _name;
     std::string _address;
     int _numFloors = 1;
 };
+
+/**
+ * @brief Opis budynku (tabela buildings; lista pięter jest wyliczana)
+ */
+template<>
+struct EntityTraits<Building> {
+    static constexpr std::string_view table = "buildings";
+    static constexpr std::string_view orderBy = "name";
+    static constexpr auto fields = std::make_tuple(
+        EntityField<&Building::_id>{"id", "id"},
+        EntityField<&Building::_name>{"name", "name"},
+        EntityField<&Building::_address>{"address", "address"},
+        EntityField<&Building::_numFloors>{"num_floors", "numFloors"}
+    );
+};
 #endif
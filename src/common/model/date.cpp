@@ -0,0 +1,36 @@
+#include "date.h"
+#include <ctime>
+
+Date Date::currentDate() {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+    return Date(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+size_t Date::parseColumn(std::span<const std::string_view> texts, Date *dates) {
+    size_t invalid = 0;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        dates[i] = fromString(texts[i]);
+        invalid += !dates[i].isValid();
+    }
+    return invalid;
+}
+
+size_t Date::parseColumn(const char *text, size_t count, Date *dates) {
+    size_t invalid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        dates[i] = fromString(std::string_view(text + i * TextLength, TextLength));
+        invalid += !dates[i].isValid();
+    }
+    return invalid;
+}
+
+void Date::formatColumn(std::span<const Date> dates, char *buffer) {
+    for (Date date: dates) {
+        if (!date.format(buffer)) {
+            std::memset(buffer, ' ', TextLength);
+        }
+        buffer += TextLength;
+    }
+}
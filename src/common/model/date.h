@@ -0,0 +1,340 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class Date
+ * @brief Data kalendarzowa zapisana jako numer dnia od 1970-01-01.
+ *
+ * Typ zajmuje 4 bajty, jest trywialnie kopiowalny, a arytmetyka,
+ * porównania oraz odczyt i zapis formatu yyyy-MM-dd nie przydzielają
+ * pamięci. Data niepoprawna (np. z błędnego tekstu) jest mniejsza od
+ * wszystkich poprawnych dat.
+ *
+ * Poza wyznaczaniem w czasie kompilacji tekst daty jest przetwarzany jako
+ * słowo 64-bitowe (SWAR): sprawdzenie ośmiu cyfr i zamiana par cyfr na
+ * liczby odbywa się kilkoma operacjami na całym słowie zamiast pętli po
+ * znakach. Warianty kolumnowe (parseColumn, formatColumn) są pętlami po
+ * tej samej ścieżce dla pojedynczej daty, bez osobnego przetwarzania wielu
+ * dat naraz.
+ */
+class Date {
+public:
+    /**
+     * @brief Konstruktor domyślny (data niepoprawna)
+     */
+    constexpr Date() = default;
+
+    /**
+     * @brief Konstruktor z roku, miesiąca i dnia
+     * @param year Rok (0-9999)
+     * @param month Miesiąc (1-12)
+     * @param day Dzień miesiąca
+     */
+    constexpr Date(int year, int month, int day)
+        : _days(isValidDate(year, month, day) ? daysFromCivil(year, month, day) : InvalidDays) {
+    }
+
+    /**
+     * @brief Tworzy datę z numeru dnia
+     * @param days Liczba dni od 1970-01-01
+     * @return Data
+     */
+    static constexpr Date fromDays(int32_t days) {
+        Date date;
+        date._days = days;
+        return date;
+    }
+
+    /**
+     * @brief Tworzy datę z numeru dnia juliańskiego (jak QDate::toJulianDay)
+     * @param julianDay Numer dnia juliańskiego
+     * @return Data
+     */
+    static constexpr Date fromJulianDay(int64_t julianDay) {
+        return fromDays(static_cast<int32_t>(julianDay - JulianDayOfEpoch));
+    }
+
+    /**
+     * @brief Odczytuje datę w formacie yyyy-MM-dd
+     * @param text Tekst daty
+     * @return Data (niepoprawna, jeśli tekst nie jest poprawną datą)
+     */
+    static constexpr Date fromString(std::string_view text) {
+        if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+            return parseScalar(text);
+        }
+        return parseWord(text);
+    }
+
+    /**
+     * @brief Odczytuje kolumnę dat w formacie yyyy-MM-dd
+     * @param texts Teksty dat
+     * @param dates Wyniki (co najmniej texts.size() elementów)
+     * @return Liczba niepoprawnych dat
+     */
+    static size_t parseColumn(std::span<const std::string_view> texts, Date *dates);
+
+    /**
+     * @brief Odczytuje kolumnę dat zapisanych jedna po drugiej bez separatorów
+     * @param text Teksty dat po TextLength znaków (np. wynik formatColumn)
+     * @param count Liczba dat
+     * @param dates Wyniki (co najmniej count elementów)
+     * @return Liczba niepoprawnych dat
+     */
+    static size_t parseColumn(const char *text, size_t count, Date *dates);
+
+    /**
+     * @brief Zapisuje kolumnę dat jedna po drugiej bez separatorów
+     *
+     * Niepoprawne daty są zapisywane jako TextLength spacji.
+     *
+     * @param dates Daty
+     * @param buffer Bufor na co najmniej dates.size() * TextLength znaków
+     */
+    static void formatColumn(std::span<const Date> dates, char *buffer);
+
+    /**
+     * @brief Zwraca bieżącą datę według czasu lokalnego
+     * @return Dzisiejsza data
+     */
+    static Date currentDate();
+
+    /**
+     * @brief Sprawdza czy data jest poprawna
+     * @return Czy data jest poprawna
+     */
+    constexpr bool isValid() const { return _days != InvalidDays; }
+
+    /**
+     * @brief Zwraca numer dnia
+     * @return Liczba dni od 1970-01-01
+     */
+    constexpr int32_t toDays() const { return _days; }
+
+    /**
+     * @brief Zwraca numer dnia juliańskiego (jak QDate::toJulianDay)
+     * @return Numer dnia juliańskiego
+     */
+    constexpr int64_t toJulianDay() const { return static_cast<int64_t>(_days) + JulianDayOfEpoch; }
+
+    /**
+     * @brief Pobiera rok
+     * @return Rok
+     */
+    constexpr int year() const { return civil().year; }
+
+    /**
+     * @brief Pobiera miesiąc
+     * @return Miesiąc (1-12)
+     */
+    constexpr int month() const { return civil().month; }
+
+    /**
+     * @brief Pobiera dzień miesiąca
+     * @return Dzień miesiąca
+     */
+    constexpr int day() const { return civil().day; }
+
+    /**
+     * @brief Pobiera dzień tygodnia
+     * @return Dzień tygodnia (1 - poniedziałek, 7 - niedziela)
+     */
+    constexpr int dayOfWeek() const {
+        // 1970-01-01 był czwartkiem
+        return (_days % 7 + 10) % 7 + 1;
+    }
+
+    /**
+     * @brief Zwraca datę przesuniętą o podaną liczbę dni
+     * @param days Liczba dni (ujemna - wstecz)
+     * @return Nowa data (niepoprawna dla niepoprawnej daty)
+     */
+    constexpr Date addDays(int days) const { return isValid() ? fromDays(_days + days) : Date(); }
+
+    /**
+     * @brief Zwraca liczbę dni do podanej daty
+     * @param other Data docelowa
+     * @return Liczba dni (ujemna, jeśli data docelowa jest wcześniejsza)
+     */
+    constexpr int daysTo(Date other) const { return other._days - _days; }
+
+    /**
+     * @brief Zapisuje datę w formacie yyyy-MM-dd do bufora
+     * @param buffer Bufor na co najmniej TextLength znaków (bez kończącego zera)
+     * @return Czy data była poprawna (dla niepoprawnej bufor nie jest zmieniany)
+     */
+    constexpr bool format(char *buffer) const {
+        if (!isValid()) {
+            return false;
+        }
+        auto [y, m, d] = civil();
+        if (y < 0 || y > 9999) {
+            return false;
+        }
+        if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+            formatScalar(buffer, y, m, d);
+        } else {
+            formatWord(buffer, y, m, d);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Zwraca datę w formacie yyyy-MM-dd
+     *
+     * Tekst mieści się w buforze wewnętrznym std::string, więc nie jest
+     * przydzielana pamięć.
+     *
+     * @return Tekst daty (pusty dla niepoprawnej daty)
+     */
+    std::string toString() const {
+        char buffer[TextLength];
+        return format(buffer) ? std::string(buffer, TextLength) : std::string();
+    }
+
+    constexpr auto operator<=>(const Date &) const = default;
+
+    static constexpr size_t TextLength = 10;
+
+private:
+    struct Civil {
+        int year;
+        int month;
+        int day;
+    };
+
+    static constexpr int32_t InvalidDays = std::numeric_limits<int32_t>::min();
+    static constexpr int64_t JulianDayOfEpoch = 2440588;
+
+    static constexpr bool isLeapYear(int year) {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    static constexpr int daysInMonth(int year, int month) {
+        constexpr int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+    }
+
+    static constexpr bool isValidDate(int year, int month, int day) {
+        return year >= 0 && year <= 9999 && month >= 1 && month <= 12 && day >= 1 &&
+               day <= daysInMonth(year, month);
+    }
+
+    // Przeliczenia kalendarza gregoriańskiego w erach 400-letnich (H. Hinnant, "chrono-Compatible
+    // Low-Level Date Algorithms"); rok zaczyna się w marcu, więc dzień przestępny jest ostatni
+    static constexpr int32_t daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yearOfEra = year - era * 400;
+        const int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    static constexpr Date parseScalar(std::string_view text) {
+        if (text.size() != TextLength || text[4] != '-' || text[7] != '-') {
+            return {};
+        }
+
+        int fields[3] = {0, 0, 0};
+        int field = 0;
+        for (size_t i = 0; i < TextLength; ++i) {
+            if (i == 4 || i == 7) {
+                ++field;
+                continue;
+            }
+            if (text[i] < '0' || text[i] > '9') {
+                return {};
+            }
+            fields[field] = fields[field] * 10 + (text[i] - '0');
+        }
+        return Date(fields[0], fields[1], fields[2]);
+    }
+
+    // Bajty słowa są w kolejności znaków (little-endian): "yyyy-MM-" w nagłówku, "dd" w ogonie
+    static Date parseWord(std::string_view text) {
+        if (text.size() != TextLength) {
+            return {};
+        }
+        uint64_t head;
+        uint16_t tail;
+        std::memcpy(&head, text.data(), sizeof(head));
+        std::memcpy(&tail, text.data() + sizeof(head), sizeof(tail));
+        if ((head & 0xFF0000FF00000000) != 0x2D00002D00000000) {
+            return {};
+        }
+
+        // Osiem cyfr "yyyyMMdd" bez myślników
+        uint64_t digits = (head & 0xFFFFFFFF) | ((head >> 8) & 0xFFFF00000000) | (static_cast<uint64_t>(tail) << 48);
+        // Każdy bajt ma postać 0x3X, a X + 6 nie przekracza 0xF
+        uint64_t high = digits & 0xF0F0F0F0F0F0F0F0;
+        uint64_t carry = ((digits + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4;
+        if ((high | carry) != 0x3333333333333333) {
+            return {};
+        }
+
+        // Pary cyfr jako liczby w bajtach 0, 2, 4 i 6: setki lat, lata, miesiąc, dzień
+        uint64_t pairs = ((digits & 0x0F0F0F0F0F0F0F0F) * (10 * 256 + 1)) >> 8;
+        int year = static_cast<int>(pairs & 0xFF) * 100 + static_cast<int>((pairs >> 16) & 0xFF);
+        return Date(year, static_cast<int>((pairs >> 32) & 0xFF), static_cast<int>((pairs >> 48) & 0xFF));
+    }
+
+    static constexpr void formatScalar(char *buffer, int year, int month, int day) {
+        buffer[0] = static_cast<char>('0' + year / 1000);
+        buffer[1] = static_cast<char>('0' + year / 100 % 10);
+        buffer[2] = static_cast<char>('0' + year / 10 % 10);
+        buffer[3] = static_cast<char>('0' + year % 10);
+        buffer[4] = '-';
+        buffer[5] = static_cast<char>('0' + month / 10);
+        buffer[6] = static_cast<char>('0' + month % 10);
+        buffer[7] = '-';
+        buffer[8] = static_cast<char>('0' + day / 10);
+        buffer[9] = static_cast<char>('0' + day % 10);
+    }
+
+    static void formatWord(char *buffer, int year, int month, int day) {
+        // Liczby 0-99 w 16-bitowych polach; v * 103 >> 10 to v / 10 dla v < 179
+        uint64_t lanes = static_cast<uint64_t>(year / 100) | static_cast<uint64_t>(year % 100) << 16 |
+                         static_cast<uint64_t>(month) << 32 | static_cast<uint64_t>(day) << 48;
+        uint64_t tens = ((lanes * 103) >> 10) & 0x000F000F000F000F;
+        uint64_t digits = (tens | (lanes - tens * 10) << 8) | 0x3030303030303030;
+
+        uint64_t head = (digits & 0xFFFFFFFF) | (digits & 0xFFFF00000000) << 8 | 0x2D00002D00000000;
+        uint16_t tail = static_cast<uint16_t>(digits >> 48);
+        std::memcpy(buffer, &head, sizeof(head));
+        std::memcpy(buffer + sizeof(head), &tail, sizeof(tail));
+    }
+
+    constexpr Civil civil() const {
+        const int32_t days = _days + 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const int dayOfEra = days - era * 146097;
+        const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int monthIndex = (5 * dayOfYear + 2) / 153;
+        const int day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        const int month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+        return {yearOfEra + era * 400 + (month <= 2), month, day};
+    }
+
+    int32_t _days = InvalidDays;
+};
+
+static_assert(sizeof(Date) == 4);
+static_assert(Date(1970, 1, 1).toDays() == 0);
+static_assert(Date::fromString("2024-02-29") == Date(2024, 2, 29));
+static_assert(!Date::fromString("2023-02-29").isValid());
+static_assert(Date(2024, 3, 1).addDays(-1).day() == 29);
+
+#endif
@@ -6,48 +6,43 @@ Desk::Desk(int id, const std::string &name, int buildingId, int floor)
 }
 
 json Desk::toJson() const {
-    return {
-        {"id", getId()},
-        {"name", _name},
-        {"buildingId", _buildingId},
-        {"floor", _floor}
-    };
+    return toJsonAs<json>();
 }
 
 std::string Desk::toString() const {
     return "Desk: " + _name + " (ID: " + std::to_string(getId()) + ", Floor: " + std::to_string(_floor) + ")";
 }
 
-bool Desk::isAvailableOn(const QDate &date) const {
+bool Desk::isAvailableOn(Date date) const {
     return !std::any_of(_bookings.begin(), _bookings.end(),
-                        [&date](const Booking &booking) {
+                        [date](const Booking &booking) {
                             return booking.containsDate(date);
                         });
 }
 
-bool Desk::isAvailableForPeriod(const QDate &dateFrom, const QDate &dateTo) const {
+bool Desk::isAvailableForPeriod(Date dateFrom, Date dateTo) const {
     return !hasOverlappingBooking(dateFrom, dateTo);
 }
 
-bool Desk::hasOverlappingBooking(const QDate &dateFrom, const QDate &dateTo) const {
+bool Desk::hasOverlappingBooking(Date dateFrom, Date dateTo) const {
     return std::any_of(_bookings.begin(), _bookings.end(),
                        [&](const Booking &booking) {
                            return booking.overlapsWithPeriod(dateFrom, dateTo);
                        });
 }
 
-Booking Desk::getBookingForDate(const QDate &date) const {
+Booking Desk::getBookingForDate(Date date) const {
     auto it = std::find_if(_bookings.begin(), _bookings.end(),
-                           [&date](const Booking &booking) {
+                           [date](const Booking &booking) {
                                return booking.containsDate(date);
                            });
     return (it != _bookings.end()) ? *it : Booking();
 }
 
-std::vector<Booking> Desk::getBookingsAfterDate(const QDate &date) const {
+std::vector<Booking> Desk::getBookingsAfterDate(Date date) const {
     std::vector<Booking> result;
     std::copy_if(_bookings.begin(), _bookings.end(), std::back_inserter(result),
-                 [&date](const Booking &booking) {
+                 [date](const Booking &booking) {
                      return booking.getDateFrom() >= date;
                  });
     std::sort(result.begin(), result.end(),
@@ -57,16 +52,16 @@ std::vector<Booking> Desk::getBookingsAfterDate(const QDate &date) const {
     return result;
 }
 
-std::vector<Booking> Desk::getBookingsContainingDate(const QDate &date) const {
+std::vector<Booking> Desk::getBookingsContainingDate(Date date) const {
     std::vector<Booking> result;
     std::copy_if(_bookings.begin(), _bookings.end(), std::back_inserter(result),
-                 [&date](const Booking &booking) {
+                 [date](const Booking &booking) {
                      return booking.containsDate(date);
                  });
     return result;
 }
 
-void Desk::addBooking(const QDate &dateFrom, const QDate &dateTo, int bookingId) {
+void Desk::addBooking(Date dateFrom, Date dateTo, int bookingId) {
     Booking booking(bookingId, getId(), 0, dateFrom, dateTo);
     addBooking(booking);
 }
@@ -32,13 +32,23 @@ public:
      * @brief Konwertuje obiekt na format JSON
      * @return Reprezentacja JSON obiektu
      */
-    json toJson() const override;
+    json toJson() const;
+
+    /**
+     * @brief Konwertuje obiekt na dokument JSON wskazanego typu
+     * @tparam BasicJson Specjalizacja nlohmann::basic_json (np. z innym alokatorem)
+     * @return Reprezentacja JSON obiektu
+     */
+    template<typename BasicJson>
+    BasicJson toJsonAs() const {
+        return entityToJson<BasicJson>(*this);
+    }
 
     /**
      * @brief Konwertuje obiekt na string
      * @return Tekstowa reprezentacja obiektu
      */
-    std::string toString() const override;
+    std::string toString() const;
 
     /**
      * @brief Sprawdza czy biurko jest dostępne (nie ma żadnych rezerwacji)
@@ -51,7 +61,7 @@ public:
      * @param date Data do sprawdzenia
      * @return Czy biurko jest dostępne w podanym dniu
      */
-    bool isAvailableOn(const QDate &date) const;
+    bool isAvailableOn(Date date) const;
 
     /**
      * @brief Sprawdza czy biurko jest dostępne w określonym okresie
@@ -59,7 +69,7 @@ public:
      * @param dateTo Data końcowa
      * @return Czy biurko jest dostępne w podanym okresie
      */
-    bool isAvailableForPeriod(const QDate &dateFrom, const QDate &dateTo) const;
+    bool isAvailableForPeriod(Date dateFrom, Date dateTo) const;
 
     /**
      * @brief Sprawdza czy istnieje nakładająca się rezerwacja w określonym okresie
@@ -67,7 +77,7 @@ public:
      * @param dateTo Data końcowa
      * @return Czy istnieje nakładająca się rezerwacja
      */
-    bool hasOverlappingBooking(const QDate &dateFrom, const QDate &dateTo) const;
+    bool hasOverlappingBooking(Date dateFrom, Date dateTo) const;
 
     /**
      * @brief Pobiera wszystkie rezerwacje biurka
@@ -80,21 +90,21 @@ public:
      * @param date Data do sprawdzenia
      * @return Obiekt rezerwacji (pusty, jeśli brak)
      */
-    Booking getBookingForDate(const QDate &date) const;
+    Booking getBookingForDate(Date date) const;
 
     /**
      * @brief Pobiera rezerwacje po określonej dacie
      * @param date Data graniczna
      * @return Wektor rezerwacji posortowany po datach
      */
-    std::vector<Booking> getBookingsAfterDate(const QDate &date) const;
+    std::vector<Booking> getBookingsAfterDate(Date date) const;
 
     /**
      * @brief Pobiera rezerwacje zawierające określoną datę
      * @param date Data do sprawdzenia
      * @return Wektor rezerwacji zawierających datę
      */
-    std::vector<Booking> getBookingsContainingDate(const QDate &date) const;
+    std::vector<Booking> getBookingsContainingDate(Date date) const;
 
     /**
      * @brief Dodaje nową rezerwację na podstawie dat
@@ -102,7 +112,7 @@ public:
      * @param dateTo Data końcowa
      * @param bookingId Identyfikator rezerwacji (opcjonalny)
      */
-    void addBooking(const QDate &dateFrom, const QDate &dateTo, int bookingId = 0);
+    void addBooking(Date dateFrom, Date dateTo, int bookingId = 0);
 
     /**
      * @brief Dodaje istniejącą rezerwację
@@ -168,12 +178,14 @@ public:
      * @param date Data do sprawdzenia
      * @return Czy biurko jest zarezerwowane w podanym dniu
      */
-    bool isBookedOnDate(const QDate &date) const { return !isAvailableOn(date); }
+    bool isBookedOnDate(Date date) const { return !isAvailableOn(date); }
 
 private:
+    friend struct EntityTraits<Desk>;
+
     std::string _name;
-    int _buildingId;
-    int _floor;
+    int _buildingId = 0;
+    int _floor = 1;
     std::vector<Booking> _bookings;
 
     /**
@@ -181,4 +193,19 @@ private:
      */
     void sortBookings();
 };
+
+/**
+ * @brief Opis biurka (tabela desks; rezerwacje biurka nie są jego polami)
+ */
+template<>
+struct EntityTraits<Desk> {
+    static constexpr std::string_view table = "desks";
+    static constexpr std::string_view orderBy = "";
+    static constexpr auto fields = std::make_tuple(
+        EntityField<&Desk::_id>{"id", "id"},
+        EntityField<&Desk::_name>{"name", "name"},
+        EntityField<&Desk::_buildingId>{"building_id", "buildingId"},
+        EntityField<&Desk::_floor>{"floor", "floor"}
+    );
+};
 #endif
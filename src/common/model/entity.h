@@ -1,6 +1,7 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include "entity_traits.h"
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -10,8 +11,9 @@ using json = nlohmann::json;
  * @class Entity
  * @brief Klasa bazowa dla wszystkich encji w systemie.
  *
- * Zapewnia podstawową funkcjonalność dla wszystkich encji taką jak
- * identyfikator oraz metody konwersji do formatu JSON.
+ * Zapewnia identyfikator wspólny dla wszystkich encji. Klasa nie jest
+ * polimorficzna: pola encji, zapis JSON i mapowanie na tabelę opisuje
+ * specjalizacja EntityTraits modelu, a encje nie mają wskaźnika vtable.
  */
 class Entity {
 public:
@@ -28,11 +30,6 @@ public:
     explicit Entity(int id) : _id(id) {
     }
 
-    /**
-     * @brief Wirtualny destruktor
-     */
-    virtual ~Entity() = default;
-
     /**
      * @brief Pobiera identyfikator encji
      * @return Identyfikator encji
@@ -45,19 +42,18 @@ public:
      */
     void setId(int id) { _id = id; }
 
-    /**
-     * @brief Konwertuje obiekt na format JSON
-     * @return Reprezentacja JSON obiektu
-     */
-    virtual json toJson() const = 0;
-
     /**
      * @brief Konwertuje obiekt na string
      * @return Tekstowa reprezentacja obiektu
      */
-    virtual std::string toString() const { return "Entity ID: " + std::to_string(_id); }
+    std::string toString() const { return "Entity ID: " + std::to_string(_id); }
 
 protected:
+    /**
+     * @brief Destruktor (encje nie są usuwane przez wskaźnik do klasy bazowej)
+     */
+    ~Entity() = default;
+
     int _id;
 };
 
@@ -0,0 +1,138 @@
+#ifndef ENTITY_TRAITS_H
+#define ENTITY_TRAITS_H
+
+#include "date.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Opis encji w czasie kompilacji
+ *
+ * Specjalizacja dla modelu (umieszczona obok jego klasy i zaprzyjaźniona
+ * z nią) zawiera:
+ * - table - nazwę tabeli,
+ * - orderBy - kolumnę porządku listy wszystkich encji (pusta - bez porządku),
+ * - fields - krotkę pól EntityField; pierwszym polem jest identyfikator.
+ *
+ * Opis jest jedynym źródłem nazw kolumn i kluczy encji: generowane są z niego
+ * zapytania SQL, odczyt wierszy, wiązanie parametrów, zapis JSON i eksport.
+ * Pola są odwiedzane rozwinięciem krotki, więc pętle po wierszach nie
+ * zawierają wywołań pośrednich.
+ *
+ * @tparam T Typ encji
+ */
+template<typename T>
+struct EntityTraits;
+
+template<typename>
+struct MemberPointer;
+
+template<typename Class, typename Value>
+struct MemberPointer<Value Class::*> {
+    using ValueType = Value;
+};
+
+/**
+ * @struct EntityField
+ * @brief Pole encji: składowa, kolumna w bazie i klucz JSON.
+ *
+ * @tparam Member Wskaźnik do składowej (typ int, std::string lub Date)
+ */
+template<auto Member>
+struct EntityField {
+    using Value = typename MemberPointer<decltype(Member)>::ValueType;
+
+    std::string_view column;
+    std::string_view key;
+    bool api = true; ///< Czy pole trafia do JSON-a API (hash hasła nie trafia)
+
+    template<typename T>
+    static constexpr const Value &get(const T &entity) { return entity.*Member; }
+
+    template<typename T>
+    static constexpr Value &get(T &entity) { return entity.*Member; }
+};
+
+/**
+ * @brief Zakres pól zapisywanych do JSON
+ */
+enum class EntityFields {
+    Api, ///< Pola odpowiedzi API
+    All  ///< Wszystkie pola (eksport i przenoszenie danych)
+};
+
+/**
+ * @brief Zwraca liczbę pól encji
+ * @tparam T Typ encji
+ * @return Liczba pól (razem z identyfikatorem)
+ */
+template<typename T>
+constexpr size_t entityFieldCount() {
+    return std::tuple_size_v<std::remove_cvref_t<decltype(EntityTraits<T>::fields)>>;
+}
+
+/**
+ * @brief Wywołuje funkcję dla każdego pola encji
+ * @tparam T Typ encji
+ * @param visitor Funkcja przyjmująca opis pola i jego indeks (0 - identyfikator)
+ */
+template<typename T, typename Visitor>
+constexpr void forEachField(Visitor &&visitor) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (visitor(std::get<I>(EntityTraits<T>::fields), I), ...);
+    }(std::make_index_sequence<entityFieldCount<T>()>{});
+}
+
+/**
+ * @brief Pobiera klucze JSON pól encji
+ * @tparam T Typ encji
+ * @param scope Zakres pól
+ * @return Klucze w kolejności pól
+ */
+template<typename T>
+std::vector<std::string> entityKeys(EntityFields scope = EntityFields::Api) {
+    std::vector<std::string> keys;
+    forEachField<T>([&](const auto &field, size_t) {
+        if (field.api || scope == EntityFields::All) {
+            keys.emplace_back(field.key);
+        }
+    });
+    return keys;
+}
+
+/**
+ * @brief Konwertuje encję na dokument JSON wskazanego typu
+ *
+ * Daty są zapisywane w formacie yyyy-MM-dd bez pośredniego std::string.
+ *
+ * @tparam BasicJson Specjalizacja nlohmann::basic_json (np. z innym alokatorem)
+ * @param entity Encja
+ * @param scope Zakres pól
+ * @return Obiekt JSON z polami encji
+ */
+template<typename BasicJson, typename T>
+BasicJson entityToJson(const T &entity, EntityFields scope = EntityFields::Api) {
+    BasicJson result = BasicJson::object();
+    forEachField<T>([&](const auto &field, size_t) {
+        if (!field.api && scope != EntityFields::All) {
+            return;
+        }
+        using Value = typename std::remove_cvref_t<decltype(field)>::Value;
+        auto &slot = result[typename BasicJson::string_t(field.key)];
+        if constexpr (std::is_same_v<Value, Date>) {
+            char text[Date::TextLength];
+            bool valid = field.get(entity).format(text);
+            slot = std::string_view(text, valid ? Date::TextLength : 0);
+        } else {
+            slot = field.get(entity);
+        }
+    });
+    return result;
+}
+
+#endif
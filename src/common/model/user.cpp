@@ -5,11 +5,7 @@ User::User(int id, const std::string &username, const std::string &email)
 }
 
 json User::toJson() const {
-    return {
-        {"id", getId()},
-        {"username", _username},
-        {"email", _email}
-    };
+    return entityToJson<json>(*this);
 }
 
 std::string User::toString() const {
@@ -29,13 +29,13 @@ public:
      * @brief Konwertuje obiekt na format JSON
      * @return Reprezentacja JSON obiektu
      */
-    json toJson() const override;
+    json toJson() const;
 
     /**
      * @brief Konwertuje obiekt na string
      * @return Tekstowa reprezentacja obiektu
      */
-    std::string toString() const override;
+    std::string toString() const;
 
     /**
      * @brief Pobiera nazwę użytkownika
@@ -74,6 +74,23 @@ public:
     void setPasswordHash(const std::string &passwordHash) { _passwordHash = passwordHash; }
 
 private:
+    friend struct EntityTraits<User>;
+
     std::string _username, _email, _passwordHash;
 };
+
+/**
+ * @brief Opis użytkownika (tabela users; hash hasła nie trafia do JSON-a API)
+ */
+template<>
+struct EntityTraits<User> {
+    static constexpr std::string_view table = "users";
+    static constexpr std::string_view orderBy = "username";
+    static constexpr auto fields = std::make_tuple(
+        EntityField<&User::_id>{"id", "id"},
+        EntityField<&User::_username>{"username", "username"},
+        EntityField<&User::_email>{"email", "email"},
+        EntityField<&User::_passwordHash>{"password_hash", "passwordHash", false}
+    );
+};
 #endif
@@ -5,46 +5,59 @@ BookingController::BookingController(BookingService &bookingService)
 }
 
 crow::response BookingController::getBuildings(const crow::request &req) {
+    TRACE_SPAN("BookingController::getBuildings");
     try {
-        json result = _bookingService.getAllBuildings();
+        ArenaJson result = _bookingService.getAllBuildings();
         return successResponse(result);
     } catch (const std::exception &ex) {
         return errorResponse(500, "Błąd serwera");
     }
 }
 
-crow::response BookingController::getDesks(const crow::request &req) {
+void BookingController::getDesks(const crow::request &req, crow::response &res) {
+    respondAsync(res, getDesksTask(req, res));
+}
+
+Task<crow::response> BookingController::getDesksTask(const crow::request &req, crow::response &res) {
+    RequestArena arena;
+    OperationContext context(RequestTimeout, &arena);
+    cancelOnDisconnect(context, res);
+    TRACE_SPAN("BookingController::getDesks");
     try {
-        // Pobierz parametry budynku i piętra
+        // Pobierz parametry budynku i piętra (brak - wszystkie biurka)
         auto buildingIdParam = req.url_params.get("buildingId");
         auto floorParam = req.url_params.get("floor");
 
-        if (buildingIdParam && floorParam) {
-            // Filtruj po budynku i piętrze
-            int buildingId = std::stoi(buildingIdParam);
-            int floor = std::stoi(floorParam);
-            json result = _bookingService.getDesksByBuildingAndFloor(buildingId, floor);
-            return successResponse(result);
-        } else if (buildingIdParam) {
-            // Filtruj tylko po budynku
-            int buildingId = std::stoi(buildingIdParam);
-            json result = _bookingService.getDesksByBuilding(buildingId);
-            return successResponse(result);
-        } else {
-            // Zwróć wszystkie biurka
-            json result = _bookingService.getAllDesks();
-            return successResponse(result);
+        std::optional<int> buildingId, floor;
+        if (buildingIdParam) {
+            buildingId = std::stoi(buildingIdParam);
+            if (floorParam) {
+                floor = std::stoi(floorParam);
+            }
         }
+
+        ArenaJson result = co_await _bookingService.getDesksAsync(buildingId, floor, context);
+        co_return successResponse(result);
+    } catch (const OperationCanceled &ex) {
+        co_return canceledResponse(ex);
     } catch (const std::exception &ex) {
-        return errorResponse(500, "Błąd serwera");
+        co_return errorResponse(500, "Błąd serwera");
     }
 }
 
-crow::response BookingController::getBookings(const crow::request &req) {
+void BookingController::getBookings(const crow::request &req, crow::response &res) {
+    respondAsync(res, getBookingsTask(req, res));
+}
+
+Task<crow::response> BookingController::getBookingsTask(const crow::request &req, crow::response &res) {
+    RequestArena arena;
+    OperationContext context(RequestTimeout, &arena);
+    cancelOnDisconnect(context, res);
+    TRACE_SPAN("BookingController::getBookings");
     try {
         auto deskIdParam = req.url_params.get("deskId");
         if (!deskIdParam) {
-            return errorResponse(400, "Brak parametru deskId");
+            co_return errorResponse(400, "Brak parametru deskId");
         }
         int deskId = std::stoi(deskIdParam);
 
@@ -53,21 +66,32 @@ crow::response BookingController::getBookings(const crow::request &req) {
         auto dateToParam = req.url_params.get("dateTo");
 
         if (!dateFromParam || !dateToParam) {
-            return errorResponse(400, "Brakujące parametry dat");
+            co_return errorResponse(400, "Brakujące parametry dat");
         }
 
-        json result = _bookingService.getBookingsForDesk(deskId, dateFromParam, dateToParam);
-        return successResponse(result);
+        ArenaJson result = co_await _bookingService.getBookingsForDeskAsync(deskId, dateFromParam, dateToParam,
+                                                                            context);
+        co_return successResponse(result);
+    } catch (const OperationCanceled &ex) {
+        co_return canceledResponse(ex);
     } catch (const std::exception &ex) {
-        return errorResponse(500, "Błąd serwera");
+        co_return errorResponse(500, "Błąd serwera");
     }
 }
 
-crow::response BookingController::addBooking(const crow::request &req) {
+void BookingController::addBooking(const crow::request &req, crow::response &res) {
+    respondAsync(res, addBookingTask(req, res));
+}
+
+Task<crow::response> BookingController::addBookingTask(const crow::request &req, crow::response &res) {
+    RequestArena arena;
+    OperationContext context(RequestTimeout, &arena);
+    cancelOnDisconnect(context, res);
+    TRACE_SPAN("BookingController::addBooking");
     try {
         auto params = validateRequest(req, {"deskId", "userId", "dateFrom", "dateTo"});
         if (!params) {
-            return errorResponse(400, "Brakujące wymagane pola");
+            co_return errorResponse(400, "Brakujące wymagane pola");
         }
 
         int deskId = (*params)["deskId"].get<int>();
@@ -75,32 +99,50 @@ crow::response BookingController::addBooking(const crow::request &req) {
         std::string dateFrom = (*params)["dateFrom"].get<std::string>();
         std::string dateTo = (*params)["dateTo"].get<std::string>();
 
-        json result = _bookingService.addBooking(deskId, userId, dateFrom, dateTo);
+        std::string idempotencyKey = req.get_header_value("Idempotency-Key");
+
+        ArenaJson result = co_await _bookingService.addBookingAsync(deskId, userId, dateFrom, dateTo, idempotencyKey,
+                                                                    context);
         if (result.contains("status") && result["status"] == "error") {
-            return errorResponse(400, result["message"]);
+            co_return errorResponse(400, result["message"]);
         }
 
-        return successResponse(result);
+        co_return successResponse(result);
+    } catch (const OperationCanceled &ex) {
+        co_return canceledResponse(ex);
     } catch (const std::exception &ex) {
-        return errorResponse(500, "Błąd serwera: " + std::string(ex.what()));
+        co_return errorResponse(500, "Błąd serwera: " + std::string(ex.what()));
     }
 }
 
-crow::response BookingController::cancelBooking(int bookingId) {
+void BookingController::cancelBooking(const crow::request &req, crow::response &res, int bookingId) {
+    respondAsync(res, cancelBookingTask(req, res, bookingId));
+}
+
+Task<crow::response> BookingController::cancelBookingTask(const crow::request &req, crow::response &res,
+                                                          int bookingId) {
+    RequestArena arena;
+    OperationContext context(RequestTimeout, &arena);
+    cancelOnDisconnect(context, res);
+    TRACE_SPAN("BookingController::cancelBooking");
     try {
-        json result = _bookingService.cancelBooking(bookingId);
+        std::string idempotencyKey = req.get_header_value("Idempotency-Key");
+        ArenaJson result = co_await _bookingService.cancelBookingAsync(bookingId, idempotencyKey, context);
         if (result.contains("status") && result["status"] == "error") {
-            return errorResponse(404, result["message"]);
+            co_return errorResponse(404, result["message"]);
         }
-        return successResponse(result);
+        co_return successResponse(result);
+    } catch (const OperationCanceled &ex) {
+        co_return canceledResponse(ex);
     } catch (const std::exception &ex) {
-        return errorResponse(500, "Błąd serwera");
+        co_return errorResponse(500, "Błąd serwera");
     }
 }
 
 crow::response BookingController::getFloorsByBuilding(int buildingId) {
+    TRACE_SPAN("BookingController::getFloorsByBuilding");
     try {
-        json result = _bookingService.getFloorsByBuilding(buildingId);
+        ArenaJson result = _bookingService.getFloorsByBuilding(buildingId);
         if (result.contains("status") && result["status"] == "error") {
             return errorResponse(404, result["message"]);
         }
@@ -109,3 +151,73 @@ crow::response BookingController::getFloorsByBuilding(int buildingId) {
         return errorResponse(500, "Błąd serwera");
     }
 }
+
+crow::response BookingController::getBootstrap(int userId) {
+    RequestArena arena;
+    ArenaScope arenaScope(&arena);
+    TRACE_SPAN("BookingController::getBootstrap");
+    try {
+        ArenaJson result = _bookingService.getBootstrap(userId);
+        return successResponse(result);
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
+
+crow::response BookingController::reloadCatalog() {
+    try {
+        ArenaJson result = _bookingService.reloadCatalog();
+        crow::response response = successResponse(result);
+        response.code = 202;
+        return response;
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
+
+crow::response BookingController::getDeskLockStats() {
+    try {
+        ArenaJson result = _bookingService.getDeskLockStats();
+        return successResponse(result);
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
+
+void BookingController::getUserBookings(const crow::request &req, crow::response &res, int userId) {
+    respondAsync(res, getUserBookingsTask(req, res, userId));
+}
+
+Task<crow::response> BookingController::getUserBookingsTask(const crow::request &req, crow::response &res,
+                                                            int userId) {
+    RequestArena arena;
+    OperationContext context(RequestTimeout, &arena);
+    cancelOnDisconnect(context, res);
+    TRACE_SPAN("BookingController::getUserBookings");
+    try {
+        auto fromParam = req.url_params.get("from");
+        auto cursorParam = req.url_params.get("cursor");
+        auto limitParam = req.url_params.get("limit");
+
+        int limit = BookingService::DefaultUserBookingsPage;
+        if (limitParam) {
+            try {
+                limit = std::stoi(limitParam);
+            } catch (const std::exception &) {
+                co_return errorResponse(400, "Nieprawidłowy parametr limit");
+            }
+        }
+
+        ArenaJson result = co_await _bookingService.getUserBookingsAsync(userId, fromParam ? fromParam : "",
+                                                                         cursorParam ? cursorParam : "", limit,
+                                                                         context);
+        if (result.contains("status") && result["status"] == "error") {
+            co_return errorResponse(400, result["message"]);
+        }
+        co_return successResponse(result);
+    } catch (const OperationCanceled &ex) {
+        co_return canceledResponse(ex);
+    } catch (const std::exception &ex) {
+        co_return errorResponse(500, "Błąd serwera");
+    }
+}
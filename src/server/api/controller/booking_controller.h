@@ -9,7 +9,9 @@
  * @brief Kontroler do zarządzania rezerwacjami biurek.
  *
  * Obsługuje żądania HTTP związane z budynkami, biurkami i rezerwacjami,
- * przekazując je do odpowiednich serwisów.
+ * przekazując je do odpowiednich serwisów. Odpowiedzi z biurkami
+ * i rezerwacjami są budowane w arenie żądania zwalnianej po jego
+ * zakończeniu.
  */
 class BookingController : public Controller {
 public:
@@ -27,32 +29,33 @@ public:
     crow::response getBuildings(const crow::request &req);
 
     /**
-     * @brief Obsługuje żądanie pobrania biurek
+     * @brief Obsługuje żądanie pobrania biurek (odpowiedź kończona asynchronicznie)
      * @param req Żądanie HTTP
-     * @return Odpowiedź HTTP z listą biurek
+     * @param res Odpowiedź HTTP z listą biurek
      */
-    crow::response getDesks(const crow::request &req);
+    void getDesks(const crow::request &req, crow::response &res);
 
     /**
-     * @brief Obsługuje żądanie pobrania rezerwacji
+     * @brief Obsługuje żądanie pobrania rezerwacji (odpowiedź kończona asynchronicznie)
      * @param req Żądanie HTTP
-     * @return Odpowiedź HTTP z listą rezerwacji
+     * @param res Odpowiedź HTTP z listą rezerwacji
      */
-    crow::response getBookings(const crow::request &req);
+    void getBookings(const crow::request &req, crow::response &res);
 
     /**
-     * @brief Obsługuje żądanie dodania rezerwacji
+     * @brief Obsługuje żądanie dodania rezerwacji (odpowiedź kończona asynchronicznie)
      * @param req Żądanie HTTP
-     * @return Odpowiedź HTTP z wynikiem operacji
+     * @param res Odpowiedź HTTP z wynikiem operacji
      */
-    crow::response addBooking(const crow::request &req);
+    void addBooking(const crow::request &req, crow::response &res);
 
     /**
-     * @brief Obsługuje żądanie anulowania rezerwacji
+     * @brief Obsługuje żądanie anulowania rezerwacji (odpowiedź kończona asynchronicznie)
+     * @param req Żądanie HTTP
+     * @param res Odpowiedź HTTP z wynikiem operacji
      * @param bookingId Identyfikator rezerwacji
-     * @return Odpowiedź HTTP z wynikiem operacji
      */
-    crow::response cancelBooking(int bookingId);
+    void cancelBooking(const crow::request &req, crow::response &res, int bookingId);
 
     /**
      * @brief Obsługuje żądanie pobrania pięter dla budynku
@@ -61,7 +64,54 @@ public:
      */
     crow::response getFloorsByBuilding(int buildingId);
 
+    /**
+     * @brief Obsługuje żądanie pobrania danych startowych użytkownika
+     * @param userId Identyfikator użytkownika
+     * @return Odpowiedź HTTP z budynkami, rezerwacjami i widokiem piętra
+     */
+    crow::response getBootstrap(int userId);
+
+    /**
+     * @brief Obsługuje żądanie pobrania strony rezerwacji użytkownika (odpowiedź kończona asynchronicznie)
+     * @param req Żądanie HTTP (parametry from, limit, cursor)
+     * @param res Odpowiedź HTTP z rezerwacjami i kursorem następnej strony
+     * @param userId Identyfikator użytkownika
+     */
+    void getUserBookings(const crow::request &req, crow::response &res, int userId);
+
+    /**
+     * @brief Obsługuje żądanie przeładowania katalogu budynków i biurek
+     * @return Odpowiedź HTTP 202 (przeładowanie odbywa się w tle)
+     */
+    crow::response reloadCatalog();
+
+    /**
+     * @brief Obsługuje żądanie pobrania statystyk blokad biurek
+     * @return Odpowiedź HTTP ze statystykami blokad
+     */
+    crow::response getDeskLockStats();
+
+    /**
+     * @brief Czas na obsługę żądania, łącznie z oczekiwaniem na wątek bazy danych
+     */
+    static constexpr std::chrono::milliseconds RequestTimeout{10000};
+
 private:
+    /**
+     * @name Korutyny obsługi żądań
+     *
+     * Parametry żądania są odczytywane przed pierwszym zawieszeniem,
+     * więc żądanie nie jest używane po przejściu na wątek bazy danych.
+     * Odpowiedź służy korutynie tylko do wykrycia rozłączenia klienta.
+     * @{
+     */
+    Task<crow::response> getDesksTask(const crow::request &req, crow::response &res);
+    Task<crow::response> getBookingsTask(const crow::request &req, crow::response &res);
+    Task<crow::response> addBookingTask(const crow::request &req, crow::response &res);
+    Task<crow::response> cancelBookingTask(const crow::request &req, crow::response &res, int bookingId);
+    Task<crow::response> getUserBookingsTask(const crow::request &req, crow::response &res, int userId);
+    /** @} */
+
     BookingService &_bookingService;
 };
 
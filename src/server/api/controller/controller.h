@@ -5,6 +5,9 @@
 #include <nlohmann/json.hpp>
 #include <optional>
 #include "common/logger.h"
+#include "../../async/db_executor.h"
+#include "../../memory/memory_tracker.h"
+#include "../../tracing/trace.h"
 
 using json = nlohmann::json;
 
@@ -49,10 +52,58 @@ protected:
      * @param data Dane do dołączenia do odpowiedzi
      * @return Odpowiedź HTTP z informacją o sukcesie
      */
-    crow::response successResponse(const json &data) {
+    crow::response successResponse(const ArenaJson &data) {
+        TRACE_SPAN("Controller::serialize");
+        MEMORY_SCOPE(Serialization);
         return crow::response(200, data.dump());
     }
 
+    /**
+     * @brief Tworzy odpowiedź dla operacji anulowanej lub przerwanej po upływie terminu
+     * @param ex Wyjątek anulowania
+     * @return Odpowiedź HTTP 504 (upływ terminu) lub 503 (anulowanie)
+     */
+    crow::response canceledResponse(const OperationCanceled &ex) {
+        if (ex.isDeadlineExceeded()) {
+            return errorResponse(504, "Przekroczono czas oczekiwania");
+        }
+        return errorResponse(503, "Serwer jest zajęty lub zatrzymywany");
+    }
+
+    /**
+     * @brief Anuluje operację, gdy klient zamknie połączenie przed odpowiedzią
+     *
+     * Zapytania anulowanej operacji są przerywane, więc rozłączony klient
+     * nie zajmuje dalej wątku bazy danych.
+     *
+     * @param context Kontekst operacji
+     * @param res Odpowiedź HTTP przekazana przez serwer (musi istnieć dłużej niż kontekst)
+     */
+    static void cancelOnDisconnect(OperationContext &context, crow::response &res) {
+        context.watchConnection([&res] { return res.is_alive(); });
+    }
+
+    /**
+     * @brief Kończy odpowiedź HTTP po zakończeniu korutyny
+     *
+     * Wątek serwera wraca do obsługi innych połączeń przy pierwszym
+     * zawieszeniu korutyny, a odpowiedź jest wysyłana z wątku, na którym
+     * korutyna się zakończyła.
+     *
+     * @param res Odpowiedź HTTP przekazana przez serwer
+     * @param task Korutyna tworząca odpowiedź
+     * @return Korutyna uruchomiona od razu, bez oczekującego
+     */
+    static DetachedTask respondAsync(crow::response &res, Task<crow::response> task) {
+        try {
+            res = co_await std::move(task);
+        } catch (const std::exception &ex) {
+            LOG_ERROR("Błąd obsługi żądania{}", logFields("error", ex.what()));
+            res = crow::response(500, json{{"status", "error"}, {"message", "Błąd serwera"}}.dump());
+        }
+        res.end();
+    }
+
     /**
      * @brief Waliduje żądanie i sprawdza wymagane pola
      * @param req Żądanie HTTP
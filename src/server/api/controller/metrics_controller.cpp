@@ -0,0 +1,112 @@
+#include "metrics_controller.h"
+#include "../../memory/memory_tracker.h"
+#include "../../metrics/metrics.h"
+#include "../../repository/query_profiler.h"
+
+crow::response MetricsController::getMetrics() {
+    try {
+        crow::response response(200, Metrics::instance().scrape());
+        response.set_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+        return response;
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
+
+crow::response MetricsController::getQueryStats(const crow::request &req) {
+    try {
+        size_t limit = DefaultQueryStatsTop;
+        if (auto topParam = req.url_params.get("top")) {
+            int top = 0;
+            try {
+                size_t parsed = 0;
+                top = std::stoi(topParam, &parsed);
+                if (topParam[parsed] != '\0') {
+                    top = 0;
+                }
+            } catch (const std::exception &) {
+                top = 0;
+            }
+            if (top <= 0) {
+                return errorResponse(400, "Nieprawidłowy parametr top");
+            }
+            limit = static_cast<size_t>(top);
+        }
+
+        auto &profiler = QueryProfiler::instance();
+        json queries = json::array();
+        for (const auto &stats: profiler.top(limit)) {
+            json query = {
+                {"name", stats.name},
+                {"sql", stats.sql},
+                {"calls", stats.calls},
+                {"totalMs", static_cast<double>(stats.totalNanos) / 1e6},
+                {"avgMs", static_cast<double>(stats.totalNanos) / 1e6 / static_cast<double>(stats.calls)},
+                {"maxMs", static_cast<double>(stats.maxNanos) / 1e6},
+                {"slowCalls", stats.slowCalls}
+            };
+            if (!stats.plan.empty()) {
+                query["plan"] = stats.plan;
+            }
+            queries.push_back(std::move(query));
+        }
+
+        return successResponse({
+            {"status", "success"},
+            {"slowQueryMs", profiler.slowThreshold().count()},
+            {"queries", queries}
+        });
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
+
+crow::response MetricsController::resetQueryStats() {
+    QueryProfiler::instance().reset();
+    return successResponse({{"status", "success"}, {"message", "Statystyki zapytań wyzerowane"}});
+}
+
+crow::response MetricsController::getMemoryStats() {
+    try {
+        auto process = MemoryTracker::process();
+        json response = {
+            {"status", "success"},
+            {"tracking", MemoryTracker::enabled()},
+            {"process", {{"rssBytes", process.rssBytes}, {"peakRssBytes", process.peakRssBytes}}}
+        };
+        if (!MemoryTracker::enabled()) {
+            response["message"] = "Serwer zbudowano bez opcji DESKPP_MEMORY_TRACKING";
+            return successResponse(response);
+        }
+
+        auto snapshot = MemoryTracker::snapshot();
+        MemoryTracker::Usage totals;
+        json subsystems = json::array();
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            const auto &usage = snapshot[i];
+            subsystems.push_back({
+                {"name", MemoryTracker::name(static_cast<MemorySubsystem>(i))},
+                {"currentBytes", usage.currentBytes},
+                {"peakBytes", usage.peakBytes},
+                {"allocations", usage.allocations},
+                {"frees", usage.frees},
+                {"allocatedBytes", usage.allocatedBytes}
+            });
+            totals.currentBytes += usage.currentBytes;
+            totals.allocations += usage.allocations;
+            totals.frees += usage.frees;
+            totals.allocatedBytes += usage.allocatedBytes;
+        }
+
+        response["subsystems"] = std::move(subsystems);
+        response["totals"] = {
+            {"currentBytes", totals.currentBytes},
+            {"allocations", totals.allocations},
+            {"frees", totals.frees},
+            {"allocatedBytes", totals.allocatedBytes}
+        };
+        return successResponse(response);
+    } catch (const std::exception &ex) {
+        return errorResponse(500, "Błąd serwera");
+    }
+}
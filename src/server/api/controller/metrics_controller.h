@@ -0,0 +1,41 @@
+#ifndef METRICS_CONTROLLER_H
+#define METRICS_CONTROLLER_H
+
+#include "controller.h"
+
+/**
+ * @class MetricsController
+ * @brief Kontroler udostępniający metryki serwera i statystyki zapytań SQLite
+ *        oraz zużycie pamięci.
+ */
+class MetricsController : public Controller {
+public:
+    /**
+     * @brief Obsługuje żądanie pobrania metryk
+     * @return Odpowiedź HTTP z metrykami w formacie tekstowym Prometheus
+     */
+    crow::response getMetrics();
+
+    /**
+     * @brief Obsługuje żądanie pobrania statystyk zapytań SQLite
+     * @param req Żądanie HTTP (parametr top - dodatnia liczba zapytań, inna wartość daje 400)
+     * @return Odpowiedź HTTP z zapytaniami o największym łącznym czasie
+     */
+    crow::response getQueryStats(const crow::request &req);
+
+    /**
+     * @brief Obsługuje żądanie wyzerowania statystyk zapytań SQLite
+     * @return Odpowiedź HTTP z potwierdzeniem
+     */
+    crow::response resetQueryStats();
+
+    /**
+     * @brief Obsługuje żądanie pobrania zużycia pamięci według podsystemów
+     * @return Odpowiedź HTTP z bieżącym i szczytowym zużyciem pamięci
+     */
+    crow::response getMemoryStats();
+
+    static constexpr size_t DefaultQueryStatsTop = 20;
+};
+
+#endif
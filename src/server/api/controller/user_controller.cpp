@@ -1,7 +1,7 @@
 #include "user_controller.h"
 
-UserController::UserController(UserService &userService)
-    : _userService(userService) {
+UserController::UserController(UserService &userService, BookingService &bookingService)
+    : _userService(userService), _bookingService(bookingService) {
 }
 
 crow::response UserController::registerUser(const crow::request &req) {
@@ -15,7 +15,7 @@ crow::response UserController::registerUser(const crow::request &req) {
         std::string password = (*params)["password"].get<std::string>();
         std::string email = (*params)["email"].get<std::string>();
 
-        json result = _userService.registerUser(username, password, email);
+        ArenaJson result = _userService.registerUser(username, password, email);
         if (result.contains("status") && result["status"] == "error") {
             return errorResponse(400, result["message"]);
         }
@@ -26,6 +26,9 @@ crow::response UserController::registerUser(const crow::request &req) {
 }
 
 crow::response UserController::loginUser(const crow::request &req) {
+    // Odpowiedź z danymi startowymi obejmuje widok piętra
+    RequestArena arena;
+    ArenaScope arenaScope(&arena);
     try {
         auto params = validateRequest(req, {"username", "password"});
         if (!params) {
@@ -35,10 +38,17 @@ crow::response UserController::loginUser(const crow::request &req) {
         std::string username = (*params)["username"].get<std::string>();
         std::string password = (*params)["password"].get<std::string>();
 
-        json result = _userService.loginUser(username, password);
+        ArenaJson result = _userService.loginUser(username, password);
         if (result.contains("status") && result["status"] == "error") {
             return errorResponse(401, result["message"]);
         }
+
+        // Dane startowe w tej samej odpowiedzi oszczędzają kolejne zapytania klienta
+        if (params->value("bootstrap", false)) {
+            ArenaJson bootstrap = _bookingService.getBootstrap(result["user"]["id"].get<int>());
+            bootstrap.erase("status");
+            result["bootstrap"] = std::move(bootstrap);
+        }
         return successResponse(result);
     } catch (const std::exception &ex) {
         return errorResponse(500, "Błąd serwera");
@@ -3,6 +3,7 @@
 
 #include "controller.h"
 #include "../../service/user_service.h"
+#include "../../service/booking_service.h"
 
 /**
  * @class UserController
@@ -16,8 +17,9 @@ public:
     /**
      * @brief Konstruktor
      * @param userService Referencja do serwisu użytkowników
+     * @param bookingService Referencja do serwisu rezerwacji (dane startowe po logowaniu)
      */
-    explicit UserController(UserService &userService);
+    UserController(UserService &userService, BookingService &bookingService);
 
     /**
      * @brief Obsługuje żądanie rejestracji użytkownika
@@ -28,6 +30,10 @@ public:
 
     /**
      * @brief Obsługuje żądanie logowania użytkownika
+     *
+     * Jeśli ciało żądania zawiera pole "bootstrap": true, odpowiedź zawiera
+     * również dane startowe użytkownika.
+     *
      * @param req Żądanie HTTP
      * @return Odpowiedź HTTP z wynikiem operacji
      */
@@ -35,6 +41,7 @@ public:
 
 private:
     UserService &_userService;
+    BookingService &_bookingService;
 };
 
 #endif
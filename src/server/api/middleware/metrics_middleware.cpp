@@ -0,0 +1,41 @@
+#include "metrics_middleware.h"
+#include <algorithm>
+#include "../../metrics/metrics.h"
+
+void MetricsMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx) {
+    ctx.start = std::chrono::steady_clock::now();
+    Metrics::instance().requestStarted();
+}
+
+void MetricsMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx) {
+    auto elapsed = std::chrono::steady_clock::now() - ctx.start;
+
+    auto &metrics = Metrics::instance();
+    int series = metrics.requestSeries(crow::method_name(req.method), normalizeRoute(req.url), res.code);
+    metrics.requestFinished(series, res.code, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                            res.body.size());
+}
+
+std::string MetricsMiddleware::normalizeRoute(const std::string &url) {
+    std::string route;
+    route.reserve(url.size());
+
+    size_t position = 0;
+    while (position < url.size()) {
+        size_t end = url.find('/', position + 1);
+        if (end == std::string::npos) {
+            end = url.size();
+        }
+
+        // Segment zaczyna się od '/'
+        auto first = url.begin() + static_cast<std::ptrdiff_t>(position) + 1;
+        auto last = url.begin() + static_cast<std::ptrdiff_t>(end);
+        if (first != last && std::all_of(first, last, [](char c) { return c >= '0' && c <= '9'; })) {
+            route += "/<int>";
+        } else {
+            route.append(url, position, end - position);
+        }
+        position = end;
+    }
+    return route.empty() ? "/" : route;
+}
@@ -0,0 +1,31 @@
+#ifndef METRICS_MIDDLEWARE_H
+#define METRICS_MIDDLEWARE_H
+
+#include <chrono>
+#include <string>
+#include <crow.h>
+
+/**
+ * @struct MetricsMiddleware
+ * @brief Middleware Crow mierzące czas, kody i rozmiary odpowiedzi dla każdej trasy.
+ *
+ * Pomiar kończy się w after_handle, które Crow wywołuje po zakończeniu
+ * odpowiedzi, więc obejmuje także odpowiedzi kończone asynchronicznie.
+ */
+struct MetricsMiddleware {
+    struct context {
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+
+    /**
+     * @brief Zamienia liczbowe segmenty ścieżki na <int> (np. /api/users/<int>/bookings)
+     * @param url Ścieżka żądania
+     * @return Trasa bez identyfikatorów
+     */
+    static std::string normalizeRoute(const std::string &url);
+};
+
+#endif
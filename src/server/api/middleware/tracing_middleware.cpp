@@ -0,0 +1,40 @@
+#include "tracing_middleware.h"
+#include "metrics_middleware.h"
+
+void TracingMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx) {
+    auto &tracer = Tracer::instance();
+    if (!tracer.enabled()) {
+        return;
+    }
+
+    if (tracer.sample()) {
+        ctx.trace = Tracer::newTrace();
+        ctx.requestId = ctx.trace->requestId();
+    } else {
+        ctx.requestId = Tracer::newRequestId();
+    }
+
+    // Wątek serwera mógł wcześniej obsługiwać inne żądanie, więc ślad jest ustawiany zawsze
+    Tracer::setCurrent(ctx.trace.get());
+    if (ctx.trace) {
+        ctx.root = TraceSpan(std::string(crow::method_name(req.method)) + " " +
+                             MetricsMiddleware::normalizeRoute(req.url));
+    }
+}
+
+void TracingMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx) {
+    if (ctx.requestId.empty()) {
+        return;
+    }
+    res.add_header("X-Request-Id", ctx.requestId);
+
+    if (ctx.trace) {
+        ctx.root.end();
+        ctx.trace->status = res.code;
+        Tracer::instance().write(*ctx.trace);
+        if (Tracer::current() == ctx.trace.get()) {
+            Tracer::setCurrent(nullptr);
+        }
+        ctx.trace.reset();
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef TRACING_MIDDLEWARE_H
+#define TRACING_MIDDLEWARE_H
+
+#include <memory>
+#include <crow.h>
+#include "../../tracing/trace.h"
+
+/**
+ * @struct TracingMiddleware
+ * @brief Middleware Crow nadające żądaniom identyfikator i zapisujące ich ślady.
+ *
+ * Gdy śledzenie jest włączone, każda odpowiedź otrzymuje nagłówek
+ * X-Request-Id, a dla wylosowanych żądań tworzony jest ślad z odcinkiem
+ * głównym obejmującym całą obsługę. Ślad jest zapisywany w after_handle,
+ * także dla odpowiedzi kończonych asynchronicznie.
+ */
+struct TracingMiddleware {
+    struct context {
+        std::string requestId;
+        std::unique_ptr<RequestTrace> trace;
+        TraceSpan root;
+    };
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "routes.h"
 
-void registerRoutes(crow::SimpleApp &app, BookingController &bookingController,
-                    UserController &userController) {
+void registerRoutes(ServerApp &app, BookingController &bookingController,
+                    UserController &userController, MetricsController &metricsController) {
     // Endpoint budynków
     CROW_ROUTE(app, "/api/buildings").methods(crow::HTTPMethod::GET)
     ([&bookingController](const crow::request &req) {
@@ -10,24 +10,24 @@ void registerRoutes(crow::SimpleApp &app, BookingController &bookingController,
 
     // Endpoint biurek
     CROW_ROUTE(app, "/api/desks").methods(crow::HTTPMethod::GET)
-    ([&bookingController](const crow::request &req) {
-        return bookingController.getDesks(req);
+    ([&bookingController](const crow::request &req, crow::response &res) {
+        bookingController.getDesks(req, res);
     });
 
     // Endpointy rezerwacji
     CROW_ROUTE(app, "/api/bookings").methods(crow::HTTPMethod::GET)
-    ([&bookingController](const crow::request &req) {
-        return bookingController.getBookings(req);
+    ([&bookingController](const crow::request &req, crow::response &res) {
+        bookingController.getBookings(req, res);
     });
 
     CROW_ROUTE(app, "/api/bookings").methods(crow::HTTPMethod::POST)
-    ([&bookingController](const crow::request &req) {
-        return bookingController.addBooking(req);
+    ([&bookingController](const crow::request &req, crow::response &res) {
+        bookingController.addBooking(req, res);
     });
 
     CROW_ROUTE(app, "/api/bookings/<int>").methods(crow::HTTPMethod::DELETE)
-    ([&bookingController](int bookingId) {
-        return bookingController.cancelBooking(bookingId);
+    ([&bookingController](const crow::request &req, crow::response &res, int bookingId) {
+        bookingController.cancelBooking(req, res, bookingId);
     });
 
     // Endpointy użytkowników
@@ -45,4 +45,47 @@ void registerRoutes(crow::SimpleApp &app, BookingController &bookingController,
     ([&bookingController](int buildingId) {
         return bookingController.getFloorsByBuilding(buildingId);
     });
+
+    CROW_ROUTE(app, "/api/users/<int>/bootstrap").methods(crow::HTTPMethod::GET)
+    ([&bookingController](int userId) {
+        return bookingController.getBootstrap(userId);
+    });
+
+    CROW_ROUTE(app, "/api/users/<int>/bookings").methods(crow::HTTPMethod::GET)
+    ([&bookingController](const crow::request &req, crow::response &res, int userId) {
+        bookingController.getUserBookings(req, res, userId);
+    });
+
+    // Endpointy administracyjne
+    CROW_ROUTE(app, "/api/admin/catalog/reload").methods(crow::HTTPMethod::POST)
+    ([&bookingController]() {
+        return bookingController.reloadCatalog();
+    });
+
+    CROW_ROUTE(app, "/api/admin/desk-locks").methods(crow::HTTPMethod::GET)
+    ([&bookingController]() {
+        return bookingController.getDeskLockStats();
+    });
+
+    CROW_ROUTE(app, "/api/admin/queries").methods(crow::HTTPMethod::GET)
+    ([&metricsController](const crow::request &req) {
+        return metricsController.getQueryStats(req);
+    });
+
+    CROW_ROUTE(app, "/api/admin/queries/reset").methods(crow::HTTPMethod::POST)
+    ([&metricsController]() {
+        return metricsController.resetQueryStats();
+    });
+
+    // Zużycie pamięci według podsystemów (pełne dane przy DESKPP_MEMORY_TRACKING)
+    CROW_ROUTE(app, "/debug/memory").methods(crow::HTTPMethod::GET)
+    ([&metricsController]() {
+        return metricsController.getMemoryStats();
+    });
+
+    // Metryki w formacie Prometheus
+    CROW_ROUTE(app, "/metrics").methods(crow::HTTPMethod::GET)
+    ([&metricsController]() {
+        return metricsController.getMetrics();
+    });
 }
@@ -4,14 +4,23 @@
 #include <crow.h>
 #include "controller/booking_controller.h"
 #include "controller/user_controller.h"
+#include "controller/metrics_controller.h"
+#include "middleware/metrics_middleware.h"
+#include "middleware/tracing_middleware.h"
+
+/**
+ * @brief Aplikacja Crow serwera wraz z middleware
+ */
+using ServerApp = crow::App<MetricsMiddleware, TracingMiddleware>;
 
 /**
  * @brief Rejestruje ścieżki API w aplikacji Crow
  * @param app Referencja do aplikacji Crow
  * @param bookingController Referencja do kontrolera rezerwacji
  * @param userController Referencja do kontrolera użytkowników
+ * @param metricsController Referencja do kontrolera metryk
  */
-void registerRoutes(crow::SimpleApp &app, BookingController &bookingController,
-                    UserController &userController);
+void registerRoutes(ServerApp &app, BookingController &bookingController,
+                    UserController &userController, MetricsController &metricsController);
 
 #endif
@@ -0,0 +1,97 @@
+#include "db_executor.h"
+#include <algorithm>
+#include "common/logger.h"
+
+namespace {
+    thread_local const OperationContext *currentOperation = nullptr;
+
+    int interruptIfStopped(void *handle) {
+        // Przerwanie w jawnej transakcji mogłoby zatrzymać jej COMMIT lub ROLLBACK
+        if (!sqlite3_get_autocommit(static_cast<sqlite3 *>(handle))) {
+            return 0;
+        }
+        return currentOperation && currentOperation->isStopped() ? 1 : 0;
+    }
+}
+
+const OperationContext *OperationContext::current() {
+    return currentOperation;
+}
+
+void OperationContext::setCurrent(const OperationContext *context) {
+    currentOperation = context;
+}
+
+void interruptStoppedOperations(SQLite::Database &db) {
+    sqlite3_progress_handler(db.getHandle(), DbExecutor::ProgressSteps, interruptIfStopped, db.getHandle());
+}
+
+DbExecutor::DbExecutor(size_t threads) {
+    threads = std::max<size_t>(1, threads);
+    _threads.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        _threads.emplace_back(&DbExecutor::workerLoop, this);
+    }
+    LOG_DEBUG("Uruchomiono pulę {} wątków bazy danych", threads);
+}
+
+DbExecutor::~DbExecutor() {
+    stop();
+}
+
+void DbExecutor::stop() {
+    {
+        std::lock_guard lock(_mutex);
+        if (_stopping.load()) {
+            return;
+        }
+        _stopping.store(true, std::memory_order_release);
+    }
+    _ready.notify_all();
+
+    // Wątki kończą pracę dopiero po opróżnieniu kolejki, więc każda
+    // oczekująca korutyna zostaje wznowiona i kończy się wyjątkiem anulowania
+    for (auto &thread: _threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void DbExecutor::resume(std::coroutine_handle<> handle) {
+    if (!enqueue(handle)) {
+        handle.resume();
+    }
+}
+
+bool DbExecutor::enqueue(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard lock(_mutex);
+        if (_stopping.load()) {
+            return false;
+        }
+        _queue.push_back(handle);
+    }
+    _ready.notify_one();
+    return true;
+}
+
+void DbExecutor::workerLoop() {
+    while (true) {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock lock(_mutex);
+            _ready.wait(lock, [this] { return _stopping.load() || !_queue.empty(); });
+            if (_queue.empty()) {
+                return;
+            }
+            handle = _queue.front();
+            _queue.pop_front();
+        }
+        handle.resume();
+
+        // Ślad i kontekst wznowionego żądania nie mogą przejść na kolejne zadanie wątku
+        Tracer::setCurrent(nullptr);
+        OperationContext::setCurrent(nullptr);
+    }
+}
@@ -0,0 +1,321 @@
+#ifndef DB_EXECUTOR_H
+#define DB_EXECUTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <sqlite3.h>
+
+#include "task.h"
+#include "../memory/request_arena.h"
+#include "../tracing/trace.h"
+
+/**
+ * @class OperationCanceled
+ * @brief Wyjątek operacji anulowanej lub przerwanej po upływie terminu.
+ */
+class OperationCanceled : public std::runtime_error {
+public:
+    /**
+     * @brief Konstruktor
+     * @param deadlineExceeded Czy przyczyną jest upływ terminu
+     */
+    explicit OperationCanceled(bool deadlineExceeded)
+        : std::runtime_error(deadlineExceeded ? "Przekroczono czas operacji" : "Operacja anulowana"),
+          _deadlineExceeded(deadlineExceeded) {
+    }
+
+    /**
+     * @brief Sprawdza czy operację przerwano z powodu upływu terminu
+     * @return Czy upłynął termin
+     */
+    bool isDeadlineExceeded() const { return _deadlineExceeded; }
+
+private:
+    bool _deadlineExceeded;
+};
+
+/**
+ * @class OperationContext
+ * @brief Stan anulowania i termin operacji asynchronicznej.
+ *
+ * Kontekst musi istnieć do zakończenia operacji, dlatego zwykle jest
+ * zmienną lokalną korutyny, która na tę operację czeka. Kontekst przenosi
+ * też ślad żądania, w którym został utworzony, na wątki puli, oraz arenę
+ * żądania, z której serwis buduje odpowiedź.
+ *
+ * Na wątku puli kontekst wznowionej korutyny jest kontekstem bieżącym
+ * (current()), więc zapytanie SQLite trwające po anulowaniu lub upływie
+ * terminu jest przerywane (interruptStoppedOperations). Kontekst z funkcją
+ * sprawdzającą połączenie (watchConnection) anuluje się sam, gdy klient
+ * się rozłączy.
+ */
+class OperationContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Konstruktor
+     * @param timeout Czas na wykonanie operacji
+     * @param arena Arena żądania (nullptr - odpowiedź na stercie); musi istnieć dłużej niż odpowiedź
+     */
+    explicit OperationContext(std::chrono::milliseconds timeout, RequestArena *arena = nullptr)
+        : _deadline(Clock::now() + timeout), _trace(Tracer::current()), _arena(arena) {
+    }
+
+    /**
+     * @brief Destruktor (przestaje być kontekstem bieżącym wątku)
+     */
+    ~OperationContext() {
+        if (current() == this) {
+            setCurrent(nullptr);
+        }
+    }
+
+    OperationContext(const OperationContext &) = delete;
+    OperationContext &operator=(const OperationContext &) = delete;
+
+    /**
+     * @brief Anuluje operację (przy najbliższym punkcie kontrolnym)
+     */
+    void cancel() const { _stop.request_stop(); }
+
+    /**
+     * @brief Ustawia funkcję sprawdzającą połączenie klienta
+     *
+     * Funkcja jest wywoływana w punktach kontrolnych, także z wątków puli
+     * w trakcie zapytań, więc musi być tania i bezpieczna wątkowo. Gdy zwróci
+     * false, operacja zostaje anulowana (cancel).
+     *
+     * @param isAlive Funkcja zwracająca, czy klient nadal czeka na odpowiedź
+     */
+    void watchConnection(std::function<bool()> isAlive) { _isAlive = std::move(isAlive); }
+
+    /**
+     * @brief Zwraca token anulowania (np. dla std::stop_callback)
+     * @return Token anulowania
+     */
+    std::stop_token stopToken() const { return _stop.get_token(); }
+
+    /**
+     * @brief Zwraca termin operacji
+     * @return Termin
+     */
+    Clock::time_point deadline() const { return _deadline; }
+
+    /**
+     * @brief Zwraca ślad żądania, w którym utworzono kontekst
+     * @return Ślad lub nullptr
+     */
+    RequestTrace *trace() const { return _trace; }
+
+    /**
+     * @brief Zwraca arenę żądania
+     * @return Arena lub nullptr
+     */
+    RequestArena *arena() const { return _arena; }
+
+    /**
+     * @brief Sprawdza czy operację anulowano (także przez rozłączenie klienta) lub minął termin
+     * @return Czy operację należy przerwać
+     */
+    bool isStopped() const { return isCanceled() || Clock::now() >= _deadline; }
+
+    /**
+     * @brief Przerywa operację wyjątkiem, jeśli ją anulowano lub minął termin
+     * @throws OperationCanceled
+     */
+    void throwIfStopped() const {
+        if (isCanceled()) {
+            throw OperationCanceled(false);
+        }
+        if (Clock::now() >= _deadline) {
+            throw OperationCanceled(true);
+        }
+    }
+
+    /**
+     * @brief Zwraca kontekst operacji wykonywanej na bieżącym wątku
+     * @return Kontekst lub nullptr
+     */
+    static const OperationContext *current();
+
+    /**
+     * @brief Ustawia kontekst operacji wykonywanej na bieżącym wątku
+     * @param context Kontekst lub nullptr
+     */
+    static void setCurrent(const OperationContext *context);
+
+private:
+    bool isCanceled() const {
+        if (!_stop.stop_requested() && _isAlive && !_isAlive()) {
+            cancel();
+        }
+        return _stop.stop_requested();
+    }
+
+    // Anulowanie nie zmienia danych operacji, więc jest dostępne przez referencję stałą
+    mutable std::stop_source _stop;
+    Clock::time_point _deadline;
+    RequestTrace *_trace;
+    RequestArena *_arena;
+    std::function<bool()> _isAlive;
+};
+
+/**
+ * @brief Przerywa zapytania operacji anulowanych lub po terminie
+ *
+ * Instaluje na połączeniu procedurę postępu SQLite, która co ProgressSteps
+ * instrukcji sprawdza kontekst bieżący wątku i przerywa zapytanie
+ * (SQLITE_INTERRUPT) operacji, którą należy przerwać. Zapytania w jawnej
+ * transakcji nie są przerywane, aby COMMIT i ROLLBACK zawsze się wykonały.
+ *
+ * @param db Połączenie z bazą danych
+ */
+void interruptStoppedOperations(SQLite::Database &db);
+
+/**
+ * @brief Wykonuje funkcję, zamieniając przerwane zapytanie na OperationCanceled
+ * @param context Kontekst operacji
+ * @param function Funkcja do wykonania
+ * @return Wynik funkcji
+ * @throws OperationCanceled Jeśli zapytanie przerwano z powodu anulowania lub terminu
+ */
+template<typename F>
+std::invoke_result_t<F> interruptible(const OperationContext &context, F &&function) {
+    try {
+        return std::forward<F>(function)();
+    } catch (const SQLite::Exception &e) {
+        if (e.getErrorCode() == SQLITE_INTERRUPT) {
+            context.throwIfStopped();
+        }
+        throw;
+    }
+}
+
+/**
+ * @class DbExecutor
+ * @brief Pula wątków wykonujących operacje na bazie danych dla korutyn.
+ *
+ * Korutyna wywołująca co_await schedule() jest wznawiana na jednym z wątków
+ * puli, więc wątek obsługujący żądanie HTTP może w tym czasie obsługiwać
+ * inne połączenia. Przed wznowieniem sprawdzane są anulowanie i termin
+ * operacji, więc żądania, które czekały w kolejce zbyt długo, nie obciążają
+ * bazy. Do zakończenia zadania kontekst korutyny jest kontekstem bieżącym
+ * wątku puli.
+ */
+class DbExecutor {
+public:
+    /**
+     * @brief Konstruktor (uruchamia wątki puli)
+     * @param threads Liczba wątków
+     */
+    explicit DbExecutor(size_t threads = DefaultThreads);
+
+    /**
+     * @brief Destruktor (zatrzymuje pulę)
+     */
+    ~DbExecutor();
+
+    DbExecutor(const DbExecutor &) = delete;
+    DbExecutor &operator=(const DbExecutor &) = delete;
+
+    /**
+     * @brief Zatrzymuje pulę; oczekujące korutyny są wznawiane jako anulowane
+     */
+    void stop();
+
+    /**
+     * @brief Wznawia korutynę na wątku puli (np. po zakończeniu operacji innego wątku)
+     *
+     * Po zatrzymaniu puli korutyna jest wznawiana od razu na bieżącym wątku.
+     *
+     * @param handle Korutyna
+     */
+    void resume(std::coroutine_handle<> handle);
+
+    /**
+     * @brief Obiekt oczekiwania przenoszący korutynę na wątek puli
+     */
+    struct ScheduleAwaiter {
+        DbExecutor *executor;
+        const OperationContext &context;
+
+        /**
+         * @brief Bez puli (nullptr) korutyna działa dalej na bieżącym wątku
+         */
+        bool await_ready() const noexcept { return executor == nullptr; }
+
+        /**
+         * @brief Po zatrzymaniu puli korutyna jest wznawiana od razu (jako anulowana)
+         */
+        bool await_suspend(std::coroutine_handle<> handle) { return executor->enqueue(handle); }
+
+        void await_resume() const {
+            if (executor) {
+                Tracer::setCurrent(context.trace());
+                OperationContext::setCurrent(&context);
+            }
+            if (executor && executor->isStopping()) {
+                throw OperationCanceled(false);
+            }
+            context.throwIfStopped();
+        }
+    };
+
+    /**
+     * @brief Przenosi korutynę na wątek puli
+     * @param context Kontekst operacji
+     * @return Obiekt do użycia z co_await
+     */
+    ScheduleAwaiter schedule(const OperationContext &context) { return {this, context}; }
+
+    /**
+     * @brief Wykonuje funkcję (np. metodę repozytorium) na wątku puli
+     * @param context Kontekst operacji
+     * @param function Funkcja do wykonania
+     * @return Korutyna zwracająca wynik funkcji
+     */
+    template<typename F>
+    Task<std::invoke_result_t<F>> run(const OperationContext &context, F function) {
+        co_await schedule(context);
+        co_return interruptible(context, std::move(function));
+    }
+
+    static constexpr size_t DefaultThreads = 4;
+    static constexpr int ProgressSteps = 1000;
+
+private:
+    bool enqueue(std::coroutine_handle<> handle);
+    void workerLoop();
+    bool isStopping() const { return _stopping.load(std::memory_order_acquire); }
+
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::deque<std::coroutine_handle<>> _queue;
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _stopping{false};
+};
+
+/**
+ * @brief Przenosi korutynę na pulę wątków bazy danych, jeśli jest dostępna
+ * @param executor Pula wątków (nullptr - wykonanie na bieżącym wątku)
+ * @param context Kontekst operacji
+ * @return Obiekt do użycia z co_await
+ */
+inline DbExecutor::ScheduleAwaiter scheduleOn(DbExecutor *executor, const OperationContext &context) {
+    return {executor, context};
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+template<typename T>
+class Task;
+
+namespace detail {
+    /**
+     * @brief Po zakończeniu korutyny wznawia korutynę, która na nią czekała
+     */
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {
+        }
+    };
+
+    /**
+     * @brief Wspólna część obietnicy korutyny Task
+     */
+    struct TaskPromiseBase {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    template<typename T>
+    struct TaskPromise : TaskPromiseBase {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+        void return_value(T result) { value.emplace(std::move(result)); }
+
+        T result() {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            return std::move(*value);
+        }
+    };
+
+    template<>
+    struct TaskPromise<void> : TaskPromiseBase {
+        Task<void> get_return_object();
+        void return_void() {
+        }
+
+        void result() {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+}
+
+/**
+ * @class Task
+ * @brief Leniwa korutyna zwracająca wynik typu T.
+ *
+ * Korutyna rusza dopiero po użyciu co_await, a po zakończeniu wznawia
+ * korutynę, która na nią czekała (bez dodatkowych wątków i alokacji
+ * poza ramką korutyny). Wyjątki są przekazywane do oczekującego.
+ *
+ * @tparam T Typ wyniku (void - brak wyniku)
+ */
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {
+    }
+
+    Task(Task &&other) noexcept : _handle(std::exchange(other._handle, {})) {
+    }
+
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (_handle) {
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Uruchamia korutynę i zawiesza oczekującego do jej zakończenia
+     */
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{_handle};
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+};
+
+template<typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+/**
+ * @struct DetachedTask
+ * @brief Korutyna uruchamiana natychmiast, której nikt nie oczekuje.
+ *
+ * Służy jako punkt wejścia z kodu synchronicznego (np. obsługi żądania
+ * HTTP). Ramka jest zwalniana automatycznie po zakończeniu, a wyjątki
+ * muszą być obsłużone wewnątrz korutyny.
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {
+        }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "memory_tracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace {
+    constexpr size_t Subsystems = static_cast<size_t>(MemorySubsystem::Count);
+    constexpr size_t MaxSlots = 128;
+
+    /**
+     * @brief Liczniki przydziałów jednego wątku (po przekroczeniu puli - kilku wątków)
+     */
+    struct alignas(64) Slot {
+        std::array<std::atomic<uint64_t>, Subsystems> allocations;
+        std::array<std::atomic<uint64_t>, Subsystems> frees;
+        std::array<std::atomic<uint64_t>, Subsystems> allocatedBytes;
+    };
+
+    // Wszystkie liczniki są inicjalizowane statycznie, bo operator new działa przed main
+    Slot slots[MaxSlots];
+    std::atomic<size_t> nextSlot{0};
+    std::array<std::atomic<int64_t>, Subsystems> currentBytes;
+    std::array<std::atomic<int64_t>, Subsystems> peakBytes;
+
+#ifdef DESKPP_MEMORY_TRACKING
+    thread_local Slot *localSlot = nullptr;
+    thread_local std::array<int64_t, Subsystems> pendingBytes{};
+
+    Slot &slot() {
+        if (!localSlot) {
+            localSlot = &slots[nextSlot.fetch_add(1, std::memory_order_relaxed) % MaxSlots];
+        }
+        return *localSlot;
+    }
+
+    void flush(size_t subsystem) {
+        int64_t delta = std::exchange(pendingBytes[subsystem], 0);
+        int64_t now = currentBytes[subsystem].fetch_add(delta, std::memory_order_relaxed) + delta;
+        int64_t peak = peakBytes[subsystem].load(std::memory_order_relaxed);
+        while (now > peak && !peakBytes[subsystem].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    void addPending(size_t subsystem, int64_t bytes) {
+        int64_t &pending = pendingBytes[subsystem];
+        pending += bytes;
+        if (pending >= MemoryTracker::FlushBytes || pending <= -MemoryTracker::FlushBytes) {
+            flush(subsystem);
+        }
+    }
+
+    /**
+     * @brief Nagłówek zapisywany bezpośrednio przed przydziałem
+     */
+    struct alignas(alignof(std::max_align_t)) Header {
+        size_t size;
+        MemorySubsystem subsystem;
+    };
+
+    constexpr size_t HeaderSize = sizeof(Header);
+
+    void *trackedAllocate(size_t size, size_t alignment) noexcept {
+        size_t offset = std::max(alignment, HeaderSize);
+        void *base = alignment <= HeaderSize
+                         ? std::malloc(offset + size)
+                         : std::aligned_alloc(alignment, (offset + size + alignment - 1) / alignment * alignment);
+        if (!base) {
+            return nullptr;
+        }
+
+        auto *pointer = static_cast<std::byte *>(base) + offset;
+        auto *header = reinterpret_cast<Header *>(pointer - HeaderSize);
+        header->size = size;
+        header->subsystem = MemoryTracker::current();
+
+        auto subsystem = static_cast<size_t>(header->subsystem);
+        Slot &counters = slot();
+        counters.allocations[subsystem].fetch_add(1, std::memory_order_relaxed);
+        counters.allocatedBytes[subsystem].fetch_add(size, std::memory_order_relaxed);
+        addPending(subsystem, static_cast<int64_t>(size));
+        return pointer;
+    }
+
+    void trackedFree(void *pointer, size_t alignment) noexcept {
+        if (!pointer) {
+            return;
+        }
+        auto *bytes = static_cast<std::byte *>(pointer);
+        auto *header = reinterpret_cast<Header *>(bytes - HeaderSize);
+
+        auto subsystem = static_cast<size_t>(header->subsystem);
+        slot().frees[subsystem].fetch_add(1, std::memory_order_relaxed);
+        addPending(subsystem, -static_cast<int64_t>(header->size));
+        std::free(bytes - std::max(alignment, HeaderSize));
+    }
+
+    void *allocateOrThrow(size_t size, size_t alignment) {
+        while (true) {
+            if (void *pointer = trackedAllocate(size, alignment)) {
+                return pointer;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void *allocateOrNull(size_t size, size_t alignment) noexcept {
+        try {
+            return allocateOrThrow(size, alignment);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    constexpr size_t DefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#endif
+}
+
+MemoryTracker::Snapshot MemoryTracker::snapshot() {
+    Snapshot snapshot;
+    for (const auto &counters: slots) {
+        for (size_t i = 0; i < Subsystems; ++i) {
+            snapshot[i].allocations += counters.allocations[i].load(std::memory_order_relaxed);
+            snapshot[i].frees += counters.frees[i].load(std::memory_order_relaxed);
+            snapshot[i].allocatedBytes += counters.allocatedBytes[i].load(std::memory_order_relaxed);
+        }
+    }
+    for (size_t i = 0; i < Subsystems; ++i) {
+        snapshot[i].currentBytes = currentBytes[i].load(std::memory_order_relaxed);
+        snapshot[i].peakBytes = peakBytes[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+uint64_t MemoryTracker::totalAllocations() {
+    uint64_t total = 0;
+    for (const auto &counters: slots) {
+        for (const auto &allocations: counters.allocations) {
+            total += allocations.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+MemoryTracker::ProcessUsage MemoryTracker::process() {
+    ProcessUsage usage;
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        // Wartości są podawane w kilobajtach, np. "VmRSS:     12345 kB"
+        if (line.starts_with("VmRSS:")) {
+            usage.rssBytes = std::stoll(line.substr(6)) * 1024;
+        } else if (line.starts_with("VmHWM:")) {
+            usage.peakRssBytes = std::stoll(line.substr(6)) * 1024;
+        }
+    }
+    return usage;
+}
+
+std::string_view MemoryTracker::name(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::Repository:
+            return "repository";
+        case MemorySubsystem::Service:
+            return "service";
+        case MemorySubsystem::Serialization:
+            return "serialization";
+        case MemorySubsystem::Cache:
+            return "cache";
+        default:
+            return "other";
+    }
+}
+
+#ifdef DESKPP_MEMORY_TRACKING
+void *operator new(size_t size) { return allocateOrThrow(size, DefaultAlignment); }
+void *operator new[](size_t size) { return allocateOrThrow(size, DefaultAlignment); }
+void *operator new(size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return allocateOrNull(size, DefaultAlignment); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return allocateOrNull(size, DefaultAlignment); }
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocateOrNull(size, static_cast<size_t>(alignment));
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocateOrNull(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete[](void *pointer) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete(void *pointer, size_t) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete[](void *pointer, size_t) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete(void *pointer, std::align_val_t alignment) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void *pointer, std::align_val_t alignment) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+void operator delete(void *pointer, size_t, std::align_val_t alignment) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void *pointer, size_t, std::align_val_t alignment) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { trackedFree(pointer, DefaultAlignment); }
+void operator delete(void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+void operator delete[](void *pointer, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    trackedFree(pointer, static_cast<size_t>(alignment));
+}
+#endif
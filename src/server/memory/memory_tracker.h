@@ -0,0 +1,147 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Podsystem, któremu przypisywane są przydziały pamięci
+ */
+enum class MemorySubsystem : uint8_t {
+    Other,          ///< Przydziały poza oznaczonymi zakresami (HTTP, logi, biblioteki)
+    Repository,     ///< Zapytania i mapowanie wierszy na encje
+    Service,        ///< Logika biznesowa i budowa odpowiedzi
+    Serialization,  ///< Zapis odpowiedzi JSON i bloki aren żądań
+    Cache,          ///< Katalog budynków i biurek oraz pamięć podręczna potoku zapisu
+    Count
+};
+
+/**
+ * @class MemoryTracker
+ * @brief Liczniki przydziałów pamięci według podsystemów.
+ *
+ * Przy budowie z opcją DESKPP_MEMORY_TRACKING globalne operatory new
+ * i delete zapisują przed każdym przydziałem jego rozmiar i podsystem
+ * bieżącego zakresu (MemoryScope), więc zwolnienie pomniejsza licznik
+ * podsystemu, który pamięć przydzielił, niezależnie od wątku i zakresu,
+ * w którym nastąpiło.
+ *
+ * Liczniki przydziałów są prowadzone we fragmentach wątków o stałej puli
+ * (bez przydziałów przy pierwszym użyciu), a bieżące zużycie i jego
+ * szczyt - w licznikach globalnych zasilanych przez wątki porcjami do
+ * FlushBytes, więc szczyt jest dokładny z tą tolerancją na wątek.
+ * Bez opcji liczniki pozostają zerowe, a zakresy kosztują dwa zapisy
+ * zmiennej wątku.
+ */
+class MemoryTracker {
+public:
+    /**
+     * @brief Stan liczników podsystemu
+     */
+    struct Usage {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t allocatedBytes = 0;
+        int64_t currentBytes = 0;
+        int64_t peakBytes = 0;
+    };
+
+    using Snapshot = std::array<Usage, static_cast<size_t>(MemorySubsystem::Count)>;
+
+    /**
+     * @brief Pamięć rezydentna procesu według systemu operacyjnego
+     */
+    struct ProcessUsage {
+        int64_t rssBytes = 0;
+        int64_t peakRssBytes = 0;
+    };
+
+    /**
+     * @brief Sprawdza czy serwer zbudowano ze śledzeniem przydziałów
+     * @return Czy liczniki są prowadzone
+     */
+    static constexpr bool enabled() {
+#ifdef DESKPP_MEMORY_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Zwraca stan liczników wszystkich podsystemów
+     * @return Liczniki w kolejności MemorySubsystem
+     */
+    static Snapshot snapshot();
+
+    /**
+     * @brief Zwraca liczbę wszystkich przydziałów od startu procesu
+     * @return Liczba przydziałów
+     */
+    static uint64_t totalAllocations();
+
+    /**
+     * @brief Odczytuje pamięć rezydentną procesu (/proc/self/status)
+     * @return Bieżąca i szczytowa pamięć rezydentna (zera poza Linuksem)
+     */
+    static ProcessUsage process();
+
+    /**
+     * @brief Zwraca nazwę podsystemu
+     * @param subsystem Podsystem
+     * @return Nazwa (np. "repository")
+     */
+    static std::string_view name(MemorySubsystem subsystem);
+
+    /**
+     * @brief Zwraca podsystem bieżącego zakresu wątku
+     * @return Podsystem
+     */
+    static MemorySubsystem current() { return _current; }
+
+    static constexpr int64_t FlushBytes = 64 * 1024;
+
+private:
+    friend class MemoryScope;
+
+    static inline thread_local MemorySubsystem _current = MemorySubsystem::Other;
+};
+
+/**
+ * @class MemoryScope
+ * @brief Przypisuje przydziały bieżącego wątku do podsystemu do końca zakresu.
+ *
+ * Zakres zagnieżdżony zastępuje zewnętrzny, z wyjątkiem zakresu pamięci
+ * podręcznej: dane wczytane przez repozytorium do pamięci podręcznej
+ * pozostają w niej, więc są przypisywane do Cache.
+ */
+class MemoryScope {
+public:
+    /**
+     * @brief Konstruktor
+     * @param subsystem Podsystem
+     */
+    explicit MemoryScope(MemorySubsystem subsystem) : _previous(MemoryTracker::_current) {
+        if (_previous != MemorySubsystem::Cache) {
+            MemoryTracker::_current = subsystem;
+        }
+    }
+
+    ~MemoryScope() { MemoryTracker::_current = _previous; }
+
+    MemoryScope(const MemoryScope &) = delete;
+    MemoryScope &operator=(const MemoryScope &) = delete;
+
+private:
+    MemorySubsystem _previous;
+};
+
+/**
+ * @brief Przypisuje przydziały do podsystemu do końca bieżącego zakresu
+ * @param subsystem Podsystem (np. Service)
+ */
+#define MEMORY_SCOPE(subsystem) MemoryScope memoryScope_(MemorySubsystem::subsystem)
+
+#endif
@@ -0,0 +1,85 @@
+#include "request_arena.h"
+#include "memory_tracker.h"
+#include <atomic>
+#include <mutex>
+
+namespace {
+    /**
+     * @brief Pula bloków aren; blok przechodzi między żądaniami bez zwalniania
+     */
+    struct BlockPool {
+        std::mutex mutex;
+        std::vector<std::byte *> blocks;
+
+        ~BlockPool() {
+            for (auto *block: blocks) {
+                delete[] block;
+            }
+        }
+    };
+
+    BlockPool &blockPool() {
+        static BlockPool pool;
+        return pool;
+    }
+
+    std::byte *acquireBlock() {
+        auto &pool = blockPool();
+        {
+            std::lock_guard lock(pool.mutex);
+            if (!pool.blocks.empty()) {
+                std::byte *block = pool.blocks.back();
+                pool.blocks.pop_back();
+                return block;
+            }
+        }
+        MEMORY_SCOPE(Serialization);
+        return new std::byte[RequestArena::BlockSize];
+    }
+
+    void releaseBlock(std::byte *block) {
+        auto &pool = blockPool();
+        {
+            std::lock_guard lock(pool.mutex);
+            if (pool.blocks.size() < RequestArena::MaxPooledBlocks) {
+                pool.blocks.push_back(block);
+                return;
+            }
+        }
+        delete[] block;
+    }
+
+    std::atomic<uint64_t> totalArenas{0};
+    std::atomic<uint64_t> totalAllocations{0};
+    std::atomic<uint64_t> totalBytes{0};
+    std::atomic<uint64_t> totalOverflowBlocks{0};
+}
+
+RequestArena::RequestArena()
+    : _block(acquireBlock()), _buffer(_block, BlockSize, &_upstream) {
+}
+
+RequestArena::~RequestArena() {
+    _buffer.release();
+    releaseBlock(_block);
+
+    totalArenas.fetch_add(1, std::memory_order_relaxed);
+    totalAllocations.fetch_add(_allocations, std::memory_order_relaxed);
+    totalBytes.fetch_add(_bytes, std::memory_order_relaxed);
+    totalOverflowBlocks.fetch_add(_upstream.blocks, std::memory_order_relaxed);
+}
+
+RequestArena::Totals RequestArena::totals() {
+    Totals totals;
+    totals.arenas = totalArenas.load(std::memory_order_relaxed);
+    totals.allocations = totalAllocations.load(std::memory_order_relaxed);
+    totals.bytes = totalBytes.load(std::memory_order_relaxed);
+    totals.overflowBlocks = totalOverflowBlocks.load(std::memory_order_relaxed);
+    return totals;
+}
+
+void *RequestArena::do_allocate(size_t bytes, size_t alignment) {
+    ++_allocations;
+    _bytes += bytes;
+    return _buffer.allocate(bytes, alignment);
+}
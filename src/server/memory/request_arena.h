@@ -0,0 +1,201 @@
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "memory_tracker.h"
+
+/**
+ * @class RequestArena
+ * @brief Arena pamięci jednego żądania HTTP.
+ *
+ * Przydziały są kolejnymi fragmentami bloku pobranego z puli przy
+ * utworzeniu areny, a zwalniane są wszystkie naraz przy jej zniszczeniu
+ * (blok wraca do puli). Gdy blok się zapełni, arena dobiera większe bloki
+ * ze sterty. Arena nie jest bezpieczna wątkowo - żądanie korzysta z niej
+ * w danej chwili tylko na jednym wątku.
+ */
+class RequestArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Statystyki wszystkich aren od startu serwera
+     */
+    struct Totals {
+        uint64_t arenas = 0;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t overflowBlocks = 0;
+    };
+
+    /**
+     * @brief Konstruktor (pobiera blok z puli)
+     */
+    RequestArena();
+
+    /**
+     * @brief Destruktor (zwalnia całą pamięć areny)
+     */
+    ~RequestArena() override;
+
+    RequestArena(const RequestArena &) = delete;
+    RequestArena &operator=(const RequestArena &) = delete;
+
+    /**
+     * @brief Zwraca liczbę przydziałów z areny
+     * @return Liczba przydziałów
+     */
+    size_t allocations() const { return _allocations; }
+
+    /**
+     * @brief Zwraca liczbę bajtów przydzielonych z areny
+     * @return Liczba bajtów
+     */
+    size_t bytes() const { return _bytes; }
+
+    /**
+     * @brief Zwraca liczbę bloków dobranych ze sterty po zapełnieniu bloku z puli
+     * @return Liczba bloków
+     */
+    size_t overflowBlocks() const { return _upstream.blocks; }
+
+    /**
+     * @brief Zwraca arenę ustawioną dla bieżącego wątku
+     * @return Arena lub nullptr
+     */
+    static RequestArena *current() { return _current; }
+
+    /**
+     * @brief Zwraca sumaryczne statystyki aren
+     * @return Statystyki
+     */
+    static Totals totals();
+
+    static constexpr size_t BlockSize = 64 * 1024;
+    static constexpr size_t MaxPooledBlocks = 64;
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void *, size_t, size_t) override {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    friend class ArenaScope;
+
+    /**
+     * @brief Sterta zliczająca bloki dobrane przez arenę
+     */
+    struct Upstream : std::pmr::memory_resource {
+        size_t blocks = 0;
+
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            ++blocks;
+            MEMORY_SCOPE(Serialization);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    };
+
+    static inline thread_local RequestArena *_current = nullptr;
+
+    std::byte *_block;
+    Upstream _upstream;
+    std::pmr::monotonic_buffer_resource _buffer;
+    size_t _allocations = 0;
+    size_t _bytes = 0;
+};
+
+/**
+ * @class ArenaScope
+ * @brief Ustawia arenę żądania dla bieżącego wątku do końca zakresu.
+ *
+ * Zakres nie może obejmować zawieszenia korutyny, bo wątek wraca wtedy do
+ * obsługi innych żądań.
+ */
+class ArenaScope {
+public:
+    /**
+     * @brief Konstruktor
+     * @param arena Arena żądania (nullptr - przydziały ze sterty)
+     */
+    explicit ArenaScope(RequestArena *arena) : _previous(RequestArena::_current) {
+        RequestArena::_current = arena;
+    }
+
+    ~ArenaScope() { RequestArena::_current = _previous; }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+private:
+    RequestArena *_previous;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Alokator przydzielający pamięć z areny bieżącego wątku, a poza
+ *        zakresem areny ze sterty.
+ *
+ * nlohmann::json tworzy alokatory domyślnym konstruktorem w miejscu użycia,
+ * dlatego pochodzenie przydziału jest zapisywane w nagłówku przed nim:
+ * dokument zbudowany na stercie można bezpiecznie zniszczyć w zakresie
+ * areny i odwrotnie. Przydział z areny zwalnia dopiero zniszczenie areny.
+ *
+ * @tparam T Typ elementów
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &) noexcept {
+    }
+
+    T *allocate(size_t count) {
+        size_t bytes = HeaderSize + count * sizeof(T);
+        RequestArena *arena = RequestArena::current();
+        void *block = arena ? arena->allocate(bytes, Alignment) : ::operator new(bytes, std::align_val_t(Alignment));
+        *static_cast<RequestArena **>(block) = arena;
+        return reinterpret_cast<T *>(static_cast<std::byte *>(block) + HeaderSize);
+    }
+
+    void deallocate(T *pointer, size_t count) noexcept {
+        void *block = reinterpret_cast<std::byte *>(pointer) - HeaderSize;
+        if (*static_cast<RequestArena **>(block) == nullptr) {
+            ::operator delete(block, HeaderSize + count * sizeof(T), std::align_val_t(Alignment));
+        }
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &) const noexcept { return true; }
+
+private:
+    static constexpr size_t Alignment = alignof(T) > alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t);
+    static constexpr size_t HeaderSize = Alignment;
+};
+
+/**
+ * @brief Dokument JSON, którego węzły w zakresie areny żądania pochodzą z areny
+ */
+using ArenaJson = nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t, std::uint64_t, double,
+                                       ArenaAllocator>;
+
+#endif
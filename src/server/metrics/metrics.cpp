@@ -0,0 +1,300 @@
+#include "metrics.h"
+#include <algorithm>
+#include <sstream>
+#include "common/logger.h"
+#include "../memory/memory_tracker.h"
+#include "../memory/request_arena.h"
+
+namespace {
+    /**
+     * @brief Granice przedziałów histogramów w nanosekundach
+     */
+    constexpr auto BucketNanos = [] {
+        std::array<uint64_t, Metrics::LatencyBuckets.size()> bounds{};
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            bounds[i] = static_cast<uint64_t>(Metrics::LatencyBuckets[i] * 1e9 + 0.5);
+        }
+        return bounds;
+    }();
+
+    constexpr std::array<const char *, 5> StatusClasses = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+
+    /**
+     * @brief Zamienia znaki specjalne wartości etykiety (\, ", nowa linia)
+     */
+    std::string escapeLabel(std::string_view value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c: value) {
+            switch (c) {
+                case '\\': escaped += "\\\\";
+                    break;
+                case '"': escaped += "\\\"";
+                    break;
+                case '\n': escaped += "\\n";
+                    break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    /**
+     * @brief Zsumowany histogram (przedziały nieskumulowane)
+     */
+    struct HistogramTotals {
+        std::array<uint64_t, Metrics::LatencyBuckets.size() + 1> buckets{};
+        uint64_t count = 0;
+        uint64_t sumNanos = 0;
+    };
+
+    void writeHistogram(std::ostringstream &out, const std::string &name, const std::string &labels,
+                        const HistogramTotals &totals) {
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < Metrics::LatencyBuckets.size(); ++i) {
+            cumulative += totals.buckets[i];
+            out << name << "_bucket{" << labels << ",le=\"" << Metrics::LatencyBuckets[i] << "\"} "
+                << cumulative << "\n";
+        }
+        out << name << "_bucket{" << labels << ",le=\"+Inf\"} " << totals.count << "\n";
+        out << name << "_sum{" << labels << "} " << static_cast<double>(totals.sumNanos) / 1e9 << "\n";
+        out << name << "_count{" << labels << "} " << totals.count << "\n";
+    }
+
+    void writeHeader(std::ostringstream &out, const char *name, const char *type, const char *help) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+    }
+}
+
+Metrics &Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+Metrics::Metrics() = default;
+
+void Metrics::Histogram::observe(uint64_t nanos) {
+    size_t bucket = std::lower_bound(BucketNanos.begin(), BucketNanos.end(), nanos) - BucketNanos.begin();
+    buckets[bucket].add(1);
+    count.add(1);
+    sumNanos.add(nanos);
+}
+
+Metrics::Shard &Metrics::localShard() {
+    // Fragment pozostaje w rejestrze po zakończeniu wątku, więc jego pomiary nie giną
+    thread_local Shard *shard = nullptr;
+    if (!shard) {
+        std::lock_guard lock(_mutex);
+        shard = _shards.emplace_back(std::make_unique<Shard>()).get();
+    }
+    return *shard;
+}
+
+int Metrics::registerSeries(SeriesNames &series, size_t limit, const std::string &name, bool allowNew) {
+    auto it = series.ids.find(name);
+    if (it != series.ids.end()) {
+        return it->second;
+    }
+    if (!allowNew || series.names.size() >= limit) {
+        return 0;
+    }
+    int id = static_cast<int>(series.names.size());
+    series.names.push_back(name);
+    series.ids.emplace(name, id);
+    return id;
+}
+
+int Metrics::requestSeries(std::string_view method, std::string_view route, int status) {
+    // Identyfikatory serii są zapamiętywane w wątku, więc blokada jest pobierana tylko raz na trasę
+    thread_local std::unordered_map<std::string, int> cache;
+
+    std::string key;
+    key.reserve(method.size() + 1 + route.size());
+    key.append(method).append(" ").append(route);
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    bool allowNew = status != 404 && status != 405;
+    int id;
+    {
+        std::lock_guard lock(_mutex);
+        id = registerSeries(_requests, MaxRequestSeries, key, allowNew);
+    }
+    if (id != 0 || allowNew) {
+        cache.emplace(std::move(key), id);
+    }
+    return id;
+}
+
+void Metrics::requestStarted() {
+    localShard().started.add(1);
+}
+
+void Metrics::requestFinished(int series, int status, uint64_t nanos, size_t bytes) {
+    Shard &shard = localShard();
+    shard.finished.add(1);
+    shard.requestLatency[series].observe(nanos);
+    shard.responseClasses[series][std::clamp(status / 100, 1, 5) - 1].add(1);
+    shard.responseBytes[series].add(bytes);
+}
+
+int Metrics::querySeries(std::string_view name) {
+    std::lock_guard lock(_mutex);
+    return registerSeries(_queries, MaxQuerySeries, std::string(name), true);
+}
+
+void Metrics::observeQuery(int series, uint64_t nanos) {
+    localShard().queryLatency[series].observe(nanos);
+}
+
+int Metrics::cacheSeries(std::string_view name) {
+    std::lock_guard lock(_mutex);
+    return registerSeries(_caches, MaxCacheSeries, std::string(name), true);
+}
+
+void Metrics::recordCache(int series, bool hit) {
+    Shard &shard = localShard();
+    (hit ? shard.cacheHits : shard.cacheMisses)[series].add(1);
+}
+
+std::string Metrics::scrape() const {
+    std::lock_guard lock(_mutex);
+
+    auto sumHistogram = [this](auto member, size_t series) {
+        HistogramTotals totals;
+        for (const auto &shard: _shards) {
+            const Histogram &histogram = ((*shard).*member)[series];
+            for (size_t i = 0; i < totals.buckets.size(); ++i) {
+                totals.buckets[i] += histogram.buckets[i].value();
+            }
+            totals.count += histogram.count.value();
+            totals.sumNanos += histogram.sumNanos.value();
+        }
+        return totals;
+    };
+
+    auto requestLabels = [this](size_t series) {
+        const std::string &name = _requests.names[series];
+        auto space = name.find(' ');
+        if (space == std::string::npos) {
+            return "method=\"\",route=\"" + escapeLabel(name) + "\"";
+        }
+        return "method=\"" + escapeLabel(name.substr(0, space)) + "\",route=\"" +
+               escapeLabel(name.substr(space + 1)) + "\"";
+    };
+
+    std::ostringstream out;
+    out.precision(9);
+
+    uint64_t started = 0, finished = 0;
+    for (const auto &shard: _shards) {
+        started += shard->started.value();
+        finished += shard->finished.value();
+    }
+    writeHeader(out, "deskpp_http_requests_in_flight", "gauge", "Liczba obsługiwanych żądań HTTP");
+    out << "deskpp_http_requests_in_flight " << (started >= finished ? started - finished : 0) << "\n";
+
+    // Zsumowane histogramy tras są potrzebne w trzech metrykach
+    std::vector<HistogramTotals> requestTotals;
+    for (size_t series = 0; series < _requests.names.size(); ++series) {
+        requestTotals.push_back(sumHistogram(&Shard::requestLatency, series));
+    }
+
+    writeHeader(out, "deskpp_http_request_duration_seconds", "histogram", "Czas obsługi żądań HTTP");
+    for (size_t series = 0; series < requestTotals.size(); ++series) {
+        if (requestTotals[series].count > 0) {
+            writeHistogram(out, "deskpp_http_request_duration_seconds", requestLabels(series), requestTotals[series]);
+        }
+    }
+
+    writeHeader(out, "deskpp_http_responses_total", "counter", "Liczba odpowiedzi HTTP według klasy kodu");
+    for (size_t series = 0; series < requestTotals.size(); ++series) {
+        for (size_t statusClass = 0; statusClass < StatusClasses.size(); ++statusClass) {
+            uint64_t count = 0;
+            for (const auto &shard: _shards) {
+                count += shard->responseClasses[series][statusClass].value();
+            }
+            if (count > 0) {
+                out << "deskpp_http_responses_total{" << requestLabels(series) << ",code=\""
+                    << StatusClasses[statusClass] << "\"} " << count << "\n";
+            }
+        }
+    }
+
+    writeHeader(out, "deskpp_http_response_size_bytes_total", "counter", "Łączny rozmiar odpowiedzi HTTP");
+    for (size_t series = 0; series < requestTotals.size(); ++series) {
+        if (requestTotals[series].count == 0) {
+            continue;
+        }
+        uint64_t bytes = 0;
+        for (const auto &shard: _shards) {
+            bytes += shard->responseBytes[series].value();
+        }
+        out << "deskpp_http_response_size_bytes_total{" << requestLabels(series) << "} " << bytes << "\n";
+    }
+
+    writeHeader(out, "deskpp_sqlite_query_duration_seconds", "histogram", "Czas zapytań SQLite metod repozytoriów");
+    for (size_t series = 0; series < _queries.names.size(); ++series) {
+        HistogramTotals totals = sumHistogram(&Shard::queryLatency, series);
+        if (totals.count > 0) {
+            writeHistogram(out, "deskpp_sqlite_query_duration_seconds",
+                           "query=\"" + escapeLabel(_queries.names[series]) + "\"", totals);
+        }
+    }
+
+    writeHeader(out, "deskpp_cache_requests_total", "counter", "Odwołania do pamięci podręcznych");
+    for (size_t series = 0; series < _caches.names.size(); ++series) {
+        uint64_t hits = 0, misses = 0;
+        for (const auto &shard: _shards) {
+            hits += shard->cacheHits[series].value();
+            misses += shard->cacheMisses[series].value();
+        }
+        if (hits + misses == 0) {
+            continue;
+        }
+        std::string cache = "cache=\"" + escapeLabel(_caches.names[series]) + "\"";
+        out << "deskpp_cache_requests_total{" << cache << ",result=\"hit\"} " << hits << "\n";
+        out << "deskpp_cache_requests_total{" << cache << ",result=\"miss\"} " << misses << "\n";
+    }
+
+    writeHeader(out, "deskpp_log_messages_dropped_total", "counter",
+                "Komunikaty logów odrzucone przy pełnej kolejce");
+    out << "deskpp_log_messages_dropped_total " << droppedLogMessages() << "\n";
+
+    auto arenas = RequestArena::totals();
+    writeHeader(out, "deskpp_request_arenas_total", "counter", "Zakończone areny żądań");
+    out << "deskpp_request_arenas_total " << arenas.arenas << "\n";
+    writeHeader(out, "deskpp_request_arena_allocations_total", "counter", "Przydziały z aren żądań");
+    out << "deskpp_request_arena_allocations_total " << arenas.allocations << "\n";
+    writeHeader(out, "deskpp_request_arena_bytes_total", "counter", "Bajty przydzielone z aren żądań");
+    out << "deskpp_request_arena_bytes_total " << arenas.bytes << "\n";
+    writeHeader(out, "deskpp_request_arena_overflow_blocks_total", "counter",
+                "Bloki dobrane ze sterty po zapełnieniu bloku areny");
+    out << "deskpp_request_arena_overflow_blocks_total " << arenas.overflowBlocks << "\n";
+
+    if (MemoryTracker::enabled()) {
+        auto memory = MemoryTracker::snapshot();
+        writeHeader(out, "deskpp_memory_bytes", "gauge", "Bieżąca pamięć przydzielona przez podsystem");
+        for (size_t i = 0; i < memory.size(); ++i) {
+            auto subsystem = MemoryTracker::name(static_cast<MemorySubsystem>(i));
+            out << "deskpp_memory_bytes{subsystem=\"" << subsystem << "\"} " << memory[i].currentBytes << "\n";
+        }
+        writeHeader(out, "deskpp_memory_peak_bytes", "gauge", "Szczytowa pamięć przydzielona przez podsystem");
+        for (size_t i = 0; i < memory.size(); ++i) {
+            auto subsystem = MemoryTracker::name(static_cast<MemorySubsystem>(i));
+            out << "deskpp_memory_peak_bytes{subsystem=\"" << subsystem << "\"} " << memory[i].peakBytes << "\n";
+        }
+        writeHeader(out, "deskpp_memory_allocations_total", "counter", "Przydziały pamięci podsystemu");
+        for (size_t i = 0; i < memory.size(); ++i) {
+            auto subsystem = MemoryTracker::name(static_cast<MemorySubsystem>(i));
+            out << "deskpp_memory_allocations_total{subsystem=\"" << subsystem << "\"} " << memory[i].allocations
+                << "\n";
+        }
+    }
+
+    return out.str();
+}
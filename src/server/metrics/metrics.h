@@ -0,0 +1,170 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class Metrics
+ * @brief Rejestr metryk serwera eksportowanych w formacie Prometheus.
+ *
+ * Każdy wątek zapisuje pomiary we własnym fragmencie (shard), do którego
+ * pisze tylko on, więc zapis to kilka zwykłych operacji atomowych bez
+ * blokad i bez współdzielenia linii pamięci podręcznej między wątkami.
+ * Fragmenty są sumowane dopiero przy odczycie (scrape).
+ *
+ * Serie (trasa HTTP, zapytanie repozytorium, pamięć podręczna) są
+ * rejestrowane przy pierwszym użyciu; po przekroczeniu limitu serii
+ * pomiary trafiają do serii "other".
+ */
+class Metrics {
+public:
+    /**
+     * @brief Zwraca instancję rejestru (wzorzec Singleton)
+     * @return Referencja do rejestru
+     */
+    static Metrics &instance();
+
+    Metrics(const Metrics &) = delete;
+    Metrics &operator=(const Metrics &) = delete;
+
+    /**
+     * @brief Zwraca serię żądań HTTP dla metody i trasy
+     *
+     * Nowa seria nie jest rejestrowana dla odpowiedzi 404 i 405, aby
+     * przypadkowe adresy nie wyczerpały limitu serii.
+     *
+     * @param method Metoda HTTP
+     * @param route Trasa z parametrami zastąpionymi przez <int>
+     * @param status Kod odpowiedzi
+     * @return Identyfikator serii
+     */
+    int requestSeries(std::string_view method, std::string_view route, int status);
+
+    /**
+     * @brief Odnotowuje rozpoczęcie obsługi żądania
+     */
+    void requestStarted();
+
+    /**
+     * @brief Odnotowuje zakończone żądanie
+     * @param series Identyfikator serii
+     * @param status Kod odpowiedzi
+     * @param nanos Czas obsługi w nanosekundach
+     * @param bytes Rozmiar ciała odpowiedzi
+     */
+    void requestFinished(int series, int status, uint64_t nanos, size_t bytes);
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) serię zapytania repozytorium
+     * @param name Nazwa w postaci tabela.metoda
+     * @return Identyfikator serii
+     */
+    int querySeries(std::string_view name);
+
+    /**
+     * @brief Odnotowuje czas wykonania zapytania
+     * @param series Identyfikator serii
+     * @param nanos Czas w nanosekundach
+     */
+    void observeQuery(int series, uint64_t nanos);
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) serię pamięci podręcznej
+     * @param name Nazwa pamięci podręcznej
+     * @return Identyfikator serii
+     */
+    int cacheSeries(std::string_view name);
+
+    /**
+     * @brief Odnotowuje trafienie lub chybienie pamięci podręcznej
+     * @param series Identyfikator serii
+     * @param hit Czy wynik był w pamięci podręcznej
+     */
+    void recordCache(int series, bool hit);
+
+    /**
+     * @brief Sumuje fragmenty wszystkich wątków i formatuje metryki
+     * @return Metryki w formacie tekstowym Prometheus
+     */
+    std::string scrape() const;
+
+    static constexpr size_t MaxRequestSeries = 64;
+    static constexpr size_t MaxQuerySeries = 96;
+    static constexpr size_t MaxCacheSeries = 16;
+
+    /**
+     * @brief Górne granice przedziałów histogramów czasu (w sekundach)
+     */
+    static constexpr std::array<double, 16> LatencyBuckets = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+        0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+    };
+
+private:
+    Metrics();
+
+    /**
+     * @brief Licznik zapisywany przez jeden wątek (bez operacji read-modify-write)
+     */
+    class Counter {
+    public:
+        void add(uint64_t value) {
+            _value.store(_value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> _value{0};
+    };
+
+    struct Histogram {
+        std::array<Counter, LatencyBuckets.size() + 1> buckets;
+        Counter count;
+        Counter sumNanos;
+
+        void observe(uint64_t nanos);
+    };
+
+    /**
+     * @brief Pomiary jednego wątku
+     */
+    struct alignas(64) Shard {
+        Counter started;
+        Counter finished;
+        std::array<Histogram, MaxRequestSeries> requestLatency;
+        std::array<std::array<Counter, 5>, MaxRequestSeries> responseClasses;
+        std::array<Counter, MaxRequestSeries> responseBytes;
+        std::array<Histogram, MaxQuerySeries> queryLatency;
+        std::array<Counter, MaxCacheSeries> cacheHits;
+        std::array<Counter, MaxCacheSeries> cacheMisses;
+    };
+
+    /**
+     * @brief Nazwy serii jednego rodzaju; seria 0 to "other"
+     */
+    struct SeriesNames {
+        std::vector<std::string> names{"other"};
+        std::unordered_map<std::string, int> ids;
+    };
+
+    Shard &localShard();
+    int registerSeries(SeriesNames &series, size_t limit, const std::string &name, bool allowNew);
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Shard>> _shards;
+    SeriesNames _requests;
+    SeriesNames _queries;
+    SeriesNames _caches;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "booking_record.h"
+#include <algorithm>
+#include <iterator>
+
+bool BookingBlock::overlaps(uint16_t from, uint16_t to) const {
+    auto next = std::upper_bound(_daysFrom.begin(), _daysFrom.end(), to);
+    if (next == _daysFrom.begin()) {
+        return false;
+    }
+    return _daysTo[std::distance(_daysFrom.begin(), next) - 1] >= from;
+}
+
+void BookingBlock::insert(const BookingRecord &record) {
+    auto position = std::distance(_daysFrom.begin(),
+                                  std::upper_bound(_daysFrom.begin(), _daysFrom.end(), record.dayFrom));
+    _daysFrom.insert(_daysFrom.begin() + position, record.dayFrom);
+    _daysTo.insert(_daysTo.begin() + position, record.dayTo);
+    _ids.insert(_ids.begin() + position, record.id);
+}
+
+bool BookingBlock::erase(int32_t id) {
+    auto it = std::find(_ids.begin(), _ids.end(), id);
+    if (it == _ids.end()) {
+        return false;
+    }
+    auto position = std::distance(_ids.begin(), it);
+    _daysFrom.erase(_daysFrom.begin() + position);
+    _daysTo.erase(_daysTo.begin() + position);
+    _ids.erase(it);
+    return true;
+}
+
+size_t BookingBlock::memoryBytes() const {
+    return _daysFrom.capacity() * sizeof(uint16_t) + _daysTo.capacity() * sizeof(uint16_t) +
+           _ids.capacity() * sizeof(int32_t);
+}
@@ -0,0 +1,193 @@
+#ifndef BOOKING_RECORD_H
+#define BOOKING_RECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "common/model/booking.h"
+#include "entity_mapping.h"
+
+/**
+ * @struct BookingRecord
+ * @brief Zwarty zapis rezerwacji używany przez repozytorium, serwisy i pamięci podręczne serwera.
+ *
+ * Rekord zajmuje 16 bajtów i jest trywialnie kopiowalny: daty są numerami
+ * dni od Epoch zapisanymi w 16 bitach, co obejmuje lata 2000-2179. Serwer
+ * nie przyjmuje rezerwacji spoza tego zakresu i nie uruchamia się z bazą,
+ * która je zawiera (BookingRepository::countOutOfRange), a odczyt takiego
+ * wiersza zgłasza wyjątek zamiast zmieniać daty. Tak samo traktowane są
+ * rezerwacje dłuższe niż MaxDays dni, bo stronicowanie rezerwacji
+ * użytkownika zakłada tę granicę. Na Booking rekord jest zamieniany dopiero
+ * przy budowie odpowiedzi API.
+ */
+struct BookingRecord {
+    int32_t id = 0;
+    int32_t deskId = 0;
+    int32_t userId = 0;
+    uint16_t dayFrom = 0; ///< Dzień początkowy (od Epoch)
+    uint16_t dayTo = 0;   ///< Dzień końcowy (od Epoch)
+
+    static constexpr Date Epoch = Date(2000, 1, 1);
+    static constexpr Date LastDate = Epoch.addDays(std::numeric_limits<uint16_t>::max());
+    static constexpr int MaxDays = 366; ///< Najdłuższa rezerwacja (w dniach)
+
+    /**
+     * @brief Sprawdza czy data mieści się w zakresie rekordu
+     * @param date Data
+     * @return Czy data jest poprawna i leży między Epoch a LastDate
+     */
+    static constexpr bool inRange(Date date) {
+        return date.isValid() && date >= Epoch && date <= LastDate;
+    }
+
+    /**
+     * @brief Sprawdza czy okres może być zapisany jako rezerwacja
+     * @param from Data początkowa
+     * @param to Data końcowa
+     * @return Czy obie daty mieszczą się w zakresie, from <= to, a okres nie przekracza MaxDays dni
+     */
+    static constexpr bool validPeriod(Date from, Date to) {
+        return inRange(from) && inRange(to) && from <= to && from.daysTo(to) < MaxDays;
+    }
+
+    /**
+     * @brief Zamienia datę na numer dnia rekordu
+     * @param date Data z zakresu (inRange); inna jest przycinana do granic zakresu
+     * @return Numer dnia od Epoch
+     */
+    static constexpr uint16_t dayOf(Date date) {
+        if (date <= Epoch) {
+            return 0;
+        }
+        if (date >= LastDate) {
+            return std::numeric_limits<uint16_t>::max();
+        }
+        return static_cast<uint16_t>(date.toDays() - Epoch.toDays());
+    }
+
+    /**
+     * @brief Zamienia numer dnia rekordu na datę
+     * @param day Numer dnia od Epoch
+     * @return Data
+     */
+    static constexpr Date dateOf(uint16_t day) { return Date::fromDays(Epoch.toDays() + day); }
+
+    constexpr Date dateFrom() const { return dateOf(dayFrom); }
+    constexpr Date dateTo() const { return dateOf(dayTo); }
+
+    /**
+     * @brief Sprawdza czy rezerwacja obejmuje część okresu
+     * @param from Dzień początkowy okresu
+     * @param to Dzień końcowy okresu
+     * @return Czy okresy mają wspólny dzień
+     */
+    constexpr bool overlaps(uint16_t from, uint16_t to) const { return dayFrom <= to && dayTo >= from; }
+
+    /**
+     * @brief Tworzy rekord z encji rezerwacji
+     * @param booking Rezerwacja z datami z zakresu (inRange)
+     * @return Rekord
+     */
+    static BookingRecord fromBooking(const Booking &booking) {
+        return {booking.getId(), booking.getDeskId(), booking.getUserId(),
+                dayOf(booking.getDateFrom()), dayOf(booking.getDateTo())};
+    }
+
+    /**
+     * @brief Tworzy encję rezerwacji (do odpowiedzi API)
+     * @return Rezerwacja
+     */
+    Booking toBooking() const { return Booking(id, deskId, userId, dateFrom(), dateTo()); }
+
+    /**
+     * @brief Konwertuje rekord na dokument JSON wskazanego typu (jak Booking::toJsonAs)
+     * @tparam BasicJson Specjalizacja nlohmann::basic_json (np. z innym alokatorem)
+     * @return Reprezentacja JSON rezerwacji
+     */
+    template<typename BasicJson>
+    BasicJson toJsonAs() const {
+        return toBooking().toJsonAs<BasicJson>();
+    }
+};
+
+static_assert(sizeof(BookingRecord) == 16);
+static_assert(std::is_trivially_copyable_v<BookingRecord>);
+static_assert(BookingRecord::dateOf(BookingRecord::dayOf(Date(2179, 6, 6))) == Date(2179, 6, 6));
+
+/**
+ * @brief Odczyt wiersza tabeli rezerwacji (kolumny encji Booking) jako rekordu
+ *
+ * Wiersz z datą spoza zakresu rekordu (zapisany z pominięciem serwera)
+ * zgłasza wyjątek, aby odpowiedzi i sprawdzanie konfliktów nie działały
+ * na zmienionych datach.
+ */
+template<>
+struct RowReader<BookingRecord> {
+    static BookingRecord read(SQLite::Statement &query) {
+        Booking booking = entityFromRow<Booking>(query);
+        if (!BookingRecord::inRange(booking.getDateFrom()) || !BookingRecord::inRange(booking.getDateTo())) {
+            throw std::out_of_range("Rezerwacja " + std::to_string(booking.getId()) +
+                                    " ma datę spoza obsługiwanego zakresu");
+        }
+        return BookingRecord::fromBooking(booking);
+    }
+};
+
+/**
+ * @class BookingBlock
+ * @brief Rezerwacje jednego biurka w układzie kolumnowym (structure of arrays).
+ *
+ * Kolumny dni początkowych, dni końcowych i identyfikatorów są uporządkowane
+ * według dnia początkowego. Rezerwacja biurka zajmuje w bloku 8 bajtów,
+ * a przeglądanie kolumny dni odczytuje tylko potrzebne dane.
+ */
+class BookingBlock {
+public:
+    /**
+     * @brief Sprawdza czy któraś rezerwacja nakłada się na okres
+     *
+     * Rezerwacje biurka się nie nakładają, więc wystarczy sprawdzić ostatnią
+     * zaczynającą się najpóźniej w dniu 'to'.
+     *
+     * @param from Dzień początkowy okresu
+     * @param to Dzień końcowy okresu
+     * @return Czy okres jest zajęty
+     */
+    bool overlaps(uint16_t from, uint16_t to) const;
+
+    /**
+     * @brief Dodaje rezerwację z zachowaniem porządku
+     * @param record Rekord rezerwacji tego biurka
+     */
+    void insert(const BookingRecord &record);
+
+    /**
+     * @brief Usuwa rezerwację
+     * @param id Identyfikator rezerwacji
+     * @return Czy rezerwacja była w bloku
+     */
+    bool erase(int32_t id);
+
+    /**
+     * @brief Zwraca pamięć zajmowaną przez kolumny bloku
+     * @return Liczba bajtów
+     */
+    size_t memoryBytes() const;
+
+    size_t size() const { return _ids.size(); }
+    std::span<const int32_t> ids() const { return _ids; }
+    std::span<const uint16_t> daysFrom() const { return _daysFrom; }
+    std::span<const uint16_t> daysTo() const { return _daysTo; }
+
+private:
+    std::vector<uint16_t> _daysFrom;
+    std::vector<uint16_t> _daysTo;
+    std::vector<int32_t> _ids;
+};
+
+#endif
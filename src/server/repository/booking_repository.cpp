@@ -1,77 +1,146 @@
 #include "booking_repository.h"
 
+/**
+ * @brief Połączenie zapisu wraz z repozytorium działającym na nim
+ */
+struct BookingRepository::WriteSession {
+    explicit WriteSession(const std::string &databasePath)
+        : db(openWriteConnection(databasePath)), repository(db) {
+    }
+
+    std::shared_ptr<SQLite::Database> db;
+    BookingRepository repository;
+};
+
 BookingRepository::BookingRepository(std::shared_ptr<SQLite::Database> db)
-    : SQLiteRepository<Booking>(
-        db,
-        "bookings",
-        "SELECT id, desk_id, user_id, date, date_to FROM bookings ORDER BY date",
-        "SELECT id, desk_id, user_id, date, date_to FROM bookings WHERE id = ?",
-        "INSERT INTO bookings (desk_id, user_id, date, date_to) VALUES (?, ?, ?, ?)",
-        "UPDATE bookings SET desk_id = ?, user_id = ?, date = ?, date_to = ? WHERE id = ?",
-        "DELETE FROM bookings WHERE id = ?",
-        bookingFromRow,
-        [](SQLite::Statement &stmt, const Booking &booking) {
-            stmt.bind(1, booking.getDeskId());
-            stmt.bind(2, booking.getUserId());
-            stmt.bind(3, booking.getDateFromString());
-            stmt.bind(4, booking.getDateToString());
-        }
-    ) {
+    : SQLiteRepository<Booking>(std::move(db)) {
 }
 
-Booking BookingRepository::bookingFromRow(SQLite::Statement &query) {
-    return Booking(
-        query.getColumn(0).getInt(),
-        query.getColumn(1).getInt(),
-        query.getColumn(2).getInt(),
-        query.getColumn(3).getString(),
-        query.getColumn(4).getString()
-    );
+BookingRepository::~BookingRepository() = default;
+
+std::shared_ptr<SQLite::Database> BookingRepository::openWriteConnection(const std::string &databasePath) {
+    auto db = std::make_shared<SQLite::Database>(databasePath, SQLite::OPEN_READWRITE);
+    db->exec("PRAGMA journal_mode = WAL");
+    db->setBusyTimeout(WriteBusyTimeoutMs);
+    return db;
 }
 
-std::vector<Booking> BookingRepository::findByDeskId(int deskId) {
-    std::vector<Booking> bookings;
-    SQLite::Statement query(*_db, "SELECT id, desk_id, user_id, date, date_to "
-                            "FROM bookings WHERE desk_id = ? ORDER BY date");
-    query.bind(1, deskId);
+BookingRepository::WriteTransaction BookingRepository::beginWrite() {
+    std::unique_ptr<WriteSession> session;
+    {
+        std::lock_guard lock(_sessionsMutex);
+        if (!_idleSessions.empty()) {
+            session = std::move(_idleSessions.back());
+            _idleSessions.pop_back();
+        }
+    }
+    if (!session) {
+        session = std::make_unique<WriteSession>(_db->getFilename());
+    }
+    return WriteTransaction(*this, std::move(session));
+}
 
-    while (query.executeStep()) {
-        bookings.push_back(bookingFromRow(query));
+BookingRepository::WriteTransaction::WriteTransaction(BookingRepository &owner, std::unique_ptr<WriteSession> session)
+    : _owner(owner), _session(std::move(session)) {
+    _session->db->exec("BEGIN IMMEDIATE");
+}
+
+BookingRepository::WriteTransaction::~WriteTransaction() {
+    if (!_committed) {
+        try {
+            _session->db->exec("ROLLBACK");
+        } catch (const std::exception &) {
+            // Połączenie w nieznanym stanie nie wraca do puli
+            return;
+        }
     }
-    return bookings;
+    std::lock_guard lock(_owner._sessionsMutex);
+    _owner._idleSessions.push_back(std::move(_session));
 }
 
-std::vector<Booking> BookingRepository::findByUserId(int userId) {
-    std::vector<Booking> bookings;
-    SQLite::Statement query(*_db, "SELECT id, desk_id, user_id, date, date_to "
-                            "FROM bookings WHERE user_id = ? ORDER BY date");
-    query.bind(1, userId);
+BookingRepository &BookingRepository::WriteTransaction::repository() {
+    return _session->repository;
+}
 
-    while (query.executeStep()) {
-        bookings.push_back(bookingFromRow(query));
+void BookingRepository::WriteTransaction::commit() {
+    _session->db->exec("COMMIT");
+    _committed = true;
+}
+
+std::vector<BookingRecord> BookingRepository::findByDeskId(int deskId) {
+    return cursorByDeskId(deskId).collect();
+}
+
+std::vector<BookingRecord> BookingRepository::findByUserId(int userId) {
+    return cursorByUserId(userId).collect();
+}
+
+Cursor<BookingRecord> BookingRepository::cursorByDeskId(int deskId) {
+    static constexpr const char *sql = Sql::select<"WHERE desk_id = ? ORDER BY date">.c_str();
+    static auto &profile = QueryProfiler::instance().entry("bookings.cursorByDeskId", sql);
+    auto cursor = openCursor<BookingRecord>(sql, profile);
+    cursor.statement().bind(1, deskId);
+    return cursor;
+}
+
+Cursor<BookingRecord> BookingRepository::cursorByUserId(int userId) {
+    static constexpr const char *sql = Sql::select<"WHERE user_id = ? ORDER BY date">.c_str();
+    static auto &profile = QueryProfiler::instance().entry("bookings.cursorByUserId", sql);
+    auto cursor = openCursor<BookingRecord>(sql, profile);
+    cursor.statement().bind(1, userId);
+    return cursor;
+}
+
+std::vector<BookingRecord> BookingRepository::findPageByUserId(int userId, const std::string &fromDate,
+                                                               const std::string &afterDate, int afterId,
+                                                               int limit) {
+    static constexpr const char *sql = Sql::select<"WHERE user_id = ? AND date_to >= ? AND (date, id) > (?, ?) "
+                                                   "ORDER BY date, id LIMIT ?">.c_str();
+    static auto &profile = QueryProfiler::instance().entry("bookings.findPageByUserId", sql);
+
+    // Rezerwacja trwająca w dniu fromDate zaczęła się najwyżej MaxDays - 1 dni wcześniej, więc
+    // klucz startowy przesuwa się za starszą historię użytkownika (identyfikatory są dodatnie)
+    std::string startDate = afterDate;
+    int startId = afterId;
+    if (Date from = Date::fromString(fromDate); from.isValid()) {
+        std::string earliestStart = from.addDays(1 - BookingRecord::MaxDays).toString();
+        if (earliestStart > startDate) {
+            startDate = std::move(earliestStart);
+            startId = 0;
+        }
     }
-    return bookings;
+
+    auto cursor = openCursor<BookingRecord>(sql, profile);
+    cursor.statement().bind(1, userId);
+    cursor.statement().bind(2, fromDate);
+    cursor.statement().bind(3, startDate);
+    cursor.statement().bind(4, startId);
+    cursor.statement().bind(5, limit);
+    return cursor.collect();
 }
 
-std::vector<Booking> BookingRepository::findByDateRange(int deskId, const std::string &dateFrom,
-                                                        const std::string &dateTo) {
-    std::vector<Booking> bookings;
-    SQLite::Statement query(*_db, "SELECT id, desk_id, user_id, date, date_to "
-                            "FROM bookings WHERE desk_id = ? AND NOT (date_to < ? OR date > ?) "
-                            "ORDER BY date");
+std::vector<BookingRecord> BookingRepository::findByDateRange(int deskId, const std::string &dateFrom,
+                                                              const std::string &dateTo) {
+    static constexpr const char *sql = Sql::select<"WHERE desk_id = ? AND date_to >= ? AND date <= ? "
+                                                   "ORDER BY date">.c_str();
+    PROFILE_QUERY(*_db, "bookings.findByDateRange", sql);
+    std::vector<BookingRecord> bookings;
+    SQLite::Statement query(*_db, sql);
     query.bind(1, deskId);
     query.bind(2, dateFrom);
     query.bind(3, dateTo);
 
     while (query.executeStep()) {
-        bookings.push_back(bookingFromRow(query));
+        bookings.push_back(RowReader<BookingRecord>::read(query));
     }
     return bookings;
 }
 
 bool BookingRepository::hasOverlappingBooking(int deskId, const std::string &dateFrom, const std::string &dateTo) {
-    SQLite::Statement query(*_db, "SELECT COUNT(*) FROM bookings "
-                            "WHERE desk_id = ? AND NOT (date_to < ? OR date > ?)");
+    static constexpr const char *sql = "SELECT COUNT(*) FROM bookings "
+                                       "WHERE desk_id = ? AND date_to >= ? AND date <= ?";
+    PROFILE_QUERY(*_db, "bookings.hasOverlappingBooking", sql);
+    SQLite::Statement query(*_db, sql);
     query.bind(1, deskId);
     query.bind(2, dateFrom);
     query.bind(3, dateTo);
@@ -81,3 +150,62 @@ bool BookingRepository::hasOverlappingBooking(int deskId, const std::string &dat
     }
     return false;
 }
+
+int64_t BookingRepository::countOutOfRange() {
+    static constexpr const char *sql = "SELECT COUNT(*) FROM bookings "
+                                       "WHERE date NOT BETWEEN ? AND ? OR date_to NOT BETWEEN ? AND ? "
+                                       "OR julianday(date_to) - julianday(date) >= ?";
+    PROFILE_QUERY(*_db, "bookings.countOutOfRange", sql);
+    SQLite::Statement query(*_db, sql);
+    std::string first = BookingRecord::Epoch.toString();
+    std::string last = BookingRecord::LastDate.toString();
+    query.bind(1, first);
+    query.bind(2, last);
+    query.bind(3, first);
+    query.bind(4, last);
+    query.bind(5, BookingRecord::MaxDays);
+
+    if (query.executeStep()) {
+        return query.getColumn(0).getInt64();
+    }
+    return 0;
+}
+
+std::optional<std::string> BookingRepository::findIdempotentResponse(const std::string &scope,
+                                                                    const std::string &key) {
+    static constexpr const char *sql = "SELECT response FROM idempotency_keys WHERE scope = ? AND key = ?";
+    PROFILE_QUERY(*_db, "idempotency_keys.find", sql);
+    SQLite::Statement query(*_db, sql);
+    query.bind(1, scope);
+    query.bind(2, key);
+
+    if (query.executeStep()) {
+        return query.getColumn(0).getString();
+    }
+    return std::nullopt;
+}
+
+void BookingRepository::saveIdempotentResponse(const std::string &scope, const std::string &key,
+                                               const std::string &response) {
+    static constexpr const char *sql = "INSERT OR IGNORE INTO idempotency_keys (scope, key, response) "
+                                       "VALUES (?, ?, ?)";
+    PROFILE_QUERY(*_db, "idempotency_keys.save", sql);
+    SQLite::Statement query(*_db, sql);
+    query.bind(1, scope);
+    query.bind(2, key);
+    query.bind(3, response);
+    query.exec();
+
+    // Pierwszy zapis po uruchomieniu także usuwa przeterminowane klucze
+    if (_savedKeys.fetch_add(1, std::memory_order_relaxed) % PruneInterval == 0) {
+        pruneIdempotentResponses();
+    }
+}
+
+void BookingRepository::pruneIdempotentResponses(std::chrono::hours retention) {
+    static constexpr const char *sql = "DELETE FROM idempotency_keys WHERE created_at < datetime('now', ?)";
+    PROFILE_QUERY(*_db, "idempotency_keys.prune", sql);
+    SQLite::Statement query(*_db, sql);
+    query.bind(1, "-" + std::to_string(retention.count()) + " hours");
+    query.exec();
+}
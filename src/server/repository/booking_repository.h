@@ -2,15 +2,21 @@
 #define BOOKING_REPOSITORY_H
 
 #include "sqlite_repository.h"
+#include "booking_record.h"
 #include "common/model/booking.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 /**
  * @class BookingRepository
  * @brief Repozytorium do zarządzania rezerwacjami w bazie danych.
  *
  * Zapewnia operacje CRUD na rezerwacjach oraz dodatkowe funkcje
- * do wyszukiwania i weryfikacji rezerwacji.
+ * do wyszukiwania i weryfikacji rezerwacji. Wyszukiwania zwracają
+ * zwarte rekordy BookingRecord zamiast encji.
  */
 class BookingRepository : public SQLiteRepository<Booking> {
 public:
@@ -20,29 +26,68 @@ public:
      */
     explicit BookingRepository(std::shared_ptr<SQLite::Database> db);
 
+    /**
+     * @brief Destruktor (zamyka połączenia zapisu)
+     */
+    ~BookingRepository() override;
+
     /**
      * @brief Wyszukuje rezerwacje dla wybranego biurka
      * @param deskId Identyfikator biurka
-     * @return Wektor rezerwacji
+     * @return Wektor rekordów rezerwacji
      */
-    std::vector<Booking> findByDeskId(int deskId);
+    std::vector<BookingRecord> findByDeskId(int deskId);
 
     /**
      * @brief Wyszukuje rezerwacje dla wybranego użytkownika
      * @param userId Identyfikator użytkownika
-     * @return Wektor rezerwacji
+     * @return Wektor rekordów rezerwacji
+     */
+    std::vector<BookingRecord> findByUserId(int userId);
+
+    /**
+     * @brief Otwiera kursor po rezerwacjach wybranego biurka
+     * @param deskId Identyfikator biurka
+     * @return Kursor po rekordach rezerwacji posortowanych po dacie
+     */
+    Cursor<BookingRecord> cursorByDeskId(int deskId);
+
+    /**
+     * @brief Otwiera kursor po rezerwacjach wybranego użytkownika
+     * @param userId Identyfikator użytkownika
+     * @return Kursor po rekordach rezerwacji posortowanych po dacie
+     */
+    Cursor<BookingRecord> cursorByUserId(int userId);
+
+    /**
+     * @brief Pobiera stronę rezerwacji użytkownika uporządkowanych po dacie
+     *
+     * Strony są wyznaczane kluczem (data, id) ostatniej rezerwacji poprzedniej
+     * strony. Filtr fromDate dotyczy daty zakończenia, więc rezerwacja
+     * wielodniowa trwająca w dniu fromDate też trafia na stronę. Rezerwacja
+     * trwa najwyżej BookingRecord::MaxDays dni, więc indeks (user_id, date)
+     * pomija historię zaczynającą się wcześniej niż tyle dni przed fromDate
+     * i koszt strony nie zależy od liczby starszych rezerwacji użytkownika.
+     *
+     * @param userId Identyfikator użytkownika
+     * @param fromDate Najwcześniejsza data zakończenia rezerwacji (pusta - bez ograniczenia)
+     * @param afterDate Data ostatniej rezerwacji poprzedniej strony (pusta - pierwsza strona)
+     * @param afterId Identyfikator ostatniej rezerwacji poprzedniej strony
+     * @param limit Maksymalna liczba rezerwacji
+     * @return Wektor rekordów rezerwacji
      */
-    std::vector<Booking> findByUserId(int userId);
+    std::vector<BookingRecord> findPageByUserId(int userId, const std::string &fromDate,
+                                                const std::string &afterDate, int afterId, int limit);
 
     /**
      * @brief Wyszukuje rezerwacje dla biurka w określonym okresie
      * @param deskId Identyfikator biurka
      * @param dateFrom Data początkowa
      * @param dateTo Data końcowa
-     * @return Wektor rezerwacji
+     * @return Wektor rekordów rezerwacji
      */
-    std::vector<Booking> findByDateRange(int deskId, const std::string &dateFrom,
-                                         const std::string &dateTo);
+    std::vector<BookingRecord> findByDateRange(int deskId, const std::string &dateFrom,
+                                               const std::string &dateTo);
 
     /**
      * @brief Sprawdza czy istnieje nakładająca się rezerwacja
@@ -53,13 +98,134 @@ public:
      */
     bool hasOverlappingBooking(int deskId, const std::string &dateFrom, const std::string &dateTo);
 
+    /**
+     * @brief Liczy rezerwacje z datami spoza zakresu BookingRecord lub dłuższe niż BookingRecord::MaxDays dni
+     *
+     * Serwer przechowuje rezerwacje jako BookingRecord i zakłada najdłuższy
+     * okres rezerwacji przy stronicowaniu, więc takie wiersze (np. zapisane
+     * przez starszą wersję) trzeba poprawić przed uruchomieniem.
+     *
+     * @return Liczba rezerwacji
+     */
+    int64_t countOutOfRange();
+
 private:
+    struct WriteSession;
+
+public:
     /**
-     * @brief Konwertuje wiersz z bazy na obiekt rezerwacji
-     * @param query Zapytanie SQL z wynikami
-     * @return Obiekt rezerwacji
+     * @class WriteTransaction
+     * @brief Transakcja zapisu na osobnym połączeniu z bazą.
+     *
+     * Transakcja pobiera połączenie z puli połączeń zapisu repozytorium
+     * (po jednym na równocześnie zapisujący wątek) i zaczyna się od
+     * BEGIN IMMEDIATE, więc blokadę zapisu SQLite zajmuje od razu. Zapisy
+     * innych wątków na połączeniu współdzielonym nie dołączają do niej,
+     * a odczyty nie widzą niezatwierdzonych zmian. Zmiany w transakcji
+     * wykonuje repository(). Transakcja niezatwierdzona przed zniszczeniem
+     * jest wycofywana.
      */
-    static Booking bookingFromRow(SQLite::Statement &query);
+    class WriteTransaction {
+    public:
+        /**
+         * @brief Destruktor (wycofuje niezatwierdzoną transakcję i zwraca połączenie do puli)
+         */
+        ~WriteTransaction();
+
+        WriteTransaction(const WriteTransaction &) = delete;
+        WriteTransaction &operator=(const WriteTransaction &) = delete;
+
+        /**
+         * @brief Zwraca repozytorium działające na połączeniu transakcji
+         * @return Repozytorium rezerwacji
+         */
+        BookingRepository &repository();
+
+        /**
+         * @brief Zatwierdza transakcję
+         */
+        void commit();
+
+    private:
+        friend class BookingRepository;
+
+        WriteTransaction(BookingRepository &owner, std::unique_ptr<WriteSession> session);
+
+        BookingRepository &_owner;
+        std::unique_ptr<WriteSession> _session;
+        bool _committed = false;
+    };
+
+    /**
+     * @brief Rozpoczyna transakcję zapisu (np. rezerwacji razem z kluczem idempotencji)
+     *
+     * Wymaga bazy w pliku (połączenia zapisu otwierają ten sam plik).
+     *
+     * @return Transakcja zapisu
+     */
+    WriteTransaction beginWrite();
+
+    /**
+     * @brief Otwiera połączenie z bazą przeznaczone do zapisów
+     *
+     * Włącza tryb WAL, aby odczyty na innych połączeniach nie czekały
+     * na zatwierdzenie zapisu, oraz czekanie na blokadę zapisu.
+     *
+     * @param databasePath Ścieżka do pliku bazy danych
+     * @return Połączenie z bazą danych
+     */
+    static std::shared_ptr<SQLite::Database> openWriteConnection(const std::string &databasePath);
+
+    /**
+     * @brief Zwraca zakres kluczy idempotencji użytkownika (dodawanie rezerwacji)
+     * @param userId Identyfikator użytkownika
+     * @return Zakres klucza
+     */
+    static std::string userKeyScope(int userId) { return "user:" + std::to_string(userId); }
+
+    /**
+     * @brief Zwraca zakres kluczy idempotencji rezerwacji (anulowanie)
+     *
+     * Żądanie anulowania nie wskazuje użytkownika; rezerwacja ma jednego właściciela.
+     *
+     * @param bookingId Identyfikator rezerwacji
+     * @return Zakres klucza
+     */
+    static std::string bookingKeyScope(int bookingId) { return "booking:" + std::to_string(bookingId); }
+
+    /**
+     * @brief Wyszukuje zapisaną odpowiedź dla klucza idempotencji
+     * @param scope Zakres klucza (userKeyScope lub bookingKeyScope)
+     * @param key Klucz idempotencji
+     * @return Opcjonalna odpowiedź (brak, jeśli klucz nie był użyty)
+     */
+    std::optional<std::string> findIdempotentResponse(const std::string &scope, const std::string &key);
+
+    /**
+     * @brief Zapisuje odpowiedź dla klucza idempotencji
+     *
+     * Co PruneInterval zapisów usuwane są klucze starsze niż KeyRetention.
+     *
+     * @param scope Zakres klucza (userKeyScope lub bookingKeyScope)
+     * @param key Klucz idempotencji
+     * @param response Odpowiedź do zwrócenia przy ponowieniu żądania
+     */
+    void saveIdempotentResponse(const std::string &scope, const std::string &key, const std::string &response);
+
+    /**
+     * @brief Usuwa przeterminowane klucze idempotencji
+     * @param retention Czas przechowywania klucza
+     */
+    void pruneIdempotentResponses(std::chrono::hours retention = KeyRetention);
+
+    static constexpr std::chrono::hours KeyRetention{72};
+    static constexpr uint32_t PruneInterval = 1024;
+    static constexpr int WriteBusyTimeoutMs = 5000;
+
+private:
+    std::mutex _sessionsMutex;
+    std::vector<std::unique_ptr<WriteSession>> _idleSessions; ///< Wolne połączenia zapisu
+    std::atomic<uint32_t> _savedKeys{0};
 };
 
 #endif
@@ -26,14 +26,6 @@ public:
      * @return Opcjonalny obiekt budynku (brak w przypadku nieznalezienia)
      */
     std::optional<Building> findByName(const std::string &name);
-
-private:
-    /**
-     * @brief Konwertuje wiersz z bazy na obiekt budynku
-     * @param query Zapytanie SQL z wynikami
-     * @return Obiekt budynku
-     */
-    static Building buildingFromRow(SQLite::Statement &query);
 };
 
 #endif
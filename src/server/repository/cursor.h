@@ -0,0 +1,159 @@
+#ifndef CURSOR_H
+#define CURSOR_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "entity_mapping.h"
+#include "query_profiler.h"
+
+/**
+ * @class Cursor
+ * @brief Strumieniowy odczyt encji z otwartego zapytania SQLite.
+ *
+ * Kolejne wiersze są pobierane dopiero przy przejściu do następnej encji,
+ * więc przetwarzanie może zacząć się przed odczytaniem ostatniego wiersza,
+ * a zużycie pamięci nie zależy od liczby wyników. Kursor można przejść
+ * tylko raz, w pętli for lub wywołaniami next().
+ *
+ * Czas pobierania wierszy (bez przetwarzania encji przez wywołującego) jest
+ * sumowany i zapisywany w profilerze zapytań przy zniszczeniu kursora.
+ * W śledzonym żądaniu kursor jest odcinkiem śladu od otwarcia do zniszczenia.
+ * Wiersze są mapowane na encje według EntityTraits (lub specjalizacji
+ * RowReader), bez wywołań pośrednich.
+ *
+ * @tparam T Typ encji lub rekordu
+ */
+template<typename T>
+class Cursor {
+public:
+    /**
+     * @class Iterator
+     * @brief Iterator wejściowy po encjach kursora.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        Iterator() = default;
+
+        explicit Iterator(Cursor *cursor) : _cursor(cursor) {
+            advance();
+        }
+
+        reference operator*() const { return *_current; }
+        pointer operator->() const { return &*_current; }
+
+        Iterator &operator++() {
+            advance();
+            return *this;
+        }
+
+        void operator++(int) { advance(); }
+
+        bool operator==(std::default_sentinel_t) const { return !_current; }
+
+    private:
+        void advance() {
+            _current = _cursor->next();
+        }
+
+        Cursor *_cursor = nullptr;
+        std::optional<T> _current;
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param query Przygotowane zapytanie z powiązanymi parametrami (kolumny w kolejności pól encji)
+     * @param profile Wpis profilera zapytania (nullptr - bez pomiaru)
+     * @param db Połączenie wykonujące zapytanie (wymagane z wpisem profilera)
+     */
+    explicit Cursor(std::unique_ptr<SQLite::Statement> query,
+                    QueryProfiler::Entry *profile = nullptr, SQLite::Database *db = nullptr)
+        : _query(std::move(query)), _profile(profile), _db(db) {
+        if (_profile) {
+            _span = TraceSpan(_profile->name);
+        }
+    }
+
+    Cursor(Cursor &&) noexcept = default;
+    Cursor &operator=(Cursor &&) noexcept = default;
+
+    ~Cursor() {
+        if (_query && _profile && _stepped) {
+            QueryProfiler::instance().record(*_profile, _stepNanos, *_db);
+        }
+    }
+
+    /**
+     * @brief Odczytuje kolejną encję
+     * @return Encja lub brak, jeśli wyniki się skończyły
+     */
+    std::optional<T> next() {
+        MEMORY_SCOPE(Repository);
+        if (_done || !step()) {
+            _done = true;
+            return std::nullopt;
+        }
+        ++_count;
+        return RowReader<T>::read(*_query);
+    }
+
+    /**
+     * @brief Odczytuje pozostałe encje do wektora
+     * @return Wektor encji
+     */
+    std::vector<T> collect() {
+        std::vector<T> entities;
+        while (auto entity = next()) {
+            entities.push_back(std::move(*entity));
+        }
+        return entities;
+    }
+
+    /**
+     * @brief Zwraca zapytanie kursora (np. do powiązania parametrów przed odczytem)
+     * @return Zapytanie SQLite
+     */
+    SQLite::Statement &statement() { return *_query; }
+
+    /**
+     * @brief Zwraca liczbę odczytanych dotąd encji
+     * @return Liczba encji
+     */
+    size_t count() const { return _count; }
+
+    Iterator begin() { return Iterator(this); }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    bool step() {
+        if (!_profile) {
+            return _query->executeStep();
+        }
+        auto start = std::chrono::steady_clock::now();
+        bool hasRow = _query->executeStep();
+        _stepNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        _stepped = true;
+        return hasRow;
+    }
+
+    std::unique_ptr<SQLite::Statement> _query;
+    size_t _count = 0;
+    bool _done = false;
+    QueryProfiler::Entry *_profile = nullptr;
+    SQLite::Database *_db = nullptr;
+    bool _stepped = false;
+    uint64_t _stepNanos = 0;
+    TraceSpan _span;
+};
+
+#endif
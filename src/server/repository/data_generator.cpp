@@ -0,0 +1,419 @@
+#include "data_generator.h"
+#include "booking_record.h"
+#include "user_repository.h"
+#include "common/logger.h"
+#include "common/model/date.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Liczba wierszy wstawianych jednym zapytaniem
+     */
+    constexpr int RowsPerInsert = 64;
+
+    /**
+     * @brief Przywraca tryb dziennika i synchronizacji bazy przy wyjściu z zakresu, także po wyjątku
+     */
+    class DurabilitySettings {
+    public:
+        explicit DurabilitySettings(SQLite::Database &db)
+            : _db(db), _journalMode(db.execAndGet("PRAGMA journal_mode").getString()),
+              _synchronous(db.execAndGet("PRAGMA synchronous").getInt()) {
+        }
+
+        ~DurabilitySettings() {
+            try {
+                _db.exec("PRAGMA synchronous = " + std::to_string(_synchronous));
+                _db.exec("PRAGMA journal_mode = " + _journalMode);
+            } catch (const SQLite::Exception &e) {
+                LOG_ERROR("Nie można przywrócić ustawień dziennika bazy: {}", e.what());
+            }
+        }
+
+        DurabilitySettings(const DurabilitySettings &) = delete;
+        DurabilitySettings &operator=(const DurabilitySettings &) = delete;
+
+    private:
+        SQLite::Database &_db;
+        std::string _journalMode;
+        int _synchronous;
+    };
+
+    /**
+     * @brief Względne obłożenie biurek od poniedziałku do niedzieli
+     */
+    constexpr std::array<double, 7> WeekdayLoad = {0.9, 1.0, 1.0, 0.95, 0.7, 0.04, 0.02};
+
+    const std::array<const char *, 8> Streets = {
+        "Krakowska", "Warszawska", "Pomorska", "Marszałkowska",
+        "Piotrkowska", "Długa", "Mickiewicza", "Słowackiego"
+    };
+
+    const std::array<const char *, 6> Cities = {
+        "Warszawa", "Kraków", "Gdańsk", "Wrocław", "Poznań", "Łódź"
+    };
+
+    Date parseDate(const std::string &text) {
+        Date date = Date::fromString(text);
+        if (!date.isValid()) {
+            throw std::invalid_argument("Nieprawidłowa data początkowa: " + text);
+        }
+        if (!BookingRecord::inRange(date)) {
+            throw std::invalid_argument("Data początkowa spoza zakresu rezerwacji (" +
+                                        BookingRecord::Epoch.toString() + " - " +
+                                        BookingRecord::LastDate.toString() + "): " + text);
+        }
+        return date;
+    }
+
+    /**
+     * @brief Nazwa budynku dla kolejnego indeksu: A, B, ..., Z, AA, AB, ...
+     */
+    std::string buildingCode(int index) {
+        std::string code;
+        for (int i = index + 1; i > 0; i = (i - 1) / 26) {
+            code.insert(code.begin(), static_cast<char>('A' + (i - 1) % 26));
+        }
+        return code;
+    }
+
+    /**
+     * @class DateStrings
+     * @brief Tekstowe reprezentacje kolejnych dni od daty początkowej.
+     *
+     * Napisy mają stałe adresy (std::deque), więc mogą być wiązane z zapytaniem bez kopiowania.
+     */
+    class DateStrings {
+    public:
+        explicit DateStrings(Date start) : _start(start) {
+        }
+
+        const std::string &at(int day) {
+            while (static_cast<int>(_dates.size()) <= day) {
+                _dates.push_back(_start.addDays(static_cast<int>(_dates.size())).toString());
+            }
+            return _dates[day];
+        }
+
+    private:
+        Date _start;
+        std::deque<std::string> _dates;
+    };
+
+    /**
+     * @class BookingInserter
+     * @brief Wstawia rezerwacje paczkami po RowsPerInsert wierszy.
+     */
+    class BookingInserter {
+    public:
+        explicit BookingInserter(SQLite::Database &db)
+            : _batch(db, insertQuery(RowsPerInsert)), _single(db, insertQuery(1)) {
+        }
+
+        void add(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo) {
+            int base = _pending * 4;
+            _batch.bind(base + 1, deskId);
+            _batch.bind(base + 2, userId);
+            _batch.bindNoCopy(base + 3, dateFrom);
+            _batch.bindNoCopy(base + 4, dateTo);
+            _rows[_pending] = {deskId, userId, &dateFrom, &dateTo};
+
+            if (++_pending == RowsPerInsert) {
+                _batch.exec();
+                _batch.reset();
+                _pending = 0;
+            }
+        }
+
+        void flush() {
+            // Niepełna paczka jest wstawiana pojedynczymi wierszami
+            for (int i = 0; i < _pending; ++i) {
+                const auto &row = _rows[i];
+                _single.bind(1, row.deskId);
+                _single.bind(2, row.userId);
+                _single.bindNoCopy(3, *row.dateFrom);
+                _single.bindNoCopy(4, *row.dateTo);
+                _single.exec();
+                _single.reset();
+            }
+            _batch.clearBindings();
+            _pending = 0;
+        }
+
+    private:
+        struct Row {
+            int deskId;
+            int userId;
+            const std::string *dateFrom;
+            const std::string *dateTo;
+        };
+
+        static std::string insertQuery(int rows) {
+            std::string query = "INSERT INTO bookings (desk_id, user_id, date, date_to) VALUES ";
+            for (int i = 0; i < rows; ++i) {
+                query += i == 0 ? "(?, ?, ?, ?)" : ", (?, ?, ?, ?)";
+            }
+            return query;
+        }
+
+        SQLite::Statement _batch;
+        SQLite::Statement _single;
+        std::array<Row, RowsPerInsert> _rows{};
+        int _pending = 0;
+    };
+}
+
+DataGenerator::DataGenerator(SQLite::Database &db, Options options)
+    : _db(db), _options(std::move(options)) {
+}
+
+DataGenerator::Summary DataGenerator::generate() {
+    if (_options.buildings <= 0 || _options.minFloors <= 0 || _options.maxFloors < _options.minFloors ||
+        _options.desksPerFloor <= 0 || _options.users <= 0 || _options.bookings < 0) {
+        throw std::invalid_argument("Nieprawidłowe parametry generatora danych");
+    }
+    if (_options.occupancy <= 0 || _options.occupancy > 1) {
+        throw std::invalid_argument("Obłożenie musi należeć do przedziału (0, 1]");
+    }
+    if (std::lround(_options.buildings * _options.minFloors * _options.desksPerFloor * _options.occupancy) < 1) {
+        throw std::invalid_argument("Zbyt małe obłożenie dla podanej liczby biurek");
+    }
+    parseDate(_options.startDate);
+
+    if (_db.execAndGet("SELECT COUNT(*) FROM users").getInt64() > 0 ||
+        _db.execAndGet("SELECT COUNT(*) FROM bookings").getInt64() > 0) {
+        throw std::runtime_error("Baza danych nie jest pusta");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    _summary = Summary();
+
+    // Dziennik w pamięci i brak synchronizacji przyspieszają jednorazowe ładowanie
+    {
+        DurabilitySettings restore(_db);
+        _db.exec("PRAGMA journal_mode = MEMORY");
+        _db.exec("PRAGMA synchronous = OFF");
+
+        SQLite::Transaction transaction(_db);
+        generateBuildingsAndDesks();
+        generateUsers();
+        generateBookings();
+        transaction.commit();
+    }
+
+    _summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return _summary;
+}
+
+void DataGenerator::generateBuildingsAndDesks() {
+    std::mt19937_64 rng(_options.seed);
+    std::uniform_int_distribution<int> floorDist(_options.minFloors, _options.maxFloors);
+    std::uniform_int_distribution<int> numberDist(1, 200);
+
+    SQLite::Statement insertBuilding(_db, "INSERT INTO buildings (name, address, num_floors) VALUES (?, ?, ?)");
+    SQLite::Statement insertDesk(_db, "INSERT INTO desks (name, building_id, floor) VALUES (?, ?, ?)");
+
+    for (int b = 0; b < _options.buildings; ++b) {
+        std::string code = buildingCode(b);
+        int floors = floorDist(rng);
+        std::string address = std::string("ul. ") + Streets[rng() % Streets.size()] + " " +
+                              std::to_string(numberDist(rng)) + ", " + Cities[rng() % Cities.size()];
+
+        insertBuilding.bind(1, "Budynek " + code);
+        insertBuilding.bind(2, address);
+        insertBuilding.bind(3, floors);
+        insertBuilding.exec();
+        insertBuilding.reset();
+        int buildingId = static_cast<int>(_db.getLastInsertRowid());
+
+        for (int floor = 1; floor <= floors; ++floor) {
+            for (int i = 1; i <= _options.desksPerFloor; ++i) {
+                char number[16];
+                std::snprintf(number, sizeof(number), "%02d", i);
+                insertDesk.bind(1, code + std::to_string(floor) + "-" + number);
+                insertDesk.bind(2, buildingId);
+                insertDesk.bind(3, floor);
+                insertDesk.exec();
+                insertDesk.reset();
+                _deskIds.push_back(static_cast<int>(_db.getLastInsertRowid()));
+            }
+        }
+    }
+
+    _summary.buildings = _options.buildings;
+    _summary.desks = static_cast<int>(_deskIds.size());
+    LOG_INFO("Wygenerowano {} budynków i {} biurek", _summary.buildings, _summary.desks);
+}
+
+void DataGenerator::generateUsers() {
+    // Wszyscy wygenerowani użytkownicy mają to samo hasło, więc hash liczony jest raz
+    const std::string passwordHash = UserRepository::hashPassword("password");
+    SQLite::Statement insertUser(_db, "INSERT INTO users (username, password_hash, email) VALUES (?, ?, ?)");
+
+    _userIds.reserve(_options.users);
+    for (int i = 1; i <= _options.users; ++i) {
+        std::string username = "user" + std::to_string(i);
+        insertUser.bind(1, username);
+        insertUser.bindNoCopy(2, passwordHash);
+        insertUser.bind(3, username + "@example.com");
+        insertUser.exec();
+        insertUser.reset();
+        _userIds.push_back(static_cast<int>(_db.getLastInsertRowid()));
+    }
+
+    _summary.users = _options.users;
+    LOG_INFO("Wygenerowano {} użytkowników", _summary.users);
+}
+
+void DataGenerator::generateBookings() {
+    if (_options.bookings == 0) {
+        return;
+    }
+
+    std::mt19937_64 rng(_options.seed * 31 + 7);
+    const int deskCount = static_cast<int>(_deskIds.size());
+
+    // Popularność biurek: rozkład Zipfa po losowej permutacji biurek
+    std::vector<int> popularity(deskCount);
+    for (int i = 0; i < deskCount; ++i) {
+        popularity[i] = i;
+    }
+    std::shuffle(popularity.begin(), popularity.end(), rng);
+
+    std::vector<double> cdf(deskCount);
+    double sum = 0;
+    for (int i = 0; i < deskCount; ++i) {
+        sum += 1.0 / std::pow(i + 1.0, _options.deskSkew);
+        cdf[i] = sum;
+    }
+    std::uniform_real_distribution<double> unit(0.0, sum);
+    auto pickDesk = [&]() {
+        auto it = std::lower_bound(cdf.begin(), cdf.end(), unit(rng));
+        return popularity[std::min<int>(static_cast<int>(it - cdf.begin()), deskCount - 1)];
+    };
+
+    std::uniform_int_distribution<size_t> userDist(0, _userIds.size() - 1);
+    std::bernoulli_distribution longStay(_options.longStayShare);
+    std::uniform_int_distribution<int> longStayDays(2, std::clamp(_options.maxLongStayDays, 2, BookingRecord::MaxDays));
+    std::uniform_int_distribution<int> deskDist(0, deskCount - 1);
+
+    const Date start = parseDate(_options.startDate);
+    DateStrings dates(start);
+    BookingInserter inserter(_db);
+
+    // Ostatni zajęty dzień każdego biurka (rezerwacje są tworzone dzień po dniu)
+    std::vector<int> busyUntil(deskCount, -1);
+    int64_t generated = 0;
+    int lastDay = 0;
+    const int64_t progressStep = 1'000'000;
+
+    for (int day = 0; generated < _options.bookings; ++day) {
+        int weekday = start.addDays(day).dayOfWeek();
+        int target = static_cast<int>(std::lround(deskCount * _options.occupancy * WeekdayLoad[weekday - 1]));
+        int occupied = static_cast<int>(std::count_if(busyUntil.begin(), busyUntil.end(),
+                                                      [day](int until) { return until >= day; }));
+
+        for (int n = occupied; n < target && generated < _options.bookings; ++n) {
+            // Popularne biurka są zwykle zajęte, więc po kilku próbach wybierane jest najbliższe wolne
+            int desk = pickDesk();
+            for (int attempt = 0; attempt < 8 && busyUntil[desk] >= day; ++attempt) {
+                desk = pickDesk();
+            }
+            if (busyUntil[desk] >= day) {
+                desk = deskDist(rng);
+                while (busyUntil[desk] >= day) {
+                    desk = (desk + 1) % deskCount;
+                }
+            }
+
+            int length = longStay(rng) ? longStayDays(rng) : 1;
+            if (!BookingRecord::inRange(start.addDays(day + length - 1))) {
+                throw std::runtime_error("Rezerwacje wykraczają poza zakres dat (do " +
+                                         BookingRecord::LastDate.toString() + ")");
+            }
+            busyUntil[desk] = day + length - 1;
+            lastDay = std::max(lastDay, busyUntil[desk]);
+
+            inserter.add(_deskIds[desk], _userIds[userDist(rng)], dates.at(day), dates.at(day + length - 1));
+            if (++generated % progressStep == 0) {
+                LOG_INFO("Wygenerowano {} z {} rezerwacji", generated, _options.bookings);
+            }
+        }
+    }
+    inserter.flush();
+
+    _summary.bookings = generated;
+    _summary.firstDate = dates.at(0);
+    _summary.lastDate = dates.at(lastDay);
+    LOG_INFO("Wygenerowano {} rezerwacji ({} - {})", generated, _summary.firstDate, _summary.lastDate);
+}
+
+void DataGenerator::seedSample(SQLite::Database &db) {
+    SQLite::Transaction transaction(db);
+
+    struct SampleFloor {
+        int floor;
+        int desks;
+    };
+    struct SampleBuilding {
+        const char *name;
+        const char *address;
+        const char *deskPrefix;
+        std::vector<SampleFloor> floors;
+    };
+
+    const std::vector<SampleBuilding> buildings = {
+        {"Budynek A", "ul. Krakowska 123, Warszawa", "A", {{1, 15}, {2, 12}}},
+        {"Budynek B", "ul. Krakowska 125, Warszawa", "B", {{1, 10}, {2, 8}, {3, 6}}},
+        {"Budynek C", "ul. Warszawska 45, Kraków", "C", {{1, 20}}},
+        {"Digital Hub", "ul. Pomorska 12, Gdańsk", "D", {{1, 15}}}
+    };
+
+    SQLite::Statement insertBuilding(db, "INSERT INTO buildings (name, address, num_floors) VALUES (?, ?, ?)");
+    SQLite::Statement insertDesk(db, "INSERT INTO desks (name, building_id, floor) VALUES (?, ?, ?)");
+
+    for (const auto &building: buildings) {
+        insertBuilding.bind(1, building.name);
+        insertBuilding.bind(2, building.address);
+        insertBuilding.bind(3, static_cast<int>(building.floors.size()));
+        insertBuilding.exec();
+        insertBuilding.reset();
+        int buildingId = static_cast<int>(db.getLastInsertRowid());
+
+        // Budynki jednopiętrowe mają biurka bez numeru piętra w nazwie (np. C-01)
+        bool singleFloor = building.floors.size() == 1;
+        for (const auto &floor: building.floors) {
+            std::string prefix = std::string(building.deskPrefix) +
+                                 (singleFloor ? "" : std::to_string(floor.floor)) + "-";
+            for (int i = 1; i <= floor.desks; ++i) {
+                char number[16];
+                std::snprintf(number, sizeof(number), "%02d", i);
+                insertDesk.bind(1, prefix + number);
+                insertDesk.bind(2, buildingId);
+                insertDesk.bind(3, floor.floor);
+                insertDesk.exec();
+                insertDesk.reset();
+            }
+        }
+    }
+
+    // Dodaj użytkowników z prostym haszowaniem haseł
+    const std::string passwordHash = UserRepository::hashPassword("password");
+    SQLite::Statement insertUser(db, "INSERT INTO users (username, password_hash, email) VALUES (?, ?, ?)");
+    for (const char *username: {"admin", "jan.kowalski", "anna.nowak", "user1"}) {
+        insertUser.bind(1, username);
+        insertUser.bind(2, passwordHash);
+        insertUser.bind(3, std::string(username) + "@example.com");
+        insertUser.exec();
+        insertUser.reset();
+    }
+
+    transaction.commit();
+}
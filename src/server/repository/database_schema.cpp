@@ -0,0 +1,74 @@
+#include "database_schema.h"
+
+bool hasDatabaseSchema(SQLite::Database &db) {
+    try {
+        SQLite::Statement query(db, "SELECT name FROM sqlite_master WHERE type='table' AND name='buildings'");
+        return query.executeStep();
+    } catch (...) {
+        // Ignoruj wyjątki podczas sprawdzania
+        return false;
+    }
+}
+
+void createDatabaseSchema(SQLite::Database &db) {
+    SQLite::Transaction transaction(db);
+
+    db.exec("CREATE TABLE IF NOT EXISTS buildings ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "name TEXT NOT NULL,"
+        "address TEXT,"
+        "num_floors INTEGER DEFAULT 1"
+        ");");
+
+    db.exec("CREATE TABLE IF NOT EXISTS desks ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "name TEXT NOT NULL,"
+        "building_id INTEGER NOT NULL,"
+        "floor INTEGER DEFAULT 1,"
+        "FOREIGN KEY (building_id) REFERENCES buildings(id) ON DELETE CASCADE"
+        ");");
+
+    db.exec("CREATE TABLE IF NOT EXISTS users ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "username TEXT NOT NULL UNIQUE,"
+        "password_hash TEXT NOT NULL,"
+        "email TEXT NOT NULL UNIQUE,"
+        "created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
+        ");");
+
+    db.exec("CREATE TABLE IF NOT EXISTS bookings ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "desk_id INTEGER NOT NULL,"
+        "user_id INTEGER NOT NULL,"
+        "date TEXT NOT NULL,"
+        "date_to TEXT NOT NULL,"
+        "FOREIGN KEY (desk_id) REFERENCES desks(id) ON DELETE CASCADE,"
+        "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE"
+        ");");
+
+    // Indeks dla listy rezerwacji użytkownika stronicowanej po (date, id)
+    db.exec("CREATE INDEX IF NOT EXISTS idx_bookings_user_date ON bookings (user_id, date)");
+
+    // Indeks dla rezerwacji biurka (widoki pięter, zakresy dat i sprawdzanie konfliktów)
+    db.exec("CREATE INDEX IF NOT EXISTS idx_bookings_desk_date ON bookings (desk_id, date)");
+
+    // Klucze idempotencji są krótkotrwałe, więc tabela w dawnym układzie (bez zakresu) jest tworzona od nowa
+    SQLite::Statement scopeColumn(db, "SELECT 1 FROM pragma_table_info('idempotency_keys') WHERE name = 'scope'");
+    if (!scopeColumn.executeStep()) {
+        db.exec("DROP TABLE IF EXISTS idempotency_keys");
+    }
+
+    // Tabela kluczy idempotencji (klucz jest unikalny w obrębie zakresu)
+    db.exec("CREATE TABLE IF NOT EXISTS idempotency_keys ("
+        "scope TEXT NOT NULL,"
+        "key TEXT NOT NULL,"
+        "response TEXT NOT NULL,"
+        "created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+        "PRIMARY KEY (scope, key)"
+        ");");
+
+    // Indeks dla usuwania przeterminowanych kluczy
+    db.exec("CREATE INDEX IF NOT EXISTS idx_idempotency_keys_created_at ON idempotency_keys (created_at)");
+
+    transaction.commit();
+}
@@ -0,0 +1,22 @@
+#ifndef DATABASE_SCHEMA_H
+#define DATABASE_SCHEMA_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+/**
+ * @brief Sprawdza czy baza danych zawiera schemat aplikacji
+ * @param db Baza danych
+ * @return Czy tabele aplikacji istnieją
+ */
+bool hasDatabaseSchema(SQLite::Database &db);
+
+/**
+ * @brief Tworzy brakujące tabele aplikacji
+ *
+ * Operacja jest idempotentna, więc może być wywoływana także dla istniejących baz.
+ *
+ * @param db Baza danych
+ */
+void createDatabaseSchema(SQLite::Database &db);
+
+#endif
@@ -1,38 +1,18 @@
 #include "desk_repository.h"
 
 DeskRepository::DeskRepository(std::shared_ptr<SQLite::Database> db)
-    : SQLiteRepository<Desk>(
-        db,
-        "desks",
-        "SELECT id, name, building_id, floor FROM desks",
-        "SELECT id, name, building_id, floor FROM desks WHERE id = ?",
-        "INSERT INTO desks (name, building_id, floor) VALUES (?, ?, ?)",
-        "UPDATE desks SET name = ?, building_id = ?, floor = ? WHERE id = ?",
-        "DELETE FROM desks WHERE id = ?",
-        deskFromRow,
-        [](SQLite::Statement &stmt, const Desk &desk) {
-            stmt.bind(1, desk.getName());
-            stmt.bind(2, desk.getBuildingId());
-            stmt.bind(3, desk.getFloor());
-        }
-    ) {
-}
-
-Desk DeskRepository::deskFromRow(SQLite::Statement &query) {
-    int id = query.getColumn(0).getInt();
-    std::string name = query.getColumn(1).getString();
-    int buildingId = query.getColumn(2).getInt();
-    int floor = query.getColumn(3).getInt();
-    return Desk(id, name, buildingId, floor);
+    : SQLiteRepository<Desk>(std::move(db)) {
 }
 
 std::vector<Desk> DeskRepository::findByBuildingId(int buildingId) {
+    static constexpr const char *sql = Sql::select<"WHERE building_id = ?">.c_str();
+    PROFILE_QUERY(*_db, "desks.findByBuildingId", sql);
     std::vector<Desk> desks;
-    SQLite::Statement query(*_db, "SELECT id, name, building_id, floor FROM desks WHERE building_id = ?");
+    SQLite::Statement query(*_db, sql);
     query.bind(1, buildingId);
 
     while (query.executeStep()) {
-        desks.push_back(deskFromRow(query));
+        desks.push_back(entityFromRow<Desk>(query));
     }
     return desks;
 }
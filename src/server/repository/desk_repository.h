@@ -26,14 +26,6 @@ public:
      * @return Wektor biurek
      */
     std::vector<Desk> findByBuildingId(int buildingId);
-
-private:
-    /**
-     * @brief Konwertuje wiersz z bazy na obiekt biurka
-     * @param query Zapytanie SQL z wynikami
-     * @return Obiekt biurka
-     */
-    static Desk deskFromRow(SQLite::Statement &query);
 };
 
 #endif
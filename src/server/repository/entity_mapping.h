@@ -0,0 +1,276 @@
+#ifndef ENTITY_MAPPING_H
+#define ENTITY_MAPPING_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "common/model/entity_traits.h"
+
+/**
+ * @struct SqlText
+ * @brief Treść zapytania SQL zbudowana w czasie kompilacji (z kończącym zerem).
+ *
+ * @tparam N Długość zapytania
+ */
+template<size_t N>
+struct SqlText {
+    std::array<char, N + 1> chars{};
+
+    constexpr const char *c_str() const { return chars.data(); }
+    constexpr std::string_view view() const { return {chars.data(), N}; }
+};
+
+/**
+ * @struct SqlClause
+ * @brief Literał dopisywany do zapytania SELECT encji (parametr szablonu).
+ *
+ * @tparam N Rozmiar literału razem z kończącym zerem
+ */
+template<size_t N>
+struct SqlClause {
+    char chars[N]{};
+
+    constexpr SqlClause(const char (&text)[N]) {
+        std::copy_n(text, N, chars);
+    }
+
+    constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+/**
+ * @class SqlWriter
+ * @brief Składa zapytanie: bez bufora tylko liczy znaki, z buforem je zapisuje.
+ */
+class SqlWriter {
+public:
+    constexpr SqlWriter() = default;
+
+    constexpr explicit SqlWriter(char *buffer) : _buffer(buffer) {
+    }
+
+    constexpr SqlWriter &operator<<(std::string_view text) {
+        if (_buffer) {
+            std::copy(text.begin(), text.end(), _buffer + _size);
+        }
+        _size += text.size();
+        return *this;
+    }
+
+    constexpr size_t size() const { return _size; }
+
+private:
+    char *_buffer = nullptr;
+    size_t _size = 0;
+};
+
+namespace detail {
+    template<typename T>
+    constexpr std::string_view keyColumn() {
+        return std::get<0>(EntityTraits<T>::fields).column;
+    }
+
+    template<typename T>
+    constexpr void writeSelect(SqlWriter &sql) {
+        sql << "SELECT ";
+        forEachField<T>([&](const auto &field, size_t index) {
+            sql << (index > 0 ? ", " : "") << field.column;
+        });
+        sql << " FROM " << EntityTraits<T>::table;
+    }
+
+    template<typename T>
+    constexpr void writeFindAll(SqlWriter &sql) {
+        writeSelect<T>(sql);
+        if (!EntityTraits<T>::orderBy.empty()) {
+            sql << " ORDER BY " << EntityTraits<T>::orderBy;
+        }
+    }
+
+    template<typename T>
+    constexpr void writeFindById(SqlWriter &sql) {
+        writeSelect<T>(sql);
+        sql << " WHERE " << keyColumn<T>() << " = ?";
+    }
+
+    template<typename T>
+    constexpr void writeFindPage(SqlWriter &sql) {
+        writeSelect<T>(sql);
+        sql << " WHERE " << keyColumn<T>() << " > ? ORDER BY " << keyColumn<T>() << " LIMIT ?";
+    }
+
+    template<typename T>
+    constexpr void writeInsert(SqlWriter &sql) {
+        sql << "INSERT INTO " << EntityTraits<T>::table << " (";
+        forEachField<T>([&](const auto &field, size_t index) {
+            if (index > 0) {
+                sql << (index > 1 ? ", " : "") << field.column;
+            }
+        });
+        sql << ") VALUES (";
+        for (size_t index = 1; index < entityFieldCount<T>(); ++index) {
+            sql << (index > 1 ? ", ?" : "?");
+        }
+        sql << ") RETURNING " << keyColumn<T>();
+    }
+
+    template<typename T>
+    constexpr void writeUpdate(SqlWriter &sql) {
+        sql << "UPDATE " << EntityTraits<T>::table << " SET ";
+        forEachField<T>([&](const auto &field, size_t index) {
+            if (index > 0) {
+                sql << (index > 1 ? ", " : "") << field.column << " = ?";
+            }
+        });
+        sql << " WHERE " << keyColumn<T>() << " = ? RETURNING " << keyColumn<T>();
+    }
+
+    template<typename T>
+    constexpr void writeRemove(SqlWriter &sql) {
+        sql << "DELETE FROM " << EntityTraits<T>::table << " WHERE " << keyColumn<T>() << " = ? RETURNING "
+            << keyColumn<T>();
+    }
+
+    template<typename T, SqlClause Clause>
+    constexpr void writeSelectWhere(SqlWriter &sql) {
+        writeSelect<T>(sql);
+        sql << " " << Clause.view();
+    }
+
+    /**
+     * @brief Buduje zapytanie: pierwszy przebieg liczy znaki, drugi je zapisuje
+     */
+    template<auto Write>
+    constexpr auto buildSql() {
+        constexpr size_t size = [] {
+            SqlWriter sql;
+            Write(sql);
+            return sql.size();
+        }();
+        SqlText<size> text;
+        SqlWriter sql(text.chars.data());
+        Write(sql);
+        return text;
+    }
+}
+
+/**
+ * @struct EntitySql
+ * @brief Zapytania podstawowych operacji encji wygenerowane z EntityTraits.
+ *
+ * Identyfikatorem jest pierwsze pole encji; pozostałe pola są kolumnami
+ * INSERT i UPDATE w kolejności opisu, a wszystkie - kolumnami SELECT.
+ * INSERT, UPDATE i DELETE zwracają identyfikator zmienionego wiersza
+ * (RETURNING), więc wynik nie zależy od stanu połączenia współdzielonego
+ * przez wątki (sqlite3_last_insert_rowid, sqlite3_changes).
+ *
+ * @tparam T Typ encji
+ */
+template<typename T>
+struct EntitySql {
+    static constexpr auto findAll = detail::buildSql<detail::writeFindAll<T>>();
+    static constexpr auto findById = detail::buildSql<detail::writeFindById<T>>();
+    static constexpr auto findPage = detail::buildSql<detail::writeFindPage<T>>();
+    static constexpr auto insert = detail::buildSql<detail::writeInsert<T>>();
+    static constexpr auto update = detail::buildSql<detail::writeUpdate<T>>();
+    static constexpr auto remove = detail::buildSql<detail::writeRemove<T>>();
+
+    /**
+     * @brief Zapytanie SELECT wszystkich kolumn encji z dopisaną klauzulą
+     * @tparam Clause Klauzula, np. "WHERE desk_id = ? ORDER BY date"
+     */
+    template<SqlClause Clause>
+    static constexpr auto select = detail::buildSql<detail::writeSelectWhere<T, Clause>>();
+};
+
+/**
+ * @brief Odczytuje wartość kolumny jako typ pola encji
+ * @param column Kolumna wiersza
+ * @return Wartość (data niepoprawna dla pustej lub błędnej wartości)
+ */
+template<typename Value>
+Value columnValue(const SQLite::Column &column) {
+    if constexpr (std::is_same_v<Value, int>) {
+        return column.getInt();
+    } else if constexpr (std::is_same_v<Value, std::string>) {
+        return column.getString();
+    } else {
+        static_assert(std::is_same_v<Value, Date>, "Nieobsługiwany typ pola encji");
+        // Tekst daty jest odczytywany bez kopiowania; długość dopiero po getText()
+        const char *text = column.getText();
+        return Date::fromString(std::string_view(text, column.getBytes()));
+    }
+}
+
+/**
+ * @brief Wiąże wartość pola encji z parametrem zapytania
+ *
+ * Teksty są wiązane bez kopii, więc encja musi istnieć do wykonania zapytania.
+ *
+ * @param query Zapytanie
+ * @param index Indeks parametru (od 1)
+ * @param value Wartość pola
+ */
+template<typename Value>
+void bindValue(SQLite::Statement &query, int index, const Value &value) {
+    if constexpr (std::is_same_v<Value, int>) {
+        query.bind(index, value);
+    } else if constexpr (std::is_same_v<Value, std::string>) {
+        query.bindNoCopy(index, value);
+    } else {
+        static_assert(std::is_same_v<Value, Date>, "Nieobsługiwany typ pola encji");
+        char text[Date::TextLength + 1] = {};
+        value.format(text);
+        query.bind(index, text);
+    }
+}
+
+/**
+ * @brief Konwertuje bieżący wiersz zapytania na encję
+ *
+ * Kolumny są odczytywane w kolejności pól (jak w zapytaniach EntitySql).
+ *
+ * @param query Zapytanie SQL z wynikami
+ * @return Encja
+ */
+template<typename T>
+T entityFromRow(SQLite::Statement &query) {
+    T entity;
+    forEachField<T>([&](const auto &field, size_t index) {
+        using Value = typename std::remove_cvref_t<decltype(field)>::Value;
+        field.get(entity) = columnValue<Value>(query.getColumn(static_cast<int>(index)));
+    });
+    return entity;
+}
+
+/**
+ * @struct RowReader
+ * @brief Odczyt bieżącego wiersza zapytania jako obiektu typu T.
+ *
+ * Domyślnie wiersz jest encją opisaną przez EntityTraits; specjalizacja
+ * pozwala kursorom zwracać inne obiekty (np. zwarte rekordy) z tych samych kolumn.
+ *
+ * @tparam T Typ odczytywanego obiektu
+ */
+template<typename T>
+struct RowReader {
+    static T read(SQLite::Statement &query) { return entityFromRow<T>(query); }
+};
+
+/**
+ * @brief Wiąże pola encji (bez identyfikatora) z parametrami INSERT lub UPDATE
+ * @param query Zapytanie
+ * @param entity Encja
+ */
+template<typename T>
+void bindEntity(SQLite::Statement &query, const T &entity) {
+    forEachField<T>([&](const auto &field, size_t index) {
+        if (index > 0) {
+            bindValue(query, static_cast<int>(index), field.get(entity));
+        }
+    });
+}
+
+#endif
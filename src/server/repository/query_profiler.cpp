@@ -0,0 +1,168 @@
+#include "query_profiler.h"
+#include <algorithm>
+#include <cctype>
+#include "common/logger.h"
+#include "../metrics/metrics.h"
+
+QueryProfiler &QueryProfiler::instance() {
+    static QueryProfiler profiler;
+    return profiler;
+}
+
+QueryProfiler::Entry &QueryProfiler::entry(std::string_view name, std::string_view sql) {
+    std::string normalized = normalizeSql(sql);
+    std::string key;
+    key.reserve(name.size() + 1 + normalized.size());
+    key.append(name).append("\n").append(normalized);
+
+    std::lock_guard lock(_mutex);
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        return *it->second;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->sql = std::move(normalized);
+    entry->metricsSeries = Metrics::instance().querySeries(name);
+    return *_entries.emplace(std::move(key), std::move(entry)).first->second;
+}
+
+void QueryProfiler::record(Entry &entry, uint64_t nanos, SQLite::Database &db) {
+    Metrics::instance().observeQuery(entry.metricsSeries, nanos);
+
+    entry.calls.fetch_add(1, std::memory_order_relaxed);
+    entry.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+    uint64_t max = entry.maxNanos.load(std::memory_order_relaxed);
+    while (nanos > max && !entry.maxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {
+    }
+
+    if (nanos < _slowNanos.load(std::memory_order_relaxed)) {
+        return;
+    }
+    entry.slowCalls.fetch_add(1, std::memory_order_relaxed);
+
+    std::string plan;
+    {
+        std::lock_guard lock(entry.planMutex);
+        if (entry.plan.empty()) {
+            entry.plan = explain(db, entry.sql);
+        }
+        plan = entry.plan;
+    }
+    LOG_WARNING("Wolne zapytanie{}", logFields("query", entry.name, "ms", nanos / 1'000'000.0,
+                                               "sql", entry.sql, "plan", plan));
+}
+
+void QueryProfiler::setSlowThreshold(std::chrono::milliseconds threshold) {
+    _slowNanos.store(std::chrono::nanoseconds(threshold).count(), std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds QueryProfiler::slowThreshold() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::nanoseconds(_slowNanos.load(std::memory_order_relaxed)));
+}
+
+std::vector<QueryProfiler::Stats> QueryProfiler::top(size_t limit) const {
+    std::vector<Stats> result;
+    {
+        std::lock_guard lock(_mutex);
+        result.reserve(_entries.size());
+        for (const auto &[key, entry]: _entries) {
+            uint64_t calls = entry->calls.load(std::memory_order_relaxed);
+            if (calls == 0) {
+                continue;
+            }
+            Stats stats;
+            stats.name = entry->name;
+            stats.sql = entry->sql;
+            stats.calls = calls;
+            stats.totalNanos = entry->totalNanos.load(std::memory_order_relaxed);
+            stats.maxNanos = entry->maxNanos.load(std::memory_order_relaxed);
+            stats.slowCalls = entry->slowCalls.load(std::memory_order_relaxed);
+            {
+                std::lock_guard planLock(entry->planMutex);
+                stats.plan = entry->plan;
+            }
+            result.push_back(std::move(stats));
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const Stats &a, const Stats &b) { return a.totalNanos > b.totalNanos; });
+    if (result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+void QueryProfiler::reset() {
+    std::lock_guard lock(_mutex);
+    for (auto &[key, entry]: _entries) {
+        entry->calls.store(0, std::memory_order_relaxed);
+        entry->totalNanos.store(0, std::memory_order_relaxed);
+        entry->maxNanos.store(0, std::memory_order_relaxed);
+        entry->slowCalls.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string QueryProfiler::normalizeSql(std::string_view sql) {
+    auto isIdentifier = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+
+    std::string normalized;
+    normalized.reserve(sql.size());
+    size_t i = 0;
+    while (i < sql.size()) {
+        char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) {
+                ++i;
+            }
+            if (!normalized.empty()) {
+                normalized += ' ';
+            }
+        } else if (c == '\'') {
+            // Literał tekstowy ('' wewnątrz oznacza apostrof)
+            ++i;
+            while (i < sql.size()) {
+                if (sql[i] == '\'' && !(i + 1 < sql.size() && sql[i + 1] == '\'')) {
+                    ++i;
+                    break;
+                }
+                i += sql[i] == '\'' ? 2 : 1;
+            }
+            normalized += '?';
+        } else if (std::isdigit(static_cast<unsigned char>(c)) &&
+                   (normalized.empty() || !isIdentifier(normalized.back()))) {
+            while (i < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '.')) {
+                ++i;
+            }
+            normalized += '?';
+        } else {
+            normalized += c;
+            ++i;
+        }
+    }
+    if (!normalized.empty() && normalized.back() == ' ') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+std::string QueryProfiler::explain(SQLite::Database &db, const std::string &sql) {
+    try {
+        SQLite::Statement query(db, "EXPLAIN QUERY PLAN " + sql);
+        std::string plan;
+        while (query.executeStep()) {
+            if (!plan.empty()) {
+                plan += "; ";
+            }
+            plan += query.getColumn(3).getString();
+        }
+        return plan;
+    } catch (const std::exception &ex) {
+        return std::string("niedostępny: ") + ex.what();
+    }
+}
@@ -0,0 +1,172 @@
+#ifndef QUERY_PROFILER_H
+#define QUERY_PROFILER_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../memory/memory_tracker.h"
+#include "../tracing/trace.h"
+
+/**
+ * @class QueryProfiler
+ * @brief Profiler zapytań SQLite wykonywanych przez repozytoria.
+ *
+ * Każde zapytanie (metoda repozytorium wraz ze znormalizowanym SQL) ma
+ * wpis z liczbą wywołań, łącznym i maksymalnym czasem oraz liczbą wolnych
+ * wykonań. Czas trafia też do metryk i śladu żądania. Zapytania wolniejsze
+ * niż próg są logowane razem z planem EXPLAIN QUERY PLAN, ustalanym przy
+ * pierwszym wolnym wykonaniu.
+ */
+class QueryProfiler {
+public:
+    /**
+     * @brief Wpis jednego zapytania; wpisy istnieją do końca programu
+     */
+    struct Entry {
+        std::string name;
+        std::string sql;
+        int metricsSeries = 0;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> totalNanos{0};
+        std::atomic<uint64_t> maxNanos{0};
+        std::atomic<uint64_t> slowCalls{0};
+
+        std::mutex planMutex;
+        std::string plan;
+    };
+
+    /**
+     * @brief Migawka statystyk zapytania
+     */
+    struct Stats {
+        std::string name;
+        std::string sql;
+        uint64_t calls = 0;
+        uint64_t totalNanos = 0;
+        uint64_t maxNanos = 0;
+        uint64_t slowCalls = 0;
+        std::string plan;
+    };
+
+    /**
+     * @brief Zwraca instancję profilera (wzorzec Singleton)
+     * @return Referencja do profilera
+     */
+    static QueryProfiler &instance();
+
+    QueryProfiler(const QueryProfiler &) = delete;
+    QueryProfiler &operator=(const QueryProfiler &) = delete;
+
+    /**
+     * @brief Zwraca (rejestrując przy pierwszym użyciu) wpis zapytania
+     * @param name Nazwa w postaci tabela.metoda
+     * @param sql Treść zapytania
+     * @return Referencja do wpisu
+     */
+    Entry &entry(std::string_view name, std::string_view sql);
+
+    /**
+     * @brief Odnotowuje wykonanie zapytania
+     * @param entry Wpis zapytania
+     * @param nanos Czas wykonania w nanosekundach
+     * @param db Połączenie, na którym wykonano zapytanie (dla planu wolnego zapytania)
+     */
+    void record(Entry &entry, uint64_t nanos, SQLite::Database &db);
+
+    /**
+     * @brief Ustawia próg wolnego zapytania
+     * @param threshold Próg
+     */
+    void setSlowThreshold(std::chrono::milliseconds threshold);
+
+    /**
+     * @brief Zwraca próg wolnego zapytania
+     * @return Próg
+     */
+    std::chrono::milliseconds slowThreshold() const;
+
+    /**
+     * @brief Zwraca zapytania o największym łącznym czasie
+     * @param limit Liczba zapytań
+     * @return Statystyki posortowane malejąco po łącznym czasie
+     */
+    std::vector<Stats> top(size_t limit) const;
+
+    /**
+     * @brief Zeruje statystyki wszystkich zapytań (plany pozostają)
+     */
+    void reset();
+
+    /**
+     * @brief Normalizuje zapytanie: scala białe znaki i zastępuje literały znakiem ?
+     * @param sql Treść zapytania
+     * @return Znormalizowane zapytanie
+     */
+    static std::string normalizeSql(std::string_view sql);
+
+    static constexpr std::chrono::milliseconds DefaultSlowThreshold{100};
+
+private:
+    QueryProfiler() = default;
+
+    static std::string explain(SQLite::Database &db, const std::string &sql);
+
+    mutable std::mutex _mutex;
+    std::map<std::string, std::unique_ptr<Entry>, std::less<>> _entries;
+    std::atomic<uint64_t> _slowNanos{
+        static_cast<uint64_t>(std::chrono::nanoseconds(DefaultSlowThreshold).count())};
+};
+
+/**
+ * @class ProfiledQuery
+ * @brief Mierzy zapytanie od utworzenia do zniszczenia obiektu.
+ *
+ * Przydziały pamięci w tym czasie są przypisywane do repozytoriów.
+ */
+class ProfiledQuery {
+public:
+    /**
+     * @brief Konstruktor (rozpoczyna pomiar i odcinek śladu)
+     * @param entry Wpis zapytania
+     * @param db Połączenie wykonujące zapytanie
+     */
+    ProfiledQuery(QueryProfiler::Entry &entry, SQLite::Database &db)
+        : _entry(entry), _db(db), _memoryScope(MemorySubsystem::Repository), _span(entry.name),
+          _start(std::chrono::steady_clock::now()) {
+    }
+
+    ~ProfiledQuery() {
+        auto elapsed = std::chrono::steady_clock::now() - _start;
+        QueryProfiler::instance().record(
+            _entry, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), _db);
+    }
+
+    ProfiledQuery(const ProfiledQuery &) = delete;
+    ProfiledQuery &operator=(const ProfiledQuery &) = delete;
+
+private:
+    QueryProfiler::Entry &_entry;
+    SQLite::Database &_db;
+    MemoryScope _memoryScope;
+    TraceSpan _span;
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * @brief Mierzy zapytanie do końca bieżącego zakresu (wpis rejestrowany raz)
+ * @param db Połączenie wykonujące zapytanie
+ * @param name Nazwa zapytania w postaci tabela.metoda
+ * @param sql Treść zapytania
+ */
+#define PROFILE_QUERY(db, name, sql) \
+    static QueryProfiler::Entry &profilerEntry_ = QueryProfiler::instance().entry(name, sql); \
+    ProfiledQuery profiledQuery_(profilerEntry_, db)
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <optional>
+#include <functional>
 
 /**
  * @class Repository
@@ -26,6 +27,25 @@ public:
      */
     virtual std::vector<T> findAll() = 0;
 
+    /**
+     * @brief Przekazuje kolejne encje do funkcji bez gromadzenia ich w pamięci
+     * @param visitor Funkcja wywoływana dla każdej encji
+     * @return Liczba odwiedzonych encji
+     */
+    virtual size_t forEach(const std::function<void(const T &)> &visitor) = 0;
+
+    /**
+     * @brief Pobiera stronę encji uporządkowanych według identyfikatora
+     *
+     * Kolejną stronę otrzymuje się, przekazując identyfikator ostatniej
+     * encji poprzedniej strony.
+     *
+     * @param afterId Identyfikator, po którym zaczyna się strona (0 - od początku)
+     * @param limit Maksymalna liczba encji na stronie
+     * @return Wektor encji
+     */
+    virtual std::vector<T> findPage(int afterId, int limit) = 0;
+
     /**
      * @brief Pobiera encję po identyfikatorze
      * @param id Identyfikator encji
@@ -2,58 +2,53 @@
 #define SQLITE_REPOSITORY_H
 
 #include "repository.h"
+#include "cursor.h"
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <functional>
 #include <memory>
+#include <string>
 #include "common/logger.h"
+#include "query_profiler.h"
 
 /**
  * @class SQLiteRepository
  * @brief Bazowa implementacja repozytorium dla bazy SQLite.
  *
- * Zapewnia standardowe operacje CRUD na bazie SQLite.
+ * Zapewnia standardowe operacje CRUD na bazie SQLite. Zapytania, odczyt
+ * wierszy i wiązanie parametrów są generowane w czasie kompilacji z opisu
+ * encji (EntityTraits), więc pętle po wierszach nie zawierają wywołań
+ * pośrednich.
  *
  * @tparam T Typ encji obsługiwanej przez repozytorium
  */
 template<typename T>
 class SQLiteRepository : public Repository<T> {
 protected:
+    using Sql = EntitySql<T>;
+
     std::shared_ptr<SQLite::Database> _db;
-    std::string _tableName;
-    std::string _findAllQuery;
-    std::string _findByIdQuery;
-    std::string _insertQuery;
-    std::string _updateQuery;
-    std::string _deleteQuery;
-    std::function<T(SQLite::Statement &)> _rowToEntity;
-    std::function<void(SQLite::Statement &, const T &)> _bindEntity;
+
+    /**
+     * @brief Wpisy profilera zapytań podstawowych operacji (tabela.metoda)
+     */
+    struct QueryProfiles {
+        QueryProfiler::Entry *findAll, *findById, *findPage, *add, *update, *remove;
+    } _queryProfiles;
 
 public:
     /**
      * @brief Konstruktor
      * @param db Współdzielony wskaźnik do bazy danych
-     * @param tableName Nazwa tabeli
-     * @param findAllQuery Zapytanie SELECT dla wszystkich rekordów
-     * @param findByIdQuery Zapytanie SELECT dla pojedynczego rekordu
-     * @param insertQuery Zapytanie INSERT
-     * @param updateQuery Zapytanie UPDATE
-     * @param deleteQuery Zapytanie DELETE
-     * @param rowToEntity Funkcja konwertująca wiersz na encję
-     * @param bindEntity Funkcja wiążąca encję z parametrami zapytania
      */
-    SQLiteRepository(
-        std::shared_ptr<SQLite::Database> db,
-        const std::string &tableName,
-        const std::string &findAllQuery,
-        const std::string &findByIdQuery,
-        const std::string &insertQuery,
-        const std::string &updateQuery,
-        const std::string &deleteQuery,
-        std::function<T(SQLite::Statement &)> rowToEntity,
-        std::function<void(SQLite::Statement &, const T &)> bindEntity
-    ) : _db(db), _tableName(tableName), _findAllQuery(findAllQuery),
-        _findByIdQuery(findByIdQuery), _insertQuery(insertQuery),
-        _updateQuery(updateQuery), _deleteQuery(deleteQuery),
-        _rowToEntity(rowToEntity), _bindEntity(bindEntity) {
+    explicit SQLiteRepository(std::shared_ptr<SQLite::Database> db) : _db(std::move(db)) {
+        auto &profiler = QueryProfiler::instance();
+        std::string table(EntityTraits<T>::table);
+        _queryProfiles.findAll = &profiler.entry(table + ".findAll", Sql::findAll.view());
+        _queryProfiles.findById = &profiler.entry(table + ".findById", Sql::findById.view());
+        _queryProfiles.findPage = &profiler.entry(table + ".findPage", Sql::findPage.view());
+        _queryProfiles.add = &profiler.entry(table + ".add", Sql::insert.view());
+        _queryProfiles.update = &profiler.entry(table + ".update", Sql::update.view());
+        _queryProfiles.remove = &profiler.entry(table + ".remove", Sql::remove.view());
     }
 
     /**
@@ -61,13 +56,59 @@ public:
      * @return Wektor wszystkich encji
      */
     std::vector<T> findAll() override {
-        std::vector<T> entities;
-        SQLite::Statement query(*_db, _findAllQuery);
+        return cursor().collect();
+    }
 
-        while (query.executeStep()) {
-            entities.push_back(_rowToEntity(query));
+    /**
+     * @brief Otwiera kursor po wszystkich encjach
+     * @return Kursor odczytujący encje w kolejności zapytania findAll
+     */
+    Cursor<T> cursor() {
+        return openCursor(Sql::findAll.c_str(), *_queryProfiles.findAll);
+    }
+
+    /**
+     * @brief Przekazuje kolejne encje do funkcji bez gromadzenia ich w wektorze
+     *
+     * Wiersze są odczytywane bezpośrednio z otwartego zapytania, więc zużycie
+     * pamięci nie zależy od liczby encji.
+     *
+     * @param visitor Funkcja wywoływana dla każdej encji
+     * @return Liczba odwiedzonych encji
+     */
+    size_t forEach(const std::function<void(const T &)> &visitor) override {
+        return forEach<const std::function<void(const T &)> &>(visitor);
+    }
+
+    /**
+     * @brief Przekazuje kolejne encje do funkcji wywoływanej bezpośrednio
+     *
+     * Wersja dla funkcji znanej w czasie kompilacji (np. lambdy), którą
+     * kompilator może rozwinąć w pętli po wierszach.
+     *
+     * @param visitor Funkcja wywoływana dla każdej encji
+     * @return Liczba odwiedzonych encji
+     */
+    template<typename Visitor>
+    size_t forEach(Visitor &&visitor) {
+        auto entities = cursor();
+        for (const auto &entity: entities) {
+            visitor(entity);
         }
-        return entities;
+        return entities.count();
+    }
+
+    /**
+     * @brief Pobiera stronę encji uporządkowanych według identyfikatora
+     * @param afterId Identyfikator, po którym zaczyna się strona (0 - od początku)
+     * @param limit Maksymalna liczba encji na stronie
+     * @return Wektor encji
+     */
+    std::vector<T> findPage(int afterId, int limit) override {
+        auto page = openCursor(Sql::findPage.c_str(), *_queryProfiles.findPage);
+        page.statement().bind(1, afterId);
+        page.statement().bind(2, limit);
+        return page.collect();
     }
 
     /**
@@ -76,11 +117,12 @@ public:
      * @return Opcjonalny obiekt encji (brak w przypadku nieznalezienia)
      */
     std::optional<T> findById(int id) override {
-        SQLite::Statement query(*_db, _findByIdQuery);
+        ProfiledQuery profiled(*_queryProfiles.findById, *_db);
+        SQLite::Statement query(*_db, Sql::findById.c_str());
         query.bind(1, id);
 
         if (query.executeStep()) {
-            return _rowToEntity(query);
+            return entityFromRow<T>(query);
         }
         return std::nullopt;
     }
@@ -91,29 +133,74 @@ public:
      * @return Dodana encja (z zaktualizowanym identyfikatorem)
      */
     T add(const T &entity) override {
-        SQLite::Statement query(*_db, _insertQuery);
-        _bindEntity(query, entity);
-
-        query.exec();
-        int id = static_cast<int>(_db->getLastInsertRowid());
+        ProfiledQuery profiled(*_queryProfiles.add, *_db);
+        SQLite::Statement query(*_db, Sql::insert.c_str());
+        bindEntity(query, entity);
 
         T newEntity = entity;
-        newEntity.setId(id);
+        newEntity.setId(insertedId(query));
         return newEntity;
     }
 
+    /**
+     * @class Inserter
+     * @brief Wstawia wiele encji jednym, wielokrotnie używanym zapytaniem.
+     *
+     * Zapytanie INSERT jest przygotowywane raz, a transakcje obejmujące
+     * kolejne paczki wierszy pozostają w gestii wywołującego.
+     */
+    class Inserter {
+    public:
+        /**
+         * @brief Konstruktor
+         * @param repository Repozytorium, do którego trafiają encje
+         */
+        explicit Inserter(SQLiteRepository &repository)
+            : _repository(repository), _query(*repository._db, Sql::insert.c_str()) {
+        }
+
+        /**
+         * @brief Dodaje encję
+         * @param entity Obiekt encji do dodania
+         * @return Dodana encja (z zaktualizowanym identyfikatorem)
+         */
+        T add(const T &entity) {
+            ProfiledQuery profiled(*_repository._queryProfiles.add, *_repository._db);
+            bindEntity(_query, entity);
+            int id = insertedId(_query);
+            _query.reset();
+
+            T newEntity = entity;
+            newEntity.setId(id);
+            return newEntity;
+        }
+
+    private:
+        SQLiteRepository &_repository;
+        SQLite::Statement _query;
+    };
+
+    /**
+     * @brief Tworzy obiekt do wstawiania wielu encji
+     * @return Obiekt wstawiający encje przygotowanym zapytaniem
+     */
+    Inserter inserter() {
+        return Inserter(*this);
+    }
+
     /**
      * @brief Aktualizuje istniejącą encję
      * @param entity Obiekt encji do aktualizacji
      * @return Czy operacja się powiodła
      */
     bool update(const T &entity) override {
-        SQLite::Statement query(*_db, _updateQuery);
-        _bindEntity(query, entity);
-        query.bind(query.getBindParameterCount(), entity.getId());
+        ProfiledQuery profiled(*_queryProfiles.update, *_db);
+        SQLite::Statement query(*_db, Sql::update.c_str());
+        bindEntity(query, entity);
+        query.bind(static_cast<int>(entityFieldCount<T>()), entity.getId());
 
-        query.exec();
-        return query.getChanges() > 0;
+        // Wiersz RETURNING oznacza zmianę, niezależnie od zapisów innych wątków
+        return query.executeStep();
     }
 
     /**
@@ -122,11 +209,45 @@ public:
      * @return Czy operacja się powiodła
      */
     bool remove(int id) override {
-        SQLite::Statement query(*_db, _deleteQuery);
+        ProfiledQuery profiled(*_queryProfiles.remove, *_db);
+        SQLite::Statement query(*_db, Sql::remove.c_str());
         query.bind(1, id);
 
-        query.exec();
-        return query.getChanges() > 0;
+        return query.executeStep();
+    }
+
+protected:
+    /**
+     * @brief Wykonuje INSERT ... RETURNING i odczytuje identyfikator nowego wiersza
+     *
+     * Identyfikator pochodzi z wyniku zapytania, a nie z połączenia
+     * (getLastInsertRowid), które współdzielą wątki obsługujące żądania.
+     *
+     * @param query Zapytanie Sql::insert z powiązanymi parametrami
+     * @return Identyfikator dodanej encji
+     */
+    static int insertedId(SQLite::Statement &query) {
+        if (!query.executeStep()) {
+            throw SQLite::Exception("INSERT nie zwrócił identyfikatora");
+        }
+        return query.getColumn(0).getInt();
+    }
+
+    /**
+     * @brief Otwiera kursor dla zapytania zwracającego wiersze encji
+     *
+     * Parametry zapytania wiąże się przez Cursor::statement() przed
+     * odczytaniem pierwszej encji.
+     *
+     * @tparam Row Typ odczytywanych wierszy (encja lub rekord z RowReader)
+     * @param sql Zapytanie SELECT wszystkich kolumn encji (np. Sql::select)
+     * @param profile Wpis profilera zapytania
+     * @return Kursor po wynikach zapytania
+     */
+    template<typename Row = T>
+    Cursor<Row> openCursor(const char *sql, QueryProfiler::Entry &profile) {
+        MEMORY_SCOPE(Repository);
+        return Cursor<Row>(std::make_unique<SQLite::Statement>(*_db, sql), &profile, _db.get());
     }
 };
 
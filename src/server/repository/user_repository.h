@@ -48,14 +48,6 @@ public:
      * @return Hash hasła
      */
     static std::string hashPassword(const std::string &password);
-
-private:
-    /**
-     * @brief Konwertuje wiersz z bazy na obiekt użytkownika
-     * @param query Zapytanie SQL z wynikami
-     * @return Obiekt użytkownika
-     */
-    static User userFromRow(SQLite::Statement &query);
 };
 
 #endif
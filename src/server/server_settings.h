@@ -0,0 +1,175 @@
+#ifndef SERVER_SETTINGS_H
+#define SERVER_SETTINGS_H
+
+#include <cstring>
+#include <string>
+
+/**
+ * @class ServerSettings
+ * @brief Klasa zarządzająca ustawieniami serwera.
+ *
+ * Implementuje wzorzec Singleton i zapewnia dostęp do parametrów linii
+ * poleceń serwera. Nie zależy od Qt.
+ */
+class ServerSettings {
+public:
+    /**
+     * @brief Pobiera instancję klasy (implementacja wzorca Singleton)
+     * @return Referencja do jednej instancji klasy
+     */
+    static ServerSettings &getInstance() {
+        static ServerSettings instance;
+        return instance;
+    }
+
+    /**
+     * @brief Parsuje argumenty linii poleceń
+     * @param argc Liczba argumentów
+     * @param argv Tablica argumentów
+     */
+    void parseCommandLine(int argc, char *argv[]) {
+        for (int i = 1; i < argc; i++) {
+            if ((strcmp(argv[i], "--port") == 0 || strcmp(argv[i], "-p") == 0) && i + 1 < argc) {
+                _port = std::stoi(argv[i + 1]);
+                i++;
+            } else if ((strcmp(argv[i], "--database") == 0 || strcmp(argv[i], "-db") == 0) && i + 1 < argc) {
+                _dbPath = argv[i + 1];
+                i++;
+            } else if (strcmp(argv[i], "--verbose") == 0 || strcmp(argv[i], "-v") == 0) {
+                _verbose = true;
+            } else if (strcmp(argv[i], "--group-commit") == 0) {
+                _groupCommit = true;
+            } else if (strcmp(argv[i], "--log-async") == 0) {
+                _logAsync = true;
+            } else if (strcmp(argv[i], "--log-overflow") == 0 && i + 1 < argc) {
+                _logOverflow = argv[i + 1];
+                i++;
+            } else if (strcmp(argv[i], "--log-queue") == 0 && i + 1 < argc) {
+                _logQueueSize = std::stoul(argv[i + 1]);
+                i++;
+            } else if (strcmp(argv[i], "--log-file") == 0 && i + 1 < argc) {
+                _logFile = argv[i + 1];
+                i++;
+            } else if (strcmp(argv[i], "--slow-query-ms") == 0 && i + 1 < argc) {
+                _slowQueryMs = std::stoi(argv[i + 1]);
+                i++;
+            } else if (strcmp(argv[i], "--trace-file") == 0 && i + 1 < argc) {
+                _traceFile = argv[i + 1];
+                i++;
+            } else if (strcmp(argv[i], "--trace-format") == 0 && i + 1 < argc) {
+                _traceFormat = argv[i + 1];
+                i++;
+            } else if (strcmp(argv[i], "--trace-sample") == 0 && i + 1 < argc) {
+                _traceSampleRate = std::stod(argv[i + 1]);
+                i++;
+            }
+        }
+        _initialized = true;
+    }
+
+    /**
+     * @brief Pobiera port serwera
+     * @return Port serwera
+     */
+    int getPort() const { return _port; }
+
+    /**
+     * @brief Pobiera ścieżkę do pliku bazy danych
+     * @return Ścieżka do pliku bazy danych
+     */
+    std::string getDatabasePath() const { return _dbPath; }
+
+    /**
+     * @brief Sprawdza czy włączone jest szczegółowe logowanie
+     * @return Czy włączone jest szczegółowe logowanie
+     */
+    bool isVerboseLogging() const { return _verbose; }
+
+    /**
+     * @brief Sprawdza czy zapis rezerwacji ma korzystać z grupowego zatwierdzania
+     * @return Czy włączony jest potok zapisu rezerwacji
+     */
+    bool isGroupCommitEnabled() const { return _groupCommit; }
+
+    /**
+     * @brief Sprawdza czy logowanie ma być asynchroniczne
+     * @return Czy włączone jest logowanie asynchroniczne
+     */
+    bool isLogAsync() const { return _logAsync; }
+
+    /**
+     * @brief Pobiera zachowanie logowania przy pełnej kolejce
+     * @return "block", "drop" lub "sample"
+     */
+    std::string getLogOverflow() const { return _logOverflow; }
+
+    /**
+     * @brief Pobiera pojemność kolejki logowania asynchronicznego
+     * @return Liczba komunikatów
+     */
+    size_t getLogQueueSize() const { return _logQueueSize; }
+
+    /**
+     * @brief Pobiera ścieżkę pliku logów
+     * @return Ścieżka pliku (pusta - tylko konsola)
+     */
+    std::string getLogFile() const { return _logFile; }
+
+    /**
+     * @brief Pobiera próg logowania wolnych zapytań SQLite
+     * @return Próg w milisekundach
+     */
+    int getSlowQueryMs() const { return _slowQueryMs; }
+
+    /**
+     * @brief Pobiera ścieżkę pliku śladów żądań
+     * @return Ścieżka pliku (pusta - śledzenie wyłączone)
+     */
+    std::string getTraceFile() const { return _traceFile; }
+
+    /**
+     * @brief Pobiera format pliku śladów
+     * @return "chrome" lub "otlp"
+     */
+    std::string getTraceFormat() const { return _traceFormat; }
+
+    /**
+     * @brief Pobiera odsetek śledzonych żądań
+     * @return Odsetek żądań (0-1)
+     */
+    double getTraceSampleRate() const { return _traceSampleRate; }
+
+    /**
+     * @brief Sprawdza czy ustawienia zostały zainicjalizowane
+     * @return Czy ustawienia zostały zainicjalizowane
+     */
+    bool isInitialized() const { return _initialized; }
+
+private:
+    ServerSettings() : _initialized(false), _port(8080),
+                       _dbPath("deskpp.sqlite"), _verbose(false), _groupCommit(false),
+                       _logAsync(false), _logOverflow("block"), _logQueueSize(8192),
+                       _slowQueryMs(100),
+                       _traceFormat("chrome"), _traceSampleRate(1.0) {
+    }
+
+    ServerSettings(const ServerSettings &) = delete;
+
+    ServerSettings &operator=(const ServerSettings &) = delete;
+
+    bool _initialized;
+    int _port;
+    std::string _dbPath;
+    bool _verbose;
+    bool _groupCommit;
+    bool _logAsync;
+    std::string _logOverflow;
+    size_t _logQueueSize;
+    std::string _logFile;
+    int _slowQueryMs;
+    std::string _traceFile;
+    std::string _traceFormat;
+    double _traceSampleRate;
+};
+
+#endif
@@ -1,82 +1,107 @@
 #include "booking_service.h"
 
+#include <algorithm>
 #include <set>
+#include "../memory/memory_tracker.h"
+#include "../metrics/metrics.h"
+#include "../tracing/trace.h"
 
 BookingService::BookingService(BuildingRepository &buildingRepository, DeskRepository &deskRepository,
                                BookingRepository &bookingRepository)
     : Service<Booking>(bookingRepository),
-      _buildingRepo(buildingRepository),
-      _deskRepo(deskRepository),
-      _bookingRepo(bookingRepository) {
+      _bookingRepo(bookingRepository),
+      _catalog(buildingRepository, deskRepository) {
 }
 
-json BookingService::getAllBuildings() {
-    auto buildings = _buildingRepo.findAll();
-    json array = json::array();
-
-    for (const auto &building: buildings) {
-        auto buildingJson = building.toJson();
-        array.push_back(buildingJson);
-    }
-
-    return successResponse({{"buildings", array}});
+ArenaJson BookingService::getAllBuildings() {
+    TRACE_SPAN("BookingService::getAllBuildings");
+    MEMORY_SCOPE(Service);
+    return successResponse({{"buildings", _catalog.snapshot()->buildingsJson()}});
 }
 
-json BookingService::getAllDesks() {
-    auto desks = _deskRepo.findAll();
-    json array = json::array();
+ArenaJson BookingService::getAllDesks() {
+    TRACE_SPAN("BookingService::getAllDesks");
+    MEMORY_SCOPE(Service);
+    auto catalog = _catalog.snapshot();
+    ArenaJson array = ArenaJson::array();
 
-    for (const auto &desk: desks) {
-        json deskJson = desk.toJson();
+    // Rezerwacje są serializowane w trakcie odczytu, bez kopii pośrednich
+    for (const auto &desk: catalog->desks()) {
+        ArenaJson deskJson = desk.toJsonAs<ArenaJson>();
 
         // Dodaj rezerwacje
-        auto bookings = _bookingRepo.findByDeskId(desk.getId());
-        json bookingsArray = json::array();
-        for (const auto &booking: bookings) {
-            bookingsArray.push_back(booking.toJson());
+        ArenaJson bookingsArray = ArenaJson::array();
+        for (const auto &booking: _bookingRepo.cursorByDeskId(desk.getId())) {
+            bookingsArray.push_back(booking.toJsonAs<ArenaJson>());
         }
-        deskJson["bookings"] = bookingsArray;
-        array.push_back(deskJson);
+        deskJson["bookings"] = std::move(bookingsArray);
+        array.push_back(std::move(deskJson));
     }
 
-    return successResponse({{"desks", array}});
+    return successResponse({{"desks", std::move(array)}});
 }
 
-json BookingService::getDesksByBuilding(int buildingId) {
-    auto desks = _deskRepo.findByBuildingId(buildingId);
-    json array = json::array();
+ArenaJson BookingService::getDesksByBuilding(int buildingId) {
+    TRACE_SPAN("BookingService::getDesksByBuilding");
+    MEMORY_SCOPE(Service);
+    auto catalog = _catalog.snapshot();
+    ArenaJson array = ArenaJson::array();
 
-    for (const auto &desk: desks) {
-        json deskJson = desk.toJson();
+    for (const auto &desk: catalog->desksInBuilding(buildingId)) {
+        ArenaJson deskJson = desk.toJsonAs<ArenaJson>();
 
         // Dodaj rezerwacje
-        auto bookings = _bookingRepo.findByDeskId(desk.getId());
-        json bookingsArray = json::array();
-        for (const auto &booking: bookings) {
-            bookingsArray.push_back(booking.toJson());
+        ArenaJson bookingsArray = ArenaJson::array();
+        for (const auto &booking: _bookingRepo.cursorByDeskId(desk.getId())) {
+            bookingsArray.push_back(booking.toJsonAs<ArenaJson>());
         }
-        deskJson["bookings"] = bookingsArray;
-        array.push_back(deskJson);
+        deskJson["bookings"] = std::move(bookingsArray);
+        array.push_back(std::move(deskJson));
     }
 
-    return successResponse({{"desks", array}});
+    return successResponse({{"desks", std::move(array)}});
 }
 
-json BookingService::getBookingsForDesk(int deskId, const std::string &dateFrom, const std::string &dateTo) {
+ArenaJson BookingService::getBookingsForDesk(int deskId, const std::string &dateFrom, const std::string &dateTo) {
+    TRACE_SPAN("BookingService::getBookingsForDesk");
+    MEMORY_SCOPE(Service);
     auto bookings = _bookingRepo.findByDateRange(deskId, dateFrom, dateTo);
-    json array = json::array();
+    ArenaJson array = ArenaJson::array();
     for (const auto &booking: bookings) {
-        array.push_back(booking.toJson());
+        array.push_back(booking.toJsonAs<ArenaJson>());
     }
-    return successResponse({{"bookings", array}});
+    return successResponse({{"bookings", std::move(array)}});
 }
 
-json BookingService::addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo) {
+ArenaJson BookingService::addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo,
+                                     const std::string &idempotencyKey) {
+    TRACE_SPAN("BookingService::addBooking");
+    MEMORY_SCOPE(Service);
+    // Potok zapisu sam obsługuje idempotencję i konflikty terminów
+    if (_writer) {
+        return _writer->addBooking(deskId, userId, dateFrom, dateTo, idempotencyKey).get();
+    }
+
+    Date from = Date::fromString(dateFrom);
+    Date to = Date::fromString(dateTo);
+    if (!BookingRecord::validPeriod(from, to)) {
+        return errorResponse("Nieprawidłowy zakres dat");
+    }
+
     // Sprawdź czy biurko istnieje
-    if (!_deskRepo.findById(deskId)) {
+    if (!_catalog.snapshot()->findDesk(deskId)) {
         return errorResponse("Nie znaleziono biurka");
     }
 
+    // Sprawdzenie konfliktów i zapis są niepodzielne względem innych zapisów tego biurka
+    auto deskLock = _deskLocks.lock(deskId);
+
+    // Ponowione żądanie otrzymuje tę samą odpowiedź
+    std::string keyScope = BookingRepository::userKeyScope(userId);
+    if (auto replayed = replayedResponse(keyScope, idempotencyKey)) {
+        return *replayed;
+    }
+
     // Sprawdź czy nie ma nakładających się rezerwacji
     if (_bookingRepo.hasOverlappingBooking(deskId, dateFrom, dateTo)) {
         return errorResponse("Biurko jest już zarezerwowane na ten okres");
@@ -86,60 +111,347 @@ json BookingService::addBooking(int deskId, int userId, const std::string &dateF
     Booking booking;
     booking.setDeskId(deskId);
     booking.setUserId(userId);
-    booking.setDateFrom(dateFrom);
-    booking.setDateTo(dateTo);
-    Booking created = _repository.add(booking);
-    return successResponse({{"booking", created.toJson()}});
+    booking.setDateFrom(from);
+    booking.setDateTo(to);
+
+    // Rezerwacja i klucz idempotencji są zatwierdzane razem
+    auto transaction = _bookingRepo.beginWrite();
+    Booking created = transaction.repository().add(booking);
+    ArenaJson response = successResponse({{"booking", created.toJsonAs<ArenaJson>()}});
+    rememberResponse(transaction, keyScope, idempotencyKey, response);
+    transaction.commit();
+    return response;
 }
 
-json BookingService::cancelBooking(int bookingId) {
+ArenaJson BookingService::cancelBooking(int bookingId, const std::string &idempotencyKey) {
+    TRACE_SPAN("BookingService::cancelBooking");
+    MEMORY_SCOPE(Service);
+    if (_writer) {
+        return _writer->cancelBooking(bookingId, idempotencyKey).get();
+    }
+
+    std::string keyScope = BookingRepository::bookingKeyScope(bookingId);
+    if (auto replayed = replayedResponse(keyScope, idempotencyKey)) {
+        return *replayed;
+    }
+
     // Sprawdź czy istnieje
-    if (!_repository.findById(bookingId)) {
+    auto booking = _repository.findById(bookingId);
+    if (!booking) {
+        return errorResponse("Nie znaleziono rezerwacji");
+    }
+
+    auto deskLock = _deskLocks.lock(booking->getDeskId());
+    if (auto replayed = replayedResponse(keyScope, idempotencyKey)) {
+        return *replayed;
+    }
+
+    // Usunięcie i klucz idempotencji są zatwierdzane razem
+    auto transaction = _bookingRepo.beginWrite();
+
+    // Rezerwacja mogła zostać anulowana przez równoległe żądanie
+    if (!transaction.repository().remove(bookingId)) {
         return errorResponse("Nie znaleziono rezerwacji");
     }
-    _repository.remove(bookingId);
-    return successResponse({{"message", "Rezerwacja anulowana"}});
+    ArenaJson response = successResponse({{"message", "Rezerwacja anulowana"}});
+    rememberResponse(transaction, keyScope, idempotencyKey, response);
+    transaction.commit();
+    return response;
+}
+
+Task<ArenaJson> BookingService::getDesksAsync(std::optional<int> buildingId, std::optional<int> floor,
+                                              const OperationContext &context) {
+    co_await scheduleOn(_executor, context);
+    ArenaScope arenaScope(context.arena());
+    co_return interruptible(context, [&] {
+        if (buildingId && floor) {
+            return getDesksByBuildingAndFloor(*buildingId, *floor);
+        }
+        if (buildingId) {
+            return getDesksByBuilding(*buildingId);
+        }
+        return getAllDesks();
+    });
+}
+
+Task<ArenaJson> BookingService::getBookingsForDeskAsync(int deskId, std::string dateFrom, std::string dateTo,
+                                                        const OperationContext &context) {
+    co_await scheduleOn(_executor, context);
+    ArenaScope arenaScope(context.arena());
+    co_return interruptible(context, [&] { return getBookingsForDesk(deskId, dateFrom, dateTo); });
+}
+
+Task<ArenaJson> BookingService::addBookingAsync(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                                                std::string idempotencyKey, const OperationContext &context) {
+    if (_writer) {
+        // Korutyna czeka na zatwierdzenie paczki bez zajmowania wątku puli
+        context.throwIfStopped();
+        co_return co_await _writer->addBookingAsync(deskId, userId, std::move(dateFrom), std::move(dateTo),
+                                                    std::move(idempotencyKey), _executor, context);
+    }
+    co_await scheduleOn(_executor, context);
+    ArenaScope arenaScope(context.arena());
+    co_return interruptible(context, [&] { return addBooking(deskId, userId, dateFrom, dateTo, idempotencyKey); });
+}
+
+Task<ArenaJson> BookingService::cancelBookingAsync(int bookingId, std::string idempotencyKey,
+                                                   const OperationContext &context) {
+    if (_writer) {
+        context.throwIfStopped();
+        co_return co_await _writer->cancelBookingAsync(bookingId, std::move(idempotencyKey), _executor, context);
+    }
+    co_await scheduleOn(_executor, context);
+    ArenaScope arenaScope(context.arena());
+    co_return interruptible(context, [&] { return cancelBooking(bookingId, idempotencyKey); });
+}
+
+Task<ArenaJson> BookingService::getUserBookingsAsync(int userId, std::string from, std::string cursor, int limit,
+                                                     const OperationContext &context) {
+    co_await scheduleOn(_executor, context);
+    ArenaScope arenaScope(context.arena());
+    co_return interruptible(context, [&] { return getUserBookings(userId, from, cursor, limit); });
+}
+
+std::optional<ArenaJson> BookingService::replayedResponse(const std::string &scope,
+                                                          const std::string &idempotencyKey) {
+    if (idempotencyKey.empty()) {
+        return std::nullopt;
+    }
+
+    static const int cacheSeries = Metrics::instance().cacheSeries("idempotency");
+    auto stored = _bookingRepo.findIdempotentResponse(scope, idempotencyKey);
+    Metrics::instance().recordCache(cacheSeries, stored.has_value());
+    if (!stored) {
+        return std::nullopt;
+    }
+    LOG_DEBUG("Powtórzone żądanie{}", logFields("scope", scope, "idempotencyKey", idempotencyKey));
+    return ArenaJson::parse(*stored);
+}
+
+void BookingService::rememberResponse(BookingRepository::WriteTransaction &transaction, const std::string &scope,
+                                      const std::string &idempotencyKey, const ArenaJson &response) {
+    if (!idempotencyKey.empty()) {
+        transaction.repository().saveIdempotentResponse(scope, idempotencyKey, response.dump());
+    }
+}
+
+ArenaJson BookingService::getDesksByBuildingAndFloor(int buildingId, int floor) {
+    TRACE_SPAN("BookingService::getDesksByBuildingAndFloor");
+    MEMORY_SCOPE(Service);
+    return successResponse({{"desks", floorDesksToJson(buildingId, floor)}});
+}
+
+ArenaJson BookingService::floorDesksToJson(int buildingId, int floor) {
+    TRACE_SPAN("BookingService::floorDesksToJson");
+    auto catalog = _catalog.snapshot();
+    ArenaJson array = ArenaJson::array();
+
+    for (const auto &desk: catalog->desksOnFloor(buildingId, floor)) {
+        ArenaJson deskJson = desk.toJsonAs<ArenaJson>();
+
+        // Dodaj rezerwacje
+        ArenaJson bookingsArray = ArenaJson::array();
+        for (const auto &booking: _bookingRepo.cursorByDeskId(desk.getId())) {
+            bookingsArray.push_back(booking.toJsonAs<ArenaJson>());
+        }
+        deskJson["bookings"] = std::move(bookingsArray);
+        array.push_back(std::move(deskJson));
+    }
+
+    return array;
+}
+
+ArenaJson BookingService::getBootstrap(int userId) {
+    TRACE_SPAN("BookingService::getBootstrap");
+    MEMORY_SCOPE(Service);
+    auto catalog = _catalog.snapshot();
+    const auto &buildings = catalog->buildings();
+
+    // Nadchodzące rezerwacje użytkownika (posortowane po dacie)
+    Date today = Date::currentDate();
+    auto bookings = _bookingRepo.findByUserId(userId);
+    ArenaJson upcomingArray = ArenaJson::array();
+    uint16_t todayDay = BookingRecord::dayOf(today);
+    for (const auto &booking: bookings) {
+        if (booking.dayTo >= todayDay) {
+            upcomingArray.push_back(booking.toJsonAs<ArenaJson>());
+        }
+    }
+
+    // Wybierz piętro, z którego użytkownik najpewniej skorzysta
+    auto [buildingId, floor] = preferredFloor(*catalog, bookings, today);
+    if (buildingId <= 0 && !buildings.empty()) {
+        buildingId = buildings.front().getId();
+        floor = 1;
+    }
+
+    ArenaJson floorView = nullptr;
+    if (buildingId > 0) {
+        floorView = {
+            {"buildingId", buildingId},
+            {"floor", floor},
+            {"desks", floorDesksToJson(buildingId, floor)}
+        };
+    }
+
+    return successResponse({
+        {"buildings", catalog->buildingsJson()},
+        {"upcomingBookings", std::move(upcomingArray)},
+        {"floorView", std::move(floorView)}
+    });
 }
 
-json BookingService::getDesksByBuildingAndFloor(int buildingId, int floor) {
-    auto desks = _deskRepo.findByBuildingId(buildingId);
-    json array = json::array();
+std::pair<int, int> BookingService::preferredFloor(const CatalogSnapshot &catalog,
+                                                   const std::vector<BookingRecord> &bookings, Date today) {
+    uint16_t todayDay = BookingRecord::dayOf(today);
+
+    // Najbliższa trwająca lub nadchodząca rezerwacja oraz ostatnia zakończona
+    const BookingRecord *next = nullptr;
+    const BookingRecord *last = nullptr;
+    std::pair<int, int> nextLocation{0, 0}, lastLocation{0, 0};
 
-    for (const auto &desk: desks) {
-        // Filtruj po piętrze
-        if (desk.getFloor() != floor) {
+    for (const auto &booking: bookings) {
+        const Desk *desk = catalog.findDesk(booking.deskId);
+        if (!desk || desk->getBuildingId() <= 0) {
             continue;
         }
 
-        json deskJson = desk.toJson();
+        std::pair<int, int> location{desk->getBuildingId(), desk->getFloor()};
+        if (booking.dayTo >= todayDay) {
+            // Trwająca rezerwacja zaczyna się (dla tego wyboru) dzisiaj; przy remisie wygrywa niższe ID
+            auto startsAt = [todayDay](const BookingRecord &record) { return std::max(record.dayFrom, todayDay); };
+            if (!next || startsAt(booking) < startsAt(*next) ||
+                (startsAt(booking) == startsAt(*next) && booking.id < next->id)) {
+                next = &booking;
+                nextLocation = location;
+            }
+        } else if (!last || booking.dayTo > last->dayTo || (booking.dayTo == last->dayTo && booking.id > last->id)) {
+            last = &booking;
+            lastLocation = location;
+        }
+    }
 
-        // Dodaj rezerwacje
-        auto bookings = _bookingRepo.findByDeskId(desk.getId());
-        json bookingsArray = json::array();
-        for (const auto &booking: bookings) {
-            bookingsArray.push_back(booking.toJson());
+    return next ? nextLocation : lastLocation;
+}
+
+ArenaJson BookingService::getUserBookings(int userId, const std::string &from, const std::string &cursor, int limit) {
+    TRACE_SPAN("BookingService::getUserBookings");
+    MEMORY_SCOPE(Service);
+    auto isDate = [](const std::string &text) {
+        return Date::fromString(text).isValid();
+    };
+
+    if (!from.empty() && !isDate(from)) {
+        return errorResponse("Nieprawidłowa data początkowa");
+    }
+
+    // Kursor ma postać "yyyy-MM-dd:id" ostatniej rezerwacji poprzedniej strony
+    std::string afterDate;
+    int afterId = 0;
+    if (!cursor.empty()) {
+        auto separator = cursor.find(':');
+        afterDate = cursor.substr(0, separator);
+        try {
+            afterId = separator == std::string::npos ? -1 : std::stoi(cursor.substr(separator + 1));
+        } catch (const std::exception &) {
+            afterId = -1;
+        }
+        if (afterId < 0 || !isDate(afterDate)) {
+            return errorResponse("Nieprawidłowy kursor");
+        }
+    }
+
+    limit = std::clamp(limit, 1, MaxUserBookingsPage);
+
+    // Pobierz o jedną rezerwację więcej, aby wiedzieć czy istnieje następna strona
+    auto bookings = _bookingRepo.findPageByUserId(userId, from, afterDate, afterId, limit + 1);
+    bool hasMore = static_cast<int>(bookings.size()) > limit;
+    if (hasMore) {
+        bookings.pop_back();
+    }
+
+    auto catalog = _catalog.snapshot();
+
+    ArenaJson array = ArenaJson::array();
+    for (const auto &booking: bookings) {
+        ArenaJson bookingJson = booking.toJsonAs<ArenaJson>();
+
+        if (const Desk *desk = catalog->findDesk(booking.deskId)) {
+            const Building *building = catalog->findBuilding(desk->getBuildingId());
+
+            bookingJson["deskName"] = desk->getName();
+            bookingJson["buildingId"] = desk->getBuildingId();
+            bookingJson["floor"] = desk->getFloor();
+            bookingJson["buildingName"] = building ? building->getName() : "";
+        }
+        array.push_back(std::move(bookingJson));
+    }
+
+    ArenaJson nextCursor = nullptr;
+    if (hasMore) {
+        nextCursor = bookings.back().dateFrom().toString() + ":" + std::to_string(bookings.back().id);
+    }
+
+    return successResponse({{"bookings", std::move(array)}, {"nextCursor", std::move(nextCursor)}});
+}
+
+ArenaJson BookingService::reloadCatalog() {
+    _catalog.requestReload();
+    return successResponse({
+        {"message", "Zlecono przeładowanie katalogu"},
+        {"version", _catalog.snapshot()->version()}
+    });
+}
+
+ArenaJson BookingService::getDeskLockStats() {
+    auto stripes = _deskLocks.stats();
+
+    // Najbardziej obciążone paski na początku
+    std::sort(stripes.begin(), stripes.end(), [](const auto &a, const auto &b) {
+        return a.contended != b.contended ? a.contended > b.contended : a.acquisitions > b.acquisitions;
+    });
+
+    uint64_t acquisitions = 0, contended = 0, waitMicros = 0;
+    ArenaJson stripesArray = ArenaJson::array();
+    for (const auto &stripe: stripes) {
+        acquisitions += stripe.acquisitions;
+        contended += stripe.contended;
+        waitMicros += stripe.waitMicros;
+        if (stripesArray.size() < DeskLockStatsTop) {
+            stripesArray.push_back({
+                {"stripe", stripe.stripe},
+                {"acquisitions", stripe.acquisitions},
+                {"contended", stripe.contended},
+                {"waitMicros", stripe.waitMicros}
+            });
         }
-        deskJson["bookings"] = bookingsArray;
-        array.push_back(deskJson);
     }
 
-    return successResponse({{"desks", array}});
+    return successResponse({
+        {"stripeCount", _deskLocks.stripeCount()},
+        {"acquisitions", acquisitions},
+        {"contended", contended},
+        {"waitMicros", waitMicros},
+        {"stripes", stripesArray}
+    });
 }
 
-json BookingService::getFloorsByBuilding(int buildingId) {
+ArenaJson BookingService::getFloorsByBuilding(int buildingId) {
+    TRACE_SPAN("BookingService::getFloorsByBuilding");
+    MEMORY_SCOPE(Service);
     // Sprawdź czy budynek istnieje
-    auto buildingOpt = _buildingRepo.findById(buildingId);
-    if (!buildingOpt) {
+    auto catalog = _catalog.snapshot();
+    const Building *building = catalog->findBuilding(buildingId);
+    if (!building) {
         return errorResponse("Nie znaleziono budynku");
     }
 
-    Building building = *buildingOpt;
-    auto floors = building.getFloors();
+    auto floors = building->getFloors();
 
-    json floorsArray = json::array();
+    ArenaJson floorsArray = ArenaJson::array();
     for (int floor: floors) {
         floorsArray.push_back(floor);
     }
 
-    return successResponse({{"floors", floorsArray}});
+    return successResponse({{"floors", std::move(floorsArray)}});
 }
@@ -5,42 +5,68 @@
 #include "../repository/building_repository.h"
 #include "../repository/desk_repository.h"
 #include "../repository/booking_repository.h"
+#include "booking_writer.h"
+#include "catalog_store.h"
+#include "desk_lock_table.h"
+#include "../async/db_executor.h"
 
 /**
  * @class BookingService
  * @brief Serwis obsługujący operacje związane z rezerwacjami.
  *
  * Zapewnia funkcje zarządzania budynkami, biurkami i rezerwacjami.
+ * Budynki i biurka są odczytywane z migawki katalogu w pamięci,
+ * a z bazy danych pobierane są tylko rezerwacje. Zapisy rezerwacji są
+ * synchronizowane blokadami biurek, więc zapisy różnych biurek nie
+ * czekają na siebie.
  */
 class BookingService : public Service<Booking> {
 public:
     /**
      * @brief Konstruktor
-     * @param buildingRepository Referencja do repozytorium budynków
-     * @param deskRepository Referencja do repozytorium biurek
+     * @param buildingRepository Referencja do repozytorium budynków (źródło katalogu)
+     * @param deskRepository Referencja do repozytorium biurek (źródło katalogu)
      * @param bookingRepository Referencja do repozytorium rezerwacji
      */
     BookingService(BuildingRepository &buildingRepository, DeskRepository &deskRepository,
                    BookingRepository &bookingRepository);
 
+    /**
+     * @brief Kieruje dodawanie i anulowanie rezerwacji do potoku zapisu
+     * @param writer Potok zapisu z grupowym zatwierdzaniem (nullptr - zapis bezpośredni)
+     */
+    void setWriter(BookingWriter *writer) { _writer = writer; }
+
+    /**
+     * @brief Ustawia pulę wątków dla asynchronicznych wariantów metod
+     * @param executor Pula wątków bazy danych (nullptr - wykonanie na wątku wywołującym)
+     */
+    void setExecutor(DbExecutor *executor) { _executor = executor; }
+
+    /**
+     * @brief Zwraca katalog budynków i biurek (np. do przeładowania po zmianach)
+     * @return Katalog
+     */
+    CatalogStore &catalog() { return _catalog; }
+
     /**
      * @brief Pobiera wszystkie budynki
      * @return Obiekt JSON z listą budynków
      */
-    json getAllBuildings();
+    ArenaJson getAllBuildings();
 
     /**
      * @brief Pobiera wszystkie biurka
      * @return Obiekt JSON z listą biurek
      */
-    json getAllDesks();
+    ArenaJson getAllDesks();
 
     /**
      * @brief Pobiera biurka dla wybranego budynku
      * @param buildingId Identyfikator budynku
      * @return Obiekt JSON z listą biurek
      */
-    json getDesksByBuilding(int buildingId);
+    ArenaJson getDesksByBuilding(int buildingId);
 
     /**
      * @brief Pobiera rezerwacje dla biurka w określonym okresie
@@ -49,7 +75,7 @@ public:
      * @param dateTo Data końcowa
      * @return Obiekt JSON z listą rezerwacji
      */
-    json getBookingsForDesk(int deskId, const std::string &dateFrom, const std::string &dateTo);
+    ArenaJson getBookingsForDesk(int deskId, const std::string &dateFrom, const std::string &dateTo);
 
     /**
      * @brief Dodaje nową rezerwację
@@ -57,16 +83,19 @@ public:
      * @param userId Identyfikator użytkownika
      * @param dateFrom Data początkowa
      * @param dateTo Data końcowa
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
      * @return Obiekt JSON z wynikiem operacji
      */
-    json addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo);
+    ArenaJson addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo,
+                         const std::string &idempotencyKey = "");
 
     /**
      * @brief Anuluje rezerwację
      * @param bookingId Identyfikator rezerwacji
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
      * @return Obiekt JSON z wynikiem operacji
      */
-    json cancelBooking(int bookingId);
+    ArenaJson cancelBooking(int bookingId, const std::string &idempotencyKey = "");
 
     /**
      * @brief Pobiera biurka dla wybranego budynku i piętra
@@ -74,19 +103,191 @@ public:
      * @param floor Numer piętra
      * @return Obiekt JSON z listą biurek
      */
-    json getDesksByBuildingAndFloor(int buildingId, int floor);
+    ArenaJson getDesksByBuildingAndFloor(int buildingId, int floor);
 
     /**
      * @brief Pobiera piętra dla wybranego budynku
      * @param buildingId Identyfikator budynku
      * @return Obiekt JSON z listą pięter
      */
-    json getFloorsByBuilding(int buildingId);
+    ArenaJson getFloorsByBuilding(int buildingId);
+
+    /**
+     * @brief Pobiera dane startowe dla zalogowanego użytkownika
+     *
+     * Zwraca w jednej odpowiedzi budynki z piętrami, nadchodzące rezerwacje
+     * użytkownika oraz widok piętra, z którego najpewniej skorzysta
+     * (preferredFloor).
+     *
+     * @param userId Identyfikator użytkownika
+     * @return Obiekt JSON z danymi startowymi
+     */
+    ArenaJson getBootstrap(int userId);
+
+    /**
+     * @brief Pobiera stronę rezerwacji użytkownika
+     *
+     * Rezerwacje są uporządkowane po dacie rozpoczęcia. Odpowiedź zawiera
+     * nextCursor, który przekazany w kolejnym wywołaniu zwraca następną
+     * stronę (null oznacza ostatnią stronę).
+     *
+     * @param userId Identyfikator użytkownika
+     * @param from Najwcześniejsza data zakończenia (yyyy-MM-dd, pusta - bez ograniczenia)
+     * @param cursor Kursor z poprzedniej strony (pusty - pierwsza strona)
+     * @param limit Maksymalna liczba rezerwacji na stronie
+     * @return Obiekt JSON z rezerwacjami i kursorem następnej strony
+     */
+    ArenaJson getUserBookings(int userId, const std::string &from, const std::string &cursor, int limit);
+
+    /**
+     * @brief Zleca przeładowanie katalogu budynków i biurek po ich zmianie
+     *
+     * Nowa migawka jest budowana w tle; do czasu jej publikacji odczyty
+     * korzystają z poprzedniej.
+     *
+     * @return Obiekt JSON z wersją aktualnie opublikowanego katalogu
+     */
+    ArenaJson reloadCatalog();
+
+    /**
+     * @brief Pobiera statystyki blokad biurek
+     *
+     * Zwraca sumy dla wszystkich pasków oraz paski, na których zapisy
+     * najczęściej czekały na blokadę.
+     *
+     * @return Obiekt JSON ze statystykami blokad
+     */
+    ArenaJson getDeskLockStats();
+
+    /**
+     * @name Warianty asynchroniczne
+     *
+     * Korutyny wykonują odpowiednią metodę synchroniczną na puli wątków bazy
+     * danych. Przed rozpoczęciem pracy sprawdzają anulowanie i termin
+     * z kontekstu (wyjątek OperationCanceled), który musi istnieć do ich
+     * zakończenia; zapytanie przerwane z tego powodu (interruptStoppedOperations)
+     * również kończy się wyjątkiem OperationCanceled. Z potokiem zapisu
+     * (setWriter) zmiany rezerwacji czekają na zatwierdzenie paczki bez
+     * zajmowania wątku puli. Odpowiedź jest budowana w arenie żądania
+     * z kontekstu (jeśli ją podano). Pozostałe argumenty są kopiowane
+     * do ramki korutyny.
+     * @{
+     */
+
+    /**
+     * @brief Pobiera biurka (wszystkie, budynku lub piętra)
+     * @param buildingId Identyfikator budynku (brak - wszystkie biurka)
+     * @param floor Numer piętra (brak - wszystkie piętra budynku)
+     * @param context Kontekst operacji
+     * @return Korutyna zwracająca obiekt JSON z listą biurek
+     */
+    Task<ArenaJson> getDesksAsync(std::optional<int> buildingId, std::optional<int> floor,
+                                  const OperationContext &context);
+
+    /**
+     * @brief Pobiera rezerwacje dla biurka w określonym okresie
+     * @param deskId Identyfikator biurka
+     * @param dateFrom Data początkowa
+     * @param dateTo Data końcowa
+     * @param context Kontekst operacji
+     * @return Korutyna zwracająca obiekt JSON z listą rezerwacji
+     */
+    Task<ArenaJson> getBookingsForDeskAsync(int deskId, std::string dateFrom, std::string dateTo,
+                                            const OperationContext &context);
+
+    /**
+     * @brief Dodaje nową rezerwację
+     * @param deskId Identyfikator biurka
+     * @param userId Identyfikator użytkownika
+     * @param dateFrom Data początkowa
+     * @param dateTo Data końcowa
+     * @param idempotencyKey Klucz idempotencji (pusty - brak)
+     * @param context Kontekst operacji
+     * @return Korutyna zwracająca obiekt JSON z wynikiem operacji
+     */
+    Task<ArenaJson> addBookingAsync(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                                    std::string idempotencyKey, const OperationContext &context);
+
+    /**
+     * @brief Anuluje rezerwację
+     * @param bookingId Identyfikator rezerwacji
+     * @param idempotencyKey Klucz idempotencji (pusty - brak)
+     * @param context Kontekst operacji
+     * @return Korutyna zwracająca obiekt JSON z wynikiem operacji
+     */
+    Task<ArenaJson> cancelBookingAsync(int bookingId, std::string idempotencyKey, const OperationContext &context);
+
+    /**
+     * @brief Pobiera stronę rezerwacji użytkownika
+     * @param userId Identyfikator użytkownika
+     * @param from Najwcześniejsza data zakończenia (pusta - bez ograniczenia)
+     * @param cursor Kursor z poprzedniej strony (pusty - pierwsza strona)
+     * @param limit Maksymalna liczba rezerwacji na stronie
+     * @param context Kontekst operacji
+     * @return Korutyna zwracająca obiekt JSON z rezerwacjami i kursorem następnej strony
+     */
+    Task<ArenaJson> getUserBookingsAsync(int userId, std::string from, std::string cursor, int limit,
+                                         const OperationContext &context);
+
+    /** @} */
+
+    static constexpr int DefaultUserBookingsPage = 50;
+    static constexpr int MaxUserBookingsPage = 200;
+    static constexpr size_t DeskLockStatsTop = 16;
 
 private:
-    BuildingRepository &_buildingRepo;
-    DeskRepository &_deskRepo;
+    /**
+     * @brief Buduje listę biurek piętra wraz z rezerwacjami
+     * @param buildingId Identyfikator budynku
+     * @param floor Numer piętra
+     * @return Tablica JSON biurek
+     */
+    ArenaJson floorDesksToJson(int buildingId, int floor);
+
+    /**
+     * @brief Wyznacza preferowane piętro użytkownika na podstawie rezerwacji
+     *
+     * Wybiera piętro rezerwacji trwającej dzisiaj lub najbliższej nadchodzącej
+     * (trwająca liczy się jako zaczynająca się dzisiaj, przy równym początku
+     * wygrywa niższe ID). Bez takich rezerwacji wybiera piętro ostatnio
+     * zakończonej (przy równym końcu wygrywa wyższe ID). Rezerwacje biurek
+     * spoza katalogu są pomijane.
+     *
+     * @param catalog Migawka katalogu
+     * @param bookings Rekordy rezerwacji użytkownika
+     * @param today Bieżąca data
+     * @return Para (ID budynku, piętro) lub (0, 0), jeśli brak rezerwacji
+     */
+    static std::pair<int, int> preferredFloor(const CatalogSnapshot &catalog,
+                                              const std::vector<BookingRecord> &bookings, Date today);
+
+    /**
+     * @brief Zwraca wcześniejszą odpowiedź dla ponowionego żądania
+     * @param scope Zakres klucza (BookingRepository::userKeyScope lub bookingKeyScope)
+     * @param idempotencyKey Klucz idempotencji
+     * @return Opcjonalna zapisana odpowiedź
+     */
+    std::optional<ArenaJson> replayedResponse(const std::string &scope, const std::string &idempotencyKey);
+
+    /**
+     * @brief Zapamiętuje udaną odpowiedź dla klucza idempotencji
+     *
+     * Wywoływana w transakcji zapisu operacji, aby operacja i klucz
+     * zostały zatwierdzone razem.
+     *
+     * @param transaction Transakcja zapisu operacji
+     * @param scope Zakres klucza (BookingRepository::userKeyScope lub bookingKeyScope)
+     * @param idempotencyKey Klucz idempotencji
+     * @param response Odpowiedź
+     */
+    void rememberResponse(BookingRepository::WriteTransaction &transaction, const std::string &scope,
+                          const std::string &idempotencyKey, const ArenaJson &response);
+
     BookingRepository &_bookingRepo;
+    BookingWriter *_writer = nullptr;
+    DbExecutor *_executor = nullptr;
+    CatalogStore _catalog;
+    DeskLockTable _deskLocks;
 };
 
 #endif
@@ -0,0 +1,297 @@
+#include "booking_writer.h"
+#include <algorithm>
+#include "common/logger.h"
+#include "../memory/memory_tracker.h"
+#include "../metrics/metrics.h"
+
+BookingWriter::BookingWriter(std::shared_ptr<SQLite::Database> db, DeskRepository &deskRepository,
+                             BookingRepository &bookingRepository, size_t maxBatch)
+    : Service<Booking>(bookingRepository),
+      _db(std::move(db)),
+      _deskRepo(deskRepository),
+      _bookingRepo(bookingRepository),
+      _maxBatch(std::max<size_t>(1, maxBatch)) {
+    _thread = std::thread(&BookingWriter::run, this);
+}
+
+BookingWriter::~BookingWriter() {
+    _stopping.store(true);
+    _submitted.fetch_add(1);
+    _submitted.notify_one();
+    _thread.join();
+
+    // Operacje dodane w trakcie zatrzymywania nie zostaną już wykonane
+    while (auto request = _queue.pop()) {
+        request->complete(errorResponse("Serwer jest zatrzymywany"));
+    }
+
+    LOG_INFO("Potok zapisu rezerwacji: {} operacji w {} transakcjach", _operations, _transactions);
+}
+
+std::shared_ptr<SQLite::Database> BookingWriter::openConnection(const std::string &databasePath) {
+    return BookingRepository::openWriteConnection(databasePath);
+}
+
+BookingWriter::Request BookingWriter::addRequest(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                                                 std::string idempotencyKey) {
+    Request request;
+    request.kind = Request::Kind::Add;
+    request.deskId = deskId;
+    request.userId = userId;
+    request.dateFrom = std::move(dateFrom);
+    request.dateTo = std::move(dateTo);
+    request.idempotencyKey = std::move(idempotencyKey);
+    return request;
+}
+
+BookingWriter::Request BookingWriter::cancelRequest(int bookingId, std::string idempotencyKey) {
+    Request request;
+    request.kind = Request::Kind::Cancel;
+    request.bookingId = bookingId;
+    request.idempotencyKey = std::move(idempotencyKey);
+    return request;
+}
+
+std::future<ArenaJson> BookingWriter::addBooking(int deskId, int userId, const std::string &dateFrom,
+                                                 const std::string &dateTo, const std::string &idempotencyKey) {
+    return submitForFuture(addRequest(deskId, userId, dateFrom, dateTo, idempotencyKey));
+}
+
+std::future<ArenaJson> BookingWriter::cancelBooking(int bookingId, const std::string &idempotencyKey) {
+    return submitForFuture(cancelRequest(bookingId, idempotencyKey));
+}
+
+BookingWriter::Awaiter BookingWriter::addBookingAsync(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                                                      std::string idempotencyKey, DbExecutor *executor,
+                                                      const OperationContext &context) {
+    return Awaiter(*this, addRequest(deskId, userId, std::move(dateFrom), std::move(dateTo), std::move(idempotencyKey)),
+                   executor, context);
+}
+
+BookingWriter::Awaiter BookingWriter::cancelBookingAsync(int bookingId, std::string idempotencyKey,
+                                                         DbExecutor *executor, const OperationContext &context) {
+    return Awaiter(*this, cancelRequest(bookingId, std::move(idempotencyKey)), executor, context);
+}
+
+void BookingWriter::Awaiter::await_suspend(std::coroutine_handle<> handle) {
+    _request.complete = [this, handle](ArenaJson response) {
+        _response = std::move(response);
+        if (_executor) {
+            _executor->resume(handle);
+        } else {
+            handle.resume();
+        }
+    };
+    // Po przekazaniu operacji korutyna może zostać wznowiona na innym wątku
+    _writer.submit(std::move(_request));
+}
+
+ArenaJson BookingWriter::Awaiter::await_resume() {
+    if (_executor) {
+        Tracer::setCurrent(_context.trace());
+        OperationContext::setCurrent(&_context);
+    }
+    return std::move(_response);
+}
+
+std::future<ArenaJson> BookingWriter::submitForFuture(Request request) {
+    auto promise = std::make_shared<std::promise<ArenaJson>>();
+    auto future = promise->get_future();
+    request.complete = [promise](ArenaJson response) { promise->set_value(std::move(response)); };
+    submit(std::move(request));
+    return future;
+}
+
+void BookingWriter::submit(Request request) {
+    _queue.push(std::move(request));
+
+    // Zmiana licznika budzi wątek zapisujący czekający na nowe operacje
+    _submitted.fetch_add(1, std::memory_order_release);
+    _submitted.notify_one();
+}
+
+void BookingWriter::run() {
+    std::vector<Request> batch;
+    batch.reserve(_maxBatch);
+
+    while (true) {
+        uint64_t seen = _submitted.load(std::memory_order_acquire);
+
+        // Wszystko, co czeka w kolejce, trafia do jednej transakcji
+        while (batch.size() < _maxBatch) {
+            auto request = _queue.pop();
+            if (!request) {
+                break;
+            }
+            batch.push_back(std::move(*request));
+        }
+
+        if (batch.empty()) {
+            if (_stopping.load()) {
+                break;
+            }
+            _submitted.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+
+        commitBatch(batch);
+        batch.clear();
+    }
+}
+
+void BookingWriter::commitBatch(std::vector<Request> &batch) {
+    std::vector<ArenaJson> responses;
+    responses.reserve(batch.size());
+    _touchedDesks.clear();
+
+    try {
+        SQLite::Transaction transaction(*_db);
+        for (auto &request: batch) {
+            responses.push_back(apply(request));
+        }
+        transaction.commit();
+    } catch (const std::exception &e) {
+        LOG_ERROR("Błąd zapisu paczki operacji{}", logFields("operations", batch.size(), "error", e.what()));
+
+        // Stan w pamięci mógł objąć wycofane zmiany
+        for (int deskId: _touchedDesks) {
+            forgetDesk(deskId);
+        }
+        if (batch.size() > 1) {
+            commitEach(batch);
+        } else {
+            batch.front().complete(errorResponse("Błąd zapisu rezerwacji"));
+        }
+        return;
+    }
+
+    _operations += batch.size();
+    ++_transactions;
+    LOG_DEBUG("Zatwierdzono paczkę operacji zapisu{}", logFields("operations", batch.size()));
+
+    // Odpowiedzi są wydawane dopiero po zatwierdzeniu transakcji
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].complete(std::move(responses[i]));
+    }
+}
+
+void BookingWriter::commitEach(std::vector<Request> &batch) {
+    for (auto &request: batch) {
+        std::vector<Request> single;
+        single.push_back(std::move(request));
+        commitBatch(single);
+    }
+}
+
+ArenaJson BookingWriter::apply(Request &request) {
+    // Ponowione żądanie otrzymuje tę samą odpowiedź (także w obrębie paczki)
+    std::string keyScope = request.kind == Request::Kind::Add
+                               ? BookingRepository::userKeyScope(request.userId)
+                               : BookingRepository::bookingKeyScope(request.bookingId);
+    if (!request.idempotencyKey.empty()) {
+        static const int cacheSeries = Metrics::instance().cacheSeries("idempotency");
+        auto stored = _bookingRepo.findIdempotentResponse(keyScope, request.idempotencyKey);
+        Metrics::instance().recordCache(cacheSeries, stored.has_value());
+        if (stored) {
+            LOG_DEBUG("Powtórzone żądanie{}", logFields("idempotencyKey", request.idempotencyKey));
+            return ArenaJson::parse(*stored);
+        }
+    }
+
+    ArenaJson response = request.kind == Request::Kind::Add ? applyAdd(request) : applyCancel(request);
+
+    if (!request.idempotencyKey.empty() && response["status"] == "success") {
+        _bookingRepo.saveIdempotentResponse(keyScope, request.idempotencyKey, response.dump());
+    }
+    return response;
+}
+
+ArenaJson BookingWriter::applyAdd(const Request &request) {
+    Date dateFrom = Date::fromString(request.dateFrom);
+    Date dateTo = Date::fromString(request.dateTo);
+    if (!BookingRecord::validPeriod(dateFrom, dateTo)) {
+        return errorResponse("Nieprawidłowy zakres dat");
+    }
+
+    BookingBlock *bookings = deskBookings(request.deskId);
+    if (!bookings) {
+        return errorResponse("Nie znaleziono biurka");
+    }
+
+    if (bookings->overlaps(BookingRecord::dayOf(dateFrom), BookingRecord::dayOf(dateTo))) {
+        return errorResponse("Biurko jest już zarezerwowane na ten okres");
+    }
+
+    Booking booking;
+    booking.setDeskId(request.deskId);
+    booking.setUserId(request.userId);
+    booking.setDateFrom(dateFrom);
+    booking.setDateTo(dateTo);
+    Booking created = _repository.add(booking);
+
+    _touchedDesks.push_back(request.deskId);
+    bookings->insert(BookingRecord::fromBooking(created));
+    _bookingDesks[created.getId()] = request.deskId;
+
+    return successResponse({{"booking", created.toJsonAs<ArenaJson>()}});
+}
+
+ArenaJson BookingWriter::applyCancel(const Request &request) {
+    auto location = _bookingDesks.find(request.bookingId);
+    if (location == _bookingDesks.end()) {
+        // Biurko rezerwacji nie było jeszcze wczytane
+        auto booking = _bookingRepo.findById(request.bookingId);
+        if (!booking || !deskBookings(booking->getDeskId())) {
+            return errorResponse("Nie znaleziono rezerwacji");
+        }
+        location = _bookingDesks.find(request.bookingId);
+        if (location == _bookingDesks.end()) {
+            return errorResponse("Nie znaleziono rezerwacji");
+        }
+    }
+
+    int deskId = location->second;
+    _repository.remove(request.bookingId);
+
+    _touchedDesks.push_back(deskId);
+    _desks[deskId].erase(request.bookingId);
+    _bookingDesks.erase(location);
+
+    return successResponse({{"message", "Rezerwacja anulowana"}});
+}
+
+BookingBlock *BookingWriter::deskBookings(int deskId) {
+    static const int cacheSeries = Metrics::instance().cacheSeries("booking_writer_desks");
+    auto it = _desks.find(deskId);
+    Metrics::instance().recordCache(cacheSeries, it != _desks.end());
+    if (it != _desks.end()) {
+        return &it->second;
+    }
+
+    if (!_deskRepo.findById(deskId)) {
+        return nullptr;
+    }
+
+    MEMORY_SCOPE(Cache);
+    // Stan biurka jest dodawany dopiero po odczytaniu wszystkich rezerwacji
+    // Rekordy przychodzą posortowane po dacie, więc wstawiane są na koniec kolumn
+    BookingBlock bookings;
+    for (const auto &booking: _bookingRepo.cursorByDeskId(deskId)) {
+        bookings.insert(booking);
+    }
+    for (int32_t id: bookings.ids()) {
+        _bookingDesks[id] = deskId;
+    }
+    return &_desks.emplace(deskId, std::move(bookings)).first->second;
+}
+
+void BookingWriter::forgetDesk(int deskId) {
+    auto it = _desks.find(deskId);
+    if (it == _desks.end()) {
+        return;
+    }
+    for (int32_t id: it->second.ids()) {
+        _bookingDesks.erase(id);
+    }
+    _desks.erase(it);
+}
@@ -0,0 +1,229 @@
+#ifndef BOOKING_WRITER_H
+#define BOOKING_WRITER_H
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "service.h"
+#include "mpsc_queue.h"
+#include "../async/db_executor.h"
+#include "../repository/desk_repository.h"
+#include "../repository/booking_repository.h"
+
+/**
+ * @class BookingWriter
+ * @brief Jednowątkowy potok zapisu rezerwacji z grupowym zatwierdzaniem.
+ *
+ * Wątki obsługujące żądania dodają operacje do nieblokującej kolejki, a wątek
+ * zapisujący pobiera wszystkie oczekujące operacje i wykonuje je w jednej
+ * transakcji. Wynik każdej operacji jest przekazywany (przez std::future lub
+ * wznowienie oczekującej korutyny) dopiero po zatwierdzeniu transakcji,
+ * więc wiele jednoczesnych rezerwacji kosztuje kilka synchronizacji
+ * z dyskiem zamiast jednej na rezerwację.
+ *
+ * Konflikty terminów są sprawdzane w pamięci wątku zapisującego. Rezerwacje
+ * biurka są wczytywane z bazy przy pierwszej operacji na tym biurku
+ * do kolumnowego bloku BookingBlock.
+ */
+class BookingWriter : public Service<Booking> {
+    /**
+     * @brief Operacja zapisu oczekująca w kolejce
+     */
+    struct Request {
+        enum class Kind { Add, Cancel } kind;
+        int deskId = 0;
+        int userId = 0;
+        int bookingId = 0;
+        std::string dateFrom, dateTo;
+        std::string idempotencyKey;
+        std::function<void(ArenaJson)> complete; ///< Wywoływana z odpowiedzią na wątku zapisującym
+    };
+
+public:
+    /**
+     * @class Awaiter
+     * @brief Obiekt oczekiwania na wynik operacji zapisu
+     *
+     * Korutyna jest zawieszana do zatwierdzenia transakcji, a potem wznawiana
+     * na wątku puli bazy danych (bez puli - na wątku zapisującym), więc
+     * oczekiwanie na zapis nie zajmuje żadnego wątku.
+     */
+    class Awaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        ArenaJson await_resume();
+
+    private:
+        friend class BookingWriter;
+
+        Awaiter(BookingWriter &writer, Request request, DbExecutor *executor, const OperationContext &context)
+            : _writer(writer), _request(std::move(request)), _executor(executor), _context(context) {
+        }
+
+        BookingWriter &_writer;
+        Request _request;
+        DbExecutor *_executor;
+        const OperationContext &_context;
+        ArenaJson _response;
+    };
+
+    /**
+     * @brief Konstruktor (uruchamia wątek zapisujący)
+     * @param db Połączenie z bazą danych używane wyłącznie przez wątek zapisujący
+     * @param deskRepository Repozytorium biurek na tym połączeniu
+     * @param bookingRepository Repozytorium rezerwacji na tym połączeniu
+     * @param maxBatch Maksymalna liczba operacji w jednej transakcji
+     */
+    BookingWriter(std::shared_ptr<SQLite::Database> db, DeskRepository &deskRepository,
+                  BookingRepository &bookingRepository, size_t maxBatch = DefaultMaxBatch);
+
+    /**
+     * @brief Destruktor (wykonuje oczekujące operacje i zatrzymuje wątek)
+     */
+    ~BookingWriter();
+
+    BookingWriter(const BookingWriter &) = delete;
+    BookingWriter &operator=(const BookingWriter &) = delete;
+
+    /**
+     * @brief Otwiera połączenie z bazą przeznaczone dla wątku zapisującego
+     *
+     * Włącza tryb WAL, aby odczyty na innych połączeniach nie czekały
+     * na zatwierdzenie paczki.
+     *
+     * @param databasePath Ścieżka do pliku bazy danych
+     * @return Połączenie z bazą danych
+     */
+    static std::shared_ptr<SQLite::Database> openConnection(const std::string &databasePath);
+
+    /**
+     * @brief Zleca dodanie rezerwacji
+     * @param deskId Identyfikator biurka
+     * @param userId Identyfikator użytkownika
+     * @param dateFrom Data początkowa (yyyy-MM-dd)
+     * @param dateTo Data końcowa (yyyy-MM-dd)
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
+     * @return Odpowiedź JSON dostępna po zatwierdzeniu transakcji
+     */
+    std::future<ArenaJson> addBooking(int deskId, int userId, const std::string &dateFrom, const std::string &dateTo,
+                                      const std::string &idempotencyKey = "");
+
+    /**
+     * @brief Zleca anulowanie rezerwacji
+     * @param bookingId Identyfikator rezerwacji
+     * @param idempotencyKey Klucz idempotencji (opcjonalny)
+     * @return Odpowiedź JSON dostępna po zatwierdzeniu transakcji
+     */
+    std::future<ArenaJson> cancelBooking(int bookingId, const std::string &idempotencyKey = "");
+
+    /**
+     * @brief Zleca dodanie rezerwacji i zwraca obiekt oczekiwania na wynik
+     * @param deskId Identyfikator biurka
+     * @param userId Identyfikator użytkownika
+     * @param dateFrom Data początkowa (yyyy-MM-dd)
+     * @param dateTo Data końcowa (yyyy-MM-dd)
+     * @param idempotencyKey Klucz idempotencji (pusty - brak)
+     * @param executor Pula, na której korutyna zostanie wznowiona (nullptr - wątek zapisujący)
+     * @param context Kontekst operacji (jego ślad trafia na wątek wznowienia)
+     * @return Obiekt do użycia z co_await, zwracający odpowiedź JSON
+     */
+    Awaiter addBookingAsync(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                            std::string idempotencyKey, DbExecutor *executor, const OperationContext &context);
+
+    /**
+     * @brief Zleca anulowanie rezerwacji i zwraca obiekt oczekiwania na wynik
+     * @param bookingId Identyfikator rezerwacji
+     * @param idempotencyKey Klucz idempotencji (pusty - brak)
+     * @param executor Pula, na której korutyna zostanie wznowiona (nullptr - wątek zapisujący)
+     * @param context Kontekst operacji (jego ślad trafia na wątek wznowienia)
+     * @return Obiekt do użycia z co_await, zwracający odpowiedź JSON
+     */
+    Awaiter cancelBookingAsync(int bookingId, std::string idempotencyKey, DbExecutor *executor,
+                               const OperationContext &context);
+
+    static constexpr size_t DefaultMaxBatch = 256;
+
+private:
+    static Request addRequest(int deskId, int userId, std::string dateFrom, std::string dateTo,
+                              std::string idempotencyKey);
+    static Request cancelRequest(int bookingId, std::string idempotencyKey);
+
+    /**
+     * @brief Dodaje operację do kolejki i zwraca przyszłą odpowiedź
+     * @param request Operacja (bez funkcji complete)
+     * @return Przyszła odpowiedź operacji
+     */
+    std::future<ArenaJson> submitForFuture(Request request);
+
+    /**
+     * @brief Dodaje operację do kolejki i budzi wątek zapisujący
+     * @param request Operacja
+     */
+    void submit(Request request);
+
+    /**
+     * @brief Główna pętla wątku zapisującego
+     */
+    void run();
+
+    /**
+     * @brief Wykonuje paczkę operacji w jednej transakcji
+     * @param batch Operacje
+     */
+    void commitBatch(std::vector<Request> &batch);
+
+    /**
+     * @brief Wykonuje operacje w osobnych transakcjach (po błędzie paczki)
+     * @param batch Operacje
+     */
+    void commitEach(std::vector<Request> &batch);
+
+    /**
+     * @brief Wykonuje operację w bieżącej transakcji
+     * @param request Operacja
+     * @return Odpowiedź JSON
+     */
+    ArenaJson apply(Request &request);
+
+    ArenaJson applyAdd(const Request &request);
+    ArenaJson applyCancel(const Request &request);
+
+    /**
+     * @brief Zwraca rezerwacje biurka, wczytując je przy pierwszym użyciu
+     * @param deskId Identyfikator biurka
+     * @return Rezerwacje biurka lub nullptr, jeśli biurko nie istnieje
+     */
+    BookingBlock *deskBookings(int deskId);
+
+    /**
+     * @brief Usuwa biurko ze stanu w pamięci (zostanie wczytane ponownie z bazy)
+     * @param deskId Identyfikator biurka
+     */
+    void forgetDesk(int deskId);
+
+    std::shared_ptr<SQLite::Database> _db;
+    DeskRepository &_deskRepo;
+    BookingRepository &_bookingRepo;
+    size_t _maxBatch;
+
+    MpscQueue<Request> _queue;
+    std::atomic<uint64_t> _submitted{0};
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+
+    // Stan w pamięci (tylko wątek zapisujący)
+    std::unordered_map<int, BookingBlock> _desks;
+    std::unordered_map<int, int> _bookingDesks; ///< ID rezerwacji -> ID biurka
+    std::vector<int> _touchedDesks;
+    uint64_t _operations = 0;
+    uint64_t _transactions = 0;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "catalog_store.h"
+#include <algorithm>
+#include <tuple>
+#include "common/logger.h"
+#include "../memory/memory_tracker.h"
+
+namespace {
+    /**
+     * @brief Porównuje biurka z identyfikatorem budynku (dla std::equal_range)
+     */
+    struct ByBuilding {
+        bool operator()(const Desk &desk, int buildingId) const { return desk.getBuildingId() < buildingId; }
+        bool operator()(int buildingId, const Desk &desk) const { return buildingId < desk.getBuildingId(); }
+    };
+
+    /**
+     * @brief Porównuje biurka jednego budynku z numerem piętra
+     */
+    struct ByFloor {
+        bool operator()(const Desk &desk, int floor) const { return desk.getFloor() < floor; }
+        bool operator()(int floor, const Desk &desk) const { return floor < desk.getFloor(); }
+    };
+}
+
+std::shared_ptr<const CatalogSnapshot> CatalogSnapshot::load(BuildingRepository &buildingRepository,
+                                                             DeskRepository &deskRepository, uint64_t version) {
+    MEMORY_SCOPE(Cache);
+    auto snapshot = std::make_shared<CatalogSnapshot>();
+    snapshot->_version = version;
+
+    snapshot->_buildings = buildingRepository.findAll();
+    std::sort(snapshot->_buildings.begin(), snapshot->_buildings.end(),
+              [](const Building &a, const Building &b) { return a.getId() < b.getId(); });
+
+    snapshot->_desks = deskRepository.findAll();
+    std::sort(snapshot->_desks.begin(), snapshot->_desks.end(), [](const Desk &a, const Desk &b) {
+        return std::tuple(a.getBuildingId(), a.getFloor(), a.getId()) <
+               std::tuple(b.getBuildingId(), b.getFloor(), b.getId());
+    });
+
+    snapshot->_buildingsJson = json::array();
+    for (size_t i = 0; i < snapshot->_buildings.size(); ++i) {
+        snapshot->_buildingIndex.emplace(snapshot->_buildings[i].getId(), i);
+        snapshot->_buildingsJson.push_back(snapshot->_buildings[i].toJson());
+    }
+    for (size_t i = 0; i < snapshot->_desks.size(); ++i) {
+        snapshot->_deskIndex.emplace(snapshot->_desks[i].getId(), i);
+    }
+    return snapshot;
+}
+
+std::span<const Desk> CatalogSnapshot::desksInBuilding(int buildingId) const {
+    auto [first, last] = std::equal_range(_desks.begin(), _desks.end(), buildingId, ByBuilding{});
+    return {first, last};
+}
+
+std::span<const Desk> CatalogSnapshot::desksOnFloor(int buildingId, int floor) const {
+    std::span<const Desk> building = desksInBuilding(buildingId);
+    auto [first, last] = std::equal_range(building.begin(), building.end(), floor, ByFloor{});
+    return {first, last};
+}
+
+const Building *CatalogSnapshot::findBuilding(int id) const {
+    auto it = _buildingIndex.find(id);
+    return it != _buildingIndex.end() ? &_buildings[it->second] : nullptr;
+}
+
+const Desk *CatalogSnapshot::findDesk(int id) const {
+    auto it = _deskIndex.find(id);
+    return it != _deskIndex.end() ? &_desks[it->second] : nullptr;
+}
+
+CatalogStore::CatalogStore(BuildingRepository &buildingRepository, DeskRepository &deskRepository)
+    : _buildingRepo(buildingRepository), _deskRepo(deskRepository) {
+    reload();
+}
+
+CatalogStore::~CatalogStore() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _requested.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void CatalogStore::reload() {
+    // Przeładowania są wykonywane po kolei, więc wersje rosną zgodnie z kolejnością publikacji
+    std::lock_guard lock(_reloadMutex);
+    auto snapshot = CatalogSnapshot::load(_buildingRepo, _deskRepo, ++_version);
+    _current.store(std::move(snapshot), std::memory_order_release);
+    LOG_DEBUG("Opublikowano katalog w wersji {}", _version);
+}
+
+void CatalogStore::requestReload() {
+    {
+        std::lock_guard lock(_mutex);
+        _reloadPending = true;
+        if (!_thread.joinable()) {
+            _thread = std::thread(&CatalogStore::reloadLoop, this);
+        }
+    }
+    _requested.notify_one();
+}
+
+void CatalogStore::reloadLoop() {
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _requested.wait(lock, [this] { return _stopping || _reloadPending; });
+        if (_stopping) {
+            return;
+        }
+        _reloadPending = false;
+
+        lock.unlock();
+        try {
+            reload();
+        } catch (const std::exception &e) {
+            LOG_ERROR("Błąd przeładowania katalogu: {}", e.what());
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,161 @@
+#ifndef CATALOG_STORE_H
+#define CATALOG_STORE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "../repository/building_repository.h"
+#include "../repository/desk_repository.h"
+
+using json = nlohmann::json;
+
+/**
+ * @class CatalogSnapshot
+ * @brief Niezmienna migawka budynków i biurek.
+ *
+ * Biurka są przechowywane w jednej tablicy uporządkowanej po budynku,
+ * piętrze i identyfikatorze, więc biurka budynku lub piętra tworzą ciągły
+ * fragment tablicy. Po opublikowaniu migawka nie jest modyfikowana, dlatego
+ * może być czytana z wielu wątków bez synchronizacji.
+ */
+class CatalogSnapshot {
+public:
+    /**
+     * @brief Wczytuje migawkę z bazy danych
+     * @param buildingRepository Repozytorium budynków
+     * @param deskRepository Repozytorium biurek
+     * @param version Numer wersji migawki
+     * @return Nowa migawka
+     */
+    static std::shared_ptr<const CatalogSnapshot> load(BuildingRepository &buildingRepository,
+                                                       DeskRepository &deskRepository, uint64_t version);
+
+    /**
+     * @brief Zwraca numer wersji migawki
+     * @return Numer wersji (rośnie z każdym przeładowaniem)
+     */
+    uint64_t version() const { return _version; }
+
+    /**
+     * @brief Zwraca budynki uporządkowane po identyfikatorze
+     * @return Budynki
+     */
+    const std::vector<Building> &buildings() const { return _buildings; }
+
+    /**
+     * @brief Zwraca budynki w formacie JSON (serializowane raz na migawkę)
+     * @return Tablica JSON budynków
+     */
+    const json &buildingsJson() const { return _buildingsJson; }
+
+    /**
+     * @brief Zwraca wszystkie biurka
+     * @return Biurka uporządkowane po budynku, piętrze i identyfikatorze
+     */
+    std::span<const Desk> desks() const { return _desks; }
+
+    /**
+     * @brief Zwraca biurka budynku
+     * @param buildingId Identyfikator budynku
+     * @return Biurka uporządkowane po piętrze i identyfikatorze
+     */
+    std::span<const Desk> desksInBuilding(int buildingId) const;
+
+    /**
+     * @brief Zwraca biurka piętra
+     * @param buildingId Identyfikator budynku
+     * @param floor Numer piętra
+     * @return Biurka uporządkowane po identyfikatorze
+     */
+    std::span<const Desk> desksOnFloor(int buildingId, int floor) const;
+
+    /**
+     * @brief Wyszukuje budynek
+     * @param id Identyfikator budynku
+     * @return Wskaźnik do budynku lub nullptr (ważny, dopóki istnieje migawka)
+     */
+    const Building *findBuilding(int id) const;
+
+    /**
+     * @brief Wyszukuje biurko
+     * @param id Identyfikator biurka
+     * @return Wskaźnik do biurka lub nullptr (ważny, dopóki istnieje migawka)
+     */
+    const Desk *findDesk(int id) const;
+
+private:
+    uint64_t _version = 0;
+    std::vector<Building> _buildings;
+    std::vector<Desk> _desks;
+    std::unordered_map<int, size_t> _buildingIndex;
+    std::unordered_map<int, size_t> _deskIndex;
+    json _buildingsJson;
+};
+
+/**
+ * @class CatalogStore
+ * @brief Publikuje aktualną migawkę budynków i biurek.
+ *
+ * Odczyt migawki to jedno atomowe pobranie wskaźnika, bez blokad i zapytań
+ * SQL. Po zmianie budynków lub biurek nowa migawka jest budowana w tle
+ * i podmieniana atomowo; czytelnicy, którzy pobrali poprzednią migawkę,
+ * korzystają z niej do końca obsługi żądania.
+ */
+class CatalogStore {
+public:
+    /**
+     * @brief Konstruktor (wczytuje pierwszą migawkę)
+     * @param buildingRepository Repozytorium budynków
+     * @param deskRepository Repozytorium biurek
+     */
+    CatalogStore(BuildingRepository &buildingRepository, DeskRepository &deskRepository);
+
+    /**
+     * @brief Destruktor (zatrzymuje wątek przeładowania)
+     */
+    ~CatalogStore();
+
+    CatalogStore(const CatalogStore &) = delete;
+    CatalogStore &operator=(const CatalogStore &) = delete;
+
+    /**
+     * @brief Zwraca aktualną migawkę
+     * @return Migawka
+     */
+    std::shared_ptr<const CatalogSnapshot> snapshot() const { return _current.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Wczytuje i publikuje nową migawkę na bieżącym wątku
+     */
+    void reload();
+
+    /**
+     * @brief Zleca przeładowanie w tle (kolejne zlecenia przed jego wykonaniem są łączone)
+     */
+    void requestReload();
+
+private:
+    void reloadLoop();
+
+    BuildingRepository &_buildingRepo;
+    DeskRepository &_deskRepo;
+    std::atomic<std::shared_ptr<const CatalogSnapshot>> _current;
+
+    std::mutex _reloadMutex;
+    uint64_t _version = 0;
+
+    std::mutex _mutex;
+    std::condition_variable _requested;
+    bool _reloadPending = false;
+    bool _stopping = false;
+    std::thread _thread;
+};
+
+#endif
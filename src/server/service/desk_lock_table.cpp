@@ -0,0 +1,50 @@
+#include "desk_lock_table.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+DeskLockTable::DeskLockTable(size_t stripes)
+    : _bits(std::bit_width(std::bit_ceil(std::clamp<size_t>(stripes, 2, MaxStripes)) - 1)),
+      _stripes(std::make_unique<Stripe[]>(size_t{1} << _bits)) {
+}
+
+std::unique_lock<std::mutex> DeskLockTable::lock(int deskId) {
+    Stripe &stripe = _stripes[stripeOf(deskId)];
+
+    // Czas jest mierzony tylko wtedy, gdy blokada jest zajęta
+    std::unique_lock lock(stripe.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        auto start = std::chrono::steady_clock::now();
+        lock.lock();
+        auto waited = std::chrono::steady_clock::now() - start;
+
+        stripe.contended.fetch_add(1, std::memory_order_relaxed);
+        stripe.waitNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+                                   std::memory_order_relaxed);
+    }
+    stripe.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    return lock;
+}
+
+size_t DeskLockTable::stripeOf(int deskId) const {
+    // Mieszanie Fibonacciego rozkłada kolejne ID biurek na różne paski
+    return (static_cast<uint32_t>(deskId) * 0x9E3779B1u) >> (32 - _bits);
+}
+
+std::vector<DeskLockTable::StripeStats> DeskLockTable::stats() const {
+    std::vector<StripeStats> result;
+    for (size_t i = 0; i < stripeCount(); ++i) {
+        const Stripe &stripe = _stripes[i];
+        uint64_t acquisitions = stripe.acquisitions.load(std::memory_order_relaxed);
+        if (acquisitions == 0) {
+            continue;
+        }
+        result.push_back({
+            i,
+            acquisitions,
+            stripe.contended.load(std::memory_order_relaxed),
+            stripe.waitNanos.load(std::memory_order_relaxed) / 1000
+        });
+    }
+    return result;
+}
@@ -0,0 +1,92 @@
+#ifndef DESK_LOCK_TABLE_H
+#define DESK_LOCK_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class DeskLockTable
+ * @brief Tablica blokad rezerwacji podzielona na paski według ID biurka.
+ *
+ * Każde biurko jest przypisane do jednego z pasków, więc sprawdzenie
+ * konfliktów i zapis rezerwacji jednego biurka są wykonywane pojedynczo,
+ * a rezerwacje biurek z różnych pasków nie czekają na siebie. Liczba
+ * pasków jest stała, niezależnie od liczby biurek. Sprawdzenia konfliktów
+ * różnych biurek działają równolegle; sam zapis odbywa się w transakcji
+ * BEGIN IMMEDIATE na połączeniu zapisu wątku (BookingRepository::beginWrite),
+ * a SQLite zatwierdza takie transakcje pojedynczo, więc blokada zapisu bazy
+ * jest zajmowana tylko na czas wstawienia wiersza i klucza idempotencji.
+ *
+ * Dla każdego paska liczone są pobrania blokady, pobrania, które musiały
+ * czekać, oraz łączny czas oczekiwania.
+ */
+class DeskLockTable {
+public:
+    /**
+     * @brief Statystyki jednego paska
+     */
+    struct StripeStats {
+        size_t stripe = 0;
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;
+        uint64_t waitMicros = 0;
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param stripes Liczba pasków (zaokrąglana w górę do potęgi dwójki, najwyżej MaxStripes)
+     */
+    explicit DeskLockTable(size_t stripes = DefaultStripes);
+
+    DeskLockTable(const DeskLockTable &) = delete;
+    DeskLockTable &operator=(const DeskLockTable &) = delete;
+
+    /**
+     * @brief Blokuje pasek biurka
+     * @param deskId Identyfikator biurka
+     * @return Blokada zwalniana przy zniszczeniu
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> lock(int deskId);
+
+    /**
+     * @brief Zwraca numer paska biurka
+     * @param deskId Identyfikator biurka
+     * @return Numer paska
+     */
+    size_t stripeOf(int deskId) const;
+
+    /**
+     * @brief Zwraca liczbę pasków
+     * @return Liczba pasków
+     */
+    size_t stripeCount() const { return size_t{1} << _bits; }
+
+    /**
+     * @brief Zwraca statystyki pasków, których blokady były pobierane
+     * @return Statystyki w kolejności numerów pasków
+     */
+    std::vector<StripeStats> stats() const;
+
+    static constexpr size_t DefaultStripes = 256;
+    static constexpr size_t MaxStripes = 65536;
+
+private:
+    /**
+     * @brief Pasek w osobnej linii pamięci podręcznej, aby liczniki
+     *        sąsiednich pasków nie unieważniały się nawzajem
+     */
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+        std::atomic<uint64_t> acquisitions{0};
+        std::atomic<uint64_t> contended{0};
+        std::atomic<uint64_t> waitNanos{0};
+    };
+
+    unsigned _bits;
+    std::unique_ptr<Stripe[]> _stripes;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Nieblokująca kolejka FIFO wielu producentów i jednego konsumenta.
+ *
+ * Producenci dodają elementy jedną operacją atomową (exchange) bez blokad,
+ * a jedyny konsument pobiera je w kolejności dodania. Element dodany przez
+ * producenta, który nie zdążył jeszcze dołączyć węzła do listy, staje się
+ * widoczny dla konsumenta chwilę później.
+ *
+ * @tparam T Typ elementów kolejki
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() : _head(new Node()), _tail(_head.load(std::memory_order_relaxed)) {
+    }
+
+    ~MpscQueue() {
+        while (pop()) {
+        }
+        delete _tail;
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * @brief Dodaje element (może być wywoływane z wielu wątków)
+     * @param value Element
+     */
+    void push(T value) {
+        Node *node = new Node();
+        node->value.emplace(std::move(value));
+
+        Node *previous = _head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pobiera najstarszy element (tylko z wątku konsumenta)
+     * @return Element lub brak, jeśli kolejka jest pusta
+     */
+    std::optional<T> pop() {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return std::nullopt;
+        }
+
+        // Następny węzeł staje się nowym węzłem pustym
+        std::optional<T> value = std::move(next->value);
+        next->value.reset();
+        _tail = next;
+        delete tail;
+        return value;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        std::optional<T> value;
+    };
+
+    std::atomic<Node *> _head;
+    Node *_tail;
+};
+
+#endif
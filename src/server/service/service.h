@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include "../repository/repository.h"
+#include "../memory/request_arena.h"
 
 using json = nlohmann::json;
 
@@ -13,7 +14,9 @@ using json = nlohmann::json;
  * @brief Klasa bazowa dla serwisów aplikacji.
  *
  * Zapewnia wspólne funkcje do obsługi operacji na danych
- * i komunikacji między kontrolerami a repozytoriami.
+ * i komunikacji między kontrolerami a repozytoriami. Odpowiedzi są
+ * dokumentami ArenaJson, więc w zakresie areny żądania (ArenaScope)
+ * ich węzły pochodzą z areny.
  *
  * @tparam T Typ encji obsługiwanej przez serwis
  */
@@ -34,10 +37,13 @@ protected:
      * @param data Dane do dołączenia do odpowiedzi (opcjonalne)
      * @return Obiekt JSON z informacją o sukcesie
      */
-    json successResponse(const json &data = {}) {
-        json response = {{"status", "success"}};
-        if (!data.empty()) {
-            response.merge_patch(data);
+    ArenaJson successResponse(ArenaJson data = {}) {
+        ArenaJson response = {{"status", "success"}};
+        // Wartości są przenoszone bez kopii; puste (null) są pomijane jak w JSON Merge Patch
+        for (auto &[key, value]: data.items()) {
+            if (!value.is_null()) {
+                response[key] = std::move(value);
+            }
         }
         return response;
     }
@@ -47,7 +53,7 @@ protected:
      * @param message Komunikat błędu
      * @return Obiekt JSON z informacją o błędzie
      */
-    json errorResponse(const std::string &message) {
+    ArenaJson errorResponse(const std::string &message) {
         return {{"status", "error"}, {"message", message}};
     }
 
@@ -57,8 +63,8 @@ protected:
      * @param key Klucz dla tablicy w odpowiedzi
      * @return Obiekt JSON z encjami
      */
-    json entityListToJson(const std::vector<T> &entities, const std::string &key) {
-        json array = json::array();
+    ArenaJson entityListToJson(const std::vector<T> &entities, const std::string &key) {
+        ArenaJson array = ArenaJson::array();
         for (const auto &entity: entities) {
             array.push_back(entity.toJson());
         }
@@ -1,11 +1,13 @@
 #include "user_service.h"
+#include "../memory/memory_tracker.h"
 
 UserService::UserService(UserRepository &userRepository)
     : Service<User>(userRepository), _userRepo(userRepository) {
 }
 
-json UserService::registerUser(const std::string &username, const std::string &password,
-                               const std::string &email) {
+ArenaJson UserService::registerUser(const std::string &username, const std::string &password,
+                                    const std::string &email) {
+    MEMORY_SCOPE(Service);
     // Sprawdź czy użytkownik istnieje
     if (_userRepo.findByUsername(username) || _userRepo.findByEmail(email)) {
         return errorResponse("Nazwa użytkownika lub email już istnieje");
@@ -21,7 +23,8 @@ json UserService::registerUser(const std::string &username, const std::string &p
     return successResponse({{"user", createdUser.toJson()}});
 }
 
-json UserService::loginUser(const std::string &username, const std::string &password) {
+ArenaJson UserService::loginUser(const std::string &username, const std::string &password) {
+    MEMORY_SCOPE(Service);
     // Generuj hash hasła
     std::string passwordHash = hashPassword(password);
 
@@ -25,7 +25,7 @@ public:
      * @param email Adres email
      * @return Obiekt JSON z wynikiem operacji
      */
-    json registerUser(const std::string &username, const std::string &password, const std::string &email);
+    ArenaJson registerUser(const std::string &username, const std::string &password, const std::string &email);
 
     /**
      * @brief Loguje użytkownika
@@ -33,7 +33,7 @@ public:
      * @param password Hasło (niezaszyfrowane)
      * @return Obiekt JSON z wynikiem operacji
      */
-    json loginUser(const std::string &username, const std::string &password);
+    ArenaJson loginUser(const std::string &username, const std::string &password);
 
 private:
     UserRepository &_userRepo;
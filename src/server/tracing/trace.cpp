@@ -0,0 +1,192 @@
+#include "trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include "common/logger.h"
+
+using json = nlohmann::json;
+
+namespace {
+    std::mt19937_64 &threadRandom() {
+        thread_local std::mt19937_64 random(std::random_device{}());
+        return random;
+    }
+
+    std::string toHex(uint64_t value) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+}
+
+RequestTrace::RequestTrace(std::string requestId, uint64_t spanIdBase)
+    : _requestId(std::move(requestId)),
+      _spanIdBase(spanIdBase),
+      _start(Clock::now()),
+      _startUnixNanos(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {
+    _spans.reserve(16);
+}
+
+int RequestTrace::beginSpan(std::string_view name) {
+    Span span;
+    span.name = name;
+    span.startNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+    span.parent = _current;
+    span.thread = Tracer::threadNumber();
+    _spans.push_back(std::move(span));
+    _current = static_cast<int>(_spans.size()) - 1;
+    return _current;
+}
+
+void RequestTrace::endSpan(int index) {
+    Span &span = _spans[index];
+    span.durationNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count() -
+                         span.startNanos;
+    span.ended = true;
+
+    // Odcinek zakończony poza kolejnością (np. przeniesiony kursor) nie zmienia bieżącego
+    if (_current == index) {
+        do {
+            _current = _spans[_current].parent;
+        } while (_current >= 0 && _spans[_current].ended);
+    }
+}
+
+Tracer &Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::open(const std::string &path, Format format, double sampleRate) {
+    std::lock_guard lock(_mutex);
+    _out.open(path, std::ios::out | std::ios::trunc);
+    if (!_out) {
+        throw std::runtime_error("Nie można otworzyć pliku śladów: " + path);
+    }
+    _format = format;
+    _sampleRate = std::clamp(sampleRate, 0.0, 1.0);
+    _firstEvent = true;
+    if (_format == Format::Chrome) {
+        _out << "[\n";
+    }
+    _enabled.store(true, std::memory_order_relaxed);
+    LOG_INFO("Śledzenie żądań: {} ({}% żądań)", path, _sampleRate * 100);
+}
+
+void Tracer::close() {
+    std::lock_guard lock(_mutex);
+    if (!_enabled.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    if (_format == Format::Chrome) {
+        _out << "\n]\n";
+    }
+    _out.close();
+}
+
+bool Tracer::sample() const {
+    if (_sampleRate >= 1.0) {
+        return true;
+    }
+    return std::uniform_real_distribution<double>(0.0, 1.0)(threadRandom()) < _sampleRate;
+}
+
+std::unique_ptr<RequestTrace> Tracer::newTrace() {
+    return std::make_unique<RequestTrace>(newRequestId(), threadRandom()());
+}
+
+std::string Tracer::newRequestId() {
+    auto &random = threadRandom();
+    return toHex(random()) + toHex(random());
+}
+
+uint32_t Tracer::threadNumber() {
+    static std::atomic<uint32_t> next{1};
+    thread_local uint32_t number = next.fetch_add(1, std::memory_order_relaxed);
+    return number;
+}
+
+void Tracer::write(const RequestTrace &trace) {
+    std::lock_guard lock(_mutex);
+    if (!_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (_format == Format::Chrome) {
+        writeChrome(trace);
+    } else {
+        writeOtlp(trace);
+    }
+}
+
+void Tracer::writeChrome(const RequestTrace &trace) {
+    // Znaczniki czasu w mikrosekundach od epoki, aby żądania układały się na wspólnej osi
+    const auto &spans = trace.spans();
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const auto &span = spans[i];
+        json args = {{"requestId", trace.requestId()}};
+        if (i == 0 && trace.status != 0) {
+            args["status"] = trace.status;
+        }
+
+        json event = {
+            {"name", span.name},
+            {"cat", "deskpp"},
+            {"ph", "X"},
+            {"ts", static_cast<double>(trace.startUnixNanos() + static_cast<int64_t>(span.startNanos)) / 1000.0},
+            {"dur", static_cast<double>(span.durationNanos) / 1000.0},
+            {"pid", 1},
+            {"tid", span.thread},
+            {"args", std::move(args)}
+        };
+        _out << (_firstEvent ? "" : ",\n") << event.dump();
+        _firstEvent = false;
+    }
+}
+
+void Tracer::writeOtlp(const RequestTrace &trace) {
+    json otlpSpans = json::array();
+    const auto &spans = trace.spans();
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const auto &span = spans[i];
+        int64_t start = trace.startUnixNanos() + static_cast<int64_t>(span.startNanos);
+
+        json attributes = json::array({
+            {{"key", "thread.id"}, {"value", {{"intValue", std::to_string(span.thread)}}}}
+        });
+        if (i == 0 && trace.status != 0) {
+            attributes.push_back({{"key", "http.response.status_code"},
+                                  {"value", {{"intValue", std::to_string(trace.status)}}}});
+        }
+
+        // Liczby 64-bitowe są w OTLP/JSON zapisywane jako tekst
+        json otlpSpan = {
+            {"traceId", trace.requestId()},
+            {"spanId", toHex(trace.spanIdBase() + i)},
+            {"name", span.name},
+            {"kind", i == 0 ? 2 : 1},
+            {"startTimeUnixNano", std::to_string(start)},
+            {"endTimeUnixNano", std::to_string(start + static_cast<int64_t>(span.durationNanos))},
+            {"attributes", std::move(attributes)}
+        };
+        if (span.parent >= 0) {
+            otlpSpan["parentSpanId"] = toHex(trace.spanIdBase() + span.parent);
+        }
+        otlpSpans.push_back(std::move(otlpSpan));
+    }
+
+    json request = {
+        {"resourceSpans", json::array({{
+            {"resource", {{"attributes", json::array({
+                {{"key", "service.name"}, {"value", {{"stringValue", "deskpp-server"}}}}
+            })}}},
+            {"scopeSpans", json::array({{
+                {"scope", {{"name", "deskpp"}}},
+                {"spans", std::move(otlpSpans)}
+            }})}
+        }})}
+    };
+    _out << request.dump() << "\n";
+}
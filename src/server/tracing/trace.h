@@ -0,0 +1,240 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @class RequestTrace
+ * @brief Zagnieżdżone odcinki (spany) czasu jednego żądania HTTP.
+ *
+ * Odcinki są dodawane kolejno przez kod obsługujący żądanie, także gdy
+ * korutyna przechodzi między wątkami, więc ślad nie wymaga synchronizacji.
+ */
+class RequestTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Zakończony lub trwający odcinek
+     */
+    struct Span {
+        std::string name;
+        uint64_t startNanos = 0;
+        uint64_t durationNanos = 0;
+        int parent = -1;
+        uint32_t thread = 0;
+        bool ended = false;
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param requestId Identyfikator żądania (32 znaki szesnastkowe)
+     * @param spanIdBase Losowa podstawa identyfikatorów odcinków
+     */
+    RequestTrace(std::string requestId, uint64_t spanIdBase);
+
+    /**
+     * @brief Rozpoczyna odcinek zagnieżdżony w bieżącym
+     * @param name Nazwa odcinka
+     * @return Indeks odcinka
+     */
+    int beginSpan(std::string_view name);
+
+    /**
+     * @brief Kończy odcinek
+     * @param index Indeks odcinka
+     */
+    void endSpan(int index);
+
+    const std::string &requestId() const { return _requestId; }
+    uint64_t spanIdBase() const { return _spanIdBase; }
+    int64_t startUnixNanos() const { return _startUnixNanos; }
+    const std::vector<Span> &spans() const { return _spans; }
+
+    /**
+     * @brief Kod odpowiedzi (0 - nieznany)
+     */
+    int status = 0;
+
+private:
+    std::string _requestId;
+    uint64_t _spanIdBase;
+    Clock::time_point _start;
+    int64_t _startUnixNanos;
+    std::vector<Span> _spans;
+    int _current = -1;
+};
+
+/**
+ * @class Tracer
+ * @brief Próbkowanie żądań i zapis ich śladów do pliku.
+ *
+ * Ślad bieżącego żądania jest dostępny przez zmienną wątku ustawianą przez
+ * middleware i przy wznowieniu korutyny na puli wątków bazy danych. Gdy
+ * śledzenie jest wyłączone, zmienna pozostaje pusta, a odcinki kończą się
+ * na jednym porównaniu wskaźnika.
+ *
+ * Ślady są zapisywane w formacie Chrome trace-event (tablica JSON, do
+ * otwarcia w chrome://tracing lub Perfetto) albo OTLP/JSON (jedno żądanie
+ * eksportu w wierszu, jak eksporter plikowy OpenTelemetry).
+ */
+class Tracer {
+public:
+    enum class Format { Chrome, Otlp };
+
+    /**
+     * @brief Zwraca instancję (wzorzec Singleton)
+     * @return Referencja do instancji
+     */
+    static Tracer &instance();
+
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    /**
+     * @brief Włącza śledzenie
+     * @param path Plik wynikowy
+     * @param format Format śladów
+     * @param sampleRate Odsetek śledzonych żądań (0-1)
+     * @throws std::runtime_error Gdy nie można otworzyć pliku
+     */
+    void open(const std::string &path, Format format, double sampleRate);
+
+    /**
+     * @brief Kończy plik śladów i wyłącza śledzenie
+     */
+    void close();
+
+    /**
+     * @brief Sprawdza czy śledzenie jest włączone
+     * @return Czy śledzenie jest włączone
+     */
+    bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Losuje czy żądanie ma być śledzone
+     * @return Czy śledzić żądanie
+     */
+    bool sample() const;
+
+    /**
+     * @brief Tworzy ślad żądania z nowym identyfikatorem
+     * @return Ślad żądania
+     */
+    static std::unique_ptr<RequestTrace> newTrace();
+
+    /**
+     * @brief Tworzy losowy identyfikator żądania (128 bitów, szesnastkowo)
+     * @return Identyfikator żądania
+     */
+    static std::string newRequestId();
+
+    /**
+     * @brief Zapisuje zakończony ślad żądania
+     * @param trace Ślad żądania
+     */
+    void write(const RequestTrace &trace);
+
+    /**
+     * @brief Zwraca ślad żądania obsługiwanego przez bieżący wątek
+     * @return Ślad lub nullptr, gdy żądanie nie jest śledzone
+     */
+    static RequestTrace *current() { return _current; }
+
+    /**
+     * @brief Ustawia ślad żądania obsługiwanego przez bieżący wątek
+     * @param trace Ślad lub nullptr
+     */
+    static void setCurrent(RequestTrace *trace) { _current = trace; }
+
+    /**
+     * @brief Zwraca numer bieżącego wątku w śladach
+     * @return Numer wątku (od 1)
+     */
+    static uint32_t threadNumber();
+
+private:
+    Tracer() = default;
+
+    void writeChrome(const RequestTrace &trace);
+    void writeOtlp(const RequestTrace &trace);
+
+    static inline thread_local RequestTrace *_current = nullptr;
+
+    std::atomic<bool> _enabled{false};
+    double _sampleRate = 1.0;
+    Format _format = Format::Chrome;
+    std::mutex _mutex;
+    std::ofstream _out;
+    bool _firstEvent = true;
+};
+
+/**
+ * @class TraceSpan
+ * @brief Odcinek śladu trwający do zniszczenia obiektu.
+ *
+ * Bez śledzonego żądania obiekt jest pusty i nic nie zapisuje.
+ */
+class TraceSpan {
+public:
+    TraceSpan() = default;
+
+    /**
+     * @brief Rozpoczyna odcinek w śladzie bieżącego żądania
+     * @param name Nazwa odcinka
+     */
+    explicit TraceSpan(std::string_view name) : _trace(Tracer::current()) {
+        if (_trace) {
+            _index = _trace->beginSpan(name);
+        }
+    }
+
+    TraceSpan(TraceSpan &&other) noexcept
+        : _trace(std::exchange(other._trace, nullptr)), _index(other._index) {
+    }
+
+    TraceSpan &operator=(TraceSpan &&other) noexcept {
+        if (this != &other) {
+            end();
+            _trace = std::exchange(other._trace, nullptr);
+            _index = other._index;
+        }
+        return *this;
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    ~TraceSpan() { end(); }
+
+    /**
+     * @brief Kończy odcinek przed zniszczeniem obiektu
+     */
+    void end() {
+        if (_trace) {
+            _trace->endSpan(_index);
+            _trace = nullptr;
+        }
+    }
+
+private:
+    RequestTrace *_trace = nullptr;
+    int _index = -1;
+};
+
+/**
+ * @brief Odcinek śladu do końca bieżącego zakresu
+ * @param name Nazwa odcinka
+ */
+#define TRACE_SPAN(name) TraceSpan traceSpan_(name)
+
+#endif
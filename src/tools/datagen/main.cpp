@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "server/repository/database_schema.h"
+#include "server/repository/data_generator.h"
+#include "common/logger.h"
+
+namespace {
+    void printUsage() {
+        std::printf(
+            "Użycie: deskpp_datagen --database <plik> [opcje]\n"
+            "  --database, -db <plik>   plik bazy danych (zostanie utworzony)\n"
+            "  --buildings <n>          liczba budynków (domyślnie 10)\n"
+            "  --floors <min>-<max>     zakres liczby pięter budynku (domyślnie 1-5)\n"
+            "  --desks-per-floor <n>    liczba biurek na piętrze (domyślnie 40)\n"
+            "  --users <n>              liczba użytkowników (domyślnie 5000)\n"
+            "  --bookings <n>           liczba rezerwacji (domyślnie 1000000)\n"
+            "  --start <yyyy-MM-dd>     data pierwszej rezerwacji (domyślnie 2024-01-01)\n"
+            "  --occupancy <0-1>        obłożenie biurek w szczycie tygodnia (domyślnie 0.6)\n"
+            "  --desk-skew <s>          skośność popularności biurek (domyślnie 0.8)\n"
+            "  --long-stay <0-1>        udział rezerwacji wielodniowych (domyślnie 0.05)\n"
+            "  --seed <n>               ziarno generatora (domyślnie 42)\n"
+            "  --force                  nadpisuje istniejący plik bazy danych\n"
+            "  --verbose, -v            włącza szczegółowe logowanie\n");
+    }
+}
+
+/**
+ * @brief Narzędzie tworzące bazę danych z syntetycznymi danymi
+ *
+ * Dla tych samych parametrów i ziarna tworzy identyczną bazę, więc nadaje się
+ * do przygotowywania powtarzalnych danych do testów wydajności.
+ */
+int main(int argc, char *argv[]) {
+    DataGenerator::Options options;
+    std::string databasePath;
+    bool force = false;
+    bool verbose = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            auto is = [&](const char *name) { return strcmp(argv[i], name) == 0; };
+            bool hasValue = i + 1 < argc;
+
+            if (is("--help") || is("-h")) {
+                printUsage();
+                return 0;
+            } else if (is("--force")) {
+                force = true;
+            } else if (is("--verbose") || is("-v")) {
+                verbose = true;
+            } else if ((is("--database") || is("-db")) && hasValue) {
+                databasePath = argv[++i];
+            } else if (is("--buildings") && hasValue) {
+                options.buildings = std::stoi(argv[++i]);
+            } else if (is("--floors") && hasValue) {
+                std::string range = argv[++i];
+                auto dash = range.find('-');
+                options.minFloors = std::stoi(range.substr(0, dash));
+                options.maxFloors = dash == std::string::npos ? options.minFloors : std::stoi(range.substr(dash + 1));
+            } else if (is("--desks-per-floor") && hasValue) {
+                options.desksPerFloor = std::stoi(argv[++i]);
+            } else if (is("--users") && hasValue) {
+                options.users = std::stoi(argv[++i]);
+            } else if (is("--bookings") && hasValue) {
+                options.bookings = std::stoll(argv[++i]);
+            } else if (is("--start") && hasValue) {
+                options.startDate = argv[++i];
+            } else if (is("--occupancy") && hasValue) {
+                options.occupancy = std::stod(argv[++i]);
+            } else if (is("--desk-skew") && hasValue) {
+                options.deskSkew = std::stod(argv[++i]);
+            } else if (is("--long-stay") && hasValue) {
+                options.longStayShare = std::stod(argv[++i]);
+            } else if (is("--seed") && hasValue) {
+                options.seed = std::stoull(argv[++i]);
+            } else {
+                std::fprintf(stderr, "Nieznana opcja lub brak wartości: %s\n", argv[i]);
+                printUsage();
+                return 1;
+            }
+        }
+    } catch (const std::exception &) {
+        std::fprintf(stderr, "Nieprawidłowa wartość liczbowa\n");
+        return 1;
+    }
+
+    if (databasePath.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    initLogger("DeskPP-DataGen", verbose);
+
+    try {
+        if (std::filesystem::exists(databasePath)) {
+            if (!force) {
+                LOG_ERROR("Plik {} już istnieje (użyj --force, aby go nadpisać)", databasePath);
+                return 1;
+            }
+            std::filesystem::remove(databasePath);
+        }
+
+        SQLite::Database db(databasePath, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+        createDatabaseSchema(db);
+
+        DataGenerator generator(db, options);
+        auto summary = generator.generate();
+
+        LOG_INFO("Utworzono {}: {} budynków, {} biurek, {} użytkowników, {} rezerwacji ({} - {}) w {:.1f} s",
+                 databasePath, summary.buildings, summary.desks, summary.users, summary.bookings,
+                 summary.firstDate, summary.lastDate, summary.seconds);
+    } catch (const std::exception &e) {
+        LOG_ERROR("Błąd: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "csv.h"
+
+CsvReader::CsvReader(std::istream &input)
+    : _input(input) {
+}
+
+bool CsvReader::next(std::vector<std::string> &fields) {
+    fields.clear();
+
+    // Pomiń puste linie
+    do {
+        if (!std::getline(_input, _line)) {
+            return false;
+        }
+        ++_lineNumber;
+    } while (_line.empty() || _line == "\r");
+    _recordLine = _lineNumber;
+
+    std::string field;
+    bool quoted = false;
+    size_t i = 0;
+    while (true) {
+        if (i >= _line.size()) {
+            if (quoted) {
+                // Pole w cudzysłowie obejmuje znak nowej linii
+                field += '\n';
+                if (!std::getline(_input, _line)) {
+                    break;
+                }
+                ++_lineNumber;
+                i = 0;
+                continue;
+            }
+            break;
+        }
+
+        char c = _line[i++];
+        if (quoted) {
+            if (c == '"') {
+                if (i < _line.size() && _line[i] == '"') {
+                    field += '"';
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(std::move(field));
+            field.clear();
+        } else if (c == '\r' && i == _line.size()) {
+            // Koniec linii w formacie Windows
+        } else {
+            field += c;
+        }
+    }
+    fields.push_back(std::move(field));
+    return true;
+}
+
+void writeCsvRow(std::ostream &output, const std::vector<std::string> &fields) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) {
+            output << ',';
+        }
+
+        const auto &field = fields[i];
+        if (field.find_first_of(",\"\r\n") == std::string::npos) {
+            output << field;
+            continue;
+        }
+
+        output << '"';
+        for (char c: field) {
+            if (c == '"') {
+                output << '"';
+            }
+            output << c;
+        }
+        output << '"';
+    }
+    output << '\n';
+}
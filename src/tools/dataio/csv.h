@@ -0,0 +1,51 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class CsvReader
+ * @brief Strumieniowy czytnik plików CSV (RFC 4180).
+ *
+ * Odczytuje po jednym rekordzie, obsługując pola w cudzysłowach, w tym
+ * zawierające przecinki, cudzysłowy i znaki nowej linii.
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Konstruktor
+     * @param input Strumień wejściowy
+     */
+    explicit CsvReader(std::istream &input);
+
+    /**
+     * @brief Odczytuje kolejny rekord
+     * @param fields Pola rekordu (nadpisywane)
+     * @return Czy odczytano rekord
+     */
+    bool next(std::vector<std::string> &fields);
+
+    /**
+     * @brief Pobiera numer linii, w której zaczyna się ostatni rekord
+     * @return Numer linii (od 1)
+     */
+    size_t getLine() const { return _recordLine; }
+
+private:
+    std::istream &_input;
+    std::string _line;
+    size_t _lineNumber = 0;
+    size_t _recordLine = 0;
+};
+
+/**
+ * @brief Zapisuje rekord CSV, ujmując pola w cudzysłowy tylko gdy to konieczne
+ * @param output Strumień wyjściowy
+ * @param fields Pola rekordu
+ */
+void writeCsvRow(std::ostream &output, const std::vector<std::string> &fields);
+
+#endif
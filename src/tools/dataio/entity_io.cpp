@@ -0,0 +1,347 @@
+#include "entity_io.h"
+#include "csv.h"
+
+namespace {
+    /**
+     * @brief Pobiera pole tekstowe rekordu
+     */
+    std::string textField(const json &record, const char *key) {
+        auto it = record.find(key);
+        if (it == record.end() || it->is_null()) {
+            return {};
+        }
+        return it->is_string() ? it->get<std::string>() : it->dump();
+    }
+
+    /**
+     * @brief Pobiera pole liczbowe rekordu (liczba lub napis z liczbą)
+     */
+    std::optional<int> intField(const json &record, const char *key) {
+        auto it = record.find(key);
+        if (it == record.end() || it->is_null()) {
+            return std::nullopt;
+        }
+        if (it->is_number_integer()) {
+            return it->get<int>();
+        }
+        if (it->is_string()) {
+            const auto &text = it->get_ref<const std::string &>();
+            if (text.empty()) {
+                return std::nullopt;
+            }
+            size_t parsed = 0;
+            try {
+                int value = std::stoi(text, &parsed);
+                if (parsed == text.size()) {
+                    return value;
+                }
+            } catch (const std::exception &) {
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+std::optional<EntityKind> parseEntityKind(const std::string &name) {
+    if (name == "buildings") return EntityKind::Buildings;
+    if (name == "desks") return EntityKind::Desks;
+    if (name == "users") return EntityKind::Users;
+    if (name == "bookings") return EntityKind::Bookings;
+    return std::nullopt;
+}
+
+std::optional<DataFormat> parseDataFormat(const std::string &name) {
+    if (name == "csv") return DataFormat::Csv;
+    if (name == "ndjson" || name == "jsonl") return DataFormat::NdJson;
+    return std::nullopt;
+}
+
+const std::vector<std::string> &exportColumns(EntityKind kind) {
+    static const std::vector<std::string> buildings = entityKeys<Building>(EntityFields::All);
+    static const std::vector<std::string> desks = entityKeys<Desk>(EntityFields::All);
+    static const std::vector<std::string> users = entityKeys<User>(EntityFields::All);
+    static const std::vector<std::string> bookings = entityKeys<Booking>(EntityFields::All);
+
+    switch (kind) {
+        case EntityKind::Buildings:
+            return buildings;
+        case EntityKind::Desks:
+            return desks;
+        case EntityKind::Users:
+            return users;
+        case EntityKind::Bookings:
+        default:
+            return bookings;
+    }
+}
+
+EntityExporter::EntityExporter(std::shared_ptr<SQLite::Database> db, DataFormat format, std::ostream &output)
+    : _db(std::move(db)), _format(format), _output(output) {
+}
+
+size_t EntityExporter::exportEntities(EntityKind kind) {
+    if (_format == DataFormat::Csv) {
+        writeCsvRow(_output, exportColumns(kind));
+    }
+
+    // Eksport obejmuje wszystkie pola encji, także hash hasła potrzebny do przeniesienia kont
+    auto write = [&](const auto &entity) { writeEntity(entity); };
+    switch (kind) {
+        case EntityKind::Buildings:
+            return BuildingRepository(_db).forEach(write);
+        case EntityKind::Desks:
+            return DeskRepository(_db).forEach(write);
+        case EntityKind::Users:
+            return UserRepository(_db).forEach(write);
+        case EntityKind::Bookings:
+        default:
+            return BookingRepository(_db).forEach(write);
+    }
+}
+
+template<typename T>
+void EntityExporter::writeEntity(const T &entity) {
+    if (_format == DataFormat::NdJson) {
+        _output << entityToJson<json>(entity, EntityFields::All).dump() << '\n';
+        return;
+    }
+
+    std::vector<std::string> fields;
+    fields.reserve(entityFieldCount<T>());
+    forEachField<T>([&](const auto &field, size_t) {
+        const auto &value = field.get(entity);
+        using Value = std::remove_cvref_t<decltype(value)>;
+        if constexpr (std::is_same_v<Value, int>) {
+            fields.push_back(std::to_string(value));
+        } else if constexpr (std::is_same_v<Value, Date>) {
+            fields.push_back(value.toString());
+        } else {
+            fields.push_back(value);
+        }
+    });
+    writeCsvRow(_output, fields);
+}
+
+EntityImporter::EntityImporter(std::shared_ptr<SQLite::Database> db, EntityKind kind)
+    : _db(db), _kind(kind),
+      _buildingRepo(db), _deskRepo(db), _userRepo(db), _bookingRepo(db),
+      _buildingByName(*db, "SELECT id, num_floors FROM buildings WHERE name = ?"),
+      _buildingById(*db, "SELECT id, num_floors FROM buildings WHERE id = ?"),
+      _deskExists(*db, "SELECT 1 FROM desks WHERE id = ?"),
+      _userByName(*db, "SELECT id FROM users WHERE username = ?"),
+      _userExists(*db, "SELECT 1 FROM users WHERE id = ?"),
+      _emailExists(*db, "SELECT 1 FROM users WHERE email = ?"),
+      _bookingLastBefore(*db, "SELECT date_to FROM bookings WHERE desk_id = ? AND date <= ? "
+                              "ORDER BY date DESC LIMIT 1") {
+    switch (kind) {
+        case EntityKind::Buildings:
+            _buildingInserter.emplace(_buildingRepo);
+            break;
+        case EntityKind::Desks:
+            _deskInserter.emplace(_deskRepo);
+            break;
+        case EntityKind::Users:
+            _userInserter.emplace(_userRepo);
+            break;
+        case EntityKind::Bookings:
+            _bookingInserter.emplace(_bookingRepo);
+            break;
+    }
+}
+
+bool EntityImporter::importRecord(const json &record, std::string &error) {
+    if (!record.is_object()) {
+        error = "Rekord nie jest obiektem";
+        return false;
+    }
+
+    switch (_kind) {
+        case EntityKind::Buildings:
+            return importBuilding(record, error);
+        case EntityKind::Desks:
+            return importDesk(record, error);
+        case EntityKind::Users:
+            return importUser(record, error);
+        case EntityKind::Bookings:
+        default:
+            return importBooking(record, error);
+    }
+}
+
+bool EntityImporter::exists(SQLite::Statement &query, int id) {
+    query.bind(1, id);
+    bool found = query.executeStep();
+    query.reset();
+    return found;
+}
+
+bool EntityImporter::exists(SQLite::Statement &query, const std::string &value) {
+    query.bind(1, value);
+    bool found = query.executeStep();
+    query.reset();
+    return found;
+}
+
+std::optional<std::pair<int, int>> EntityImporter::resolveBuilding(const json &record) {
+    SQLite::Statement *query = nullptr;
+    if (auto buildingId = intField(record, "buildingId")) {
+        auto cached = _buildingFloors.find(*buildingId);
+        if (cached != _buildingFloors.end()) {
+            return *cached;
+        }
+        query = &_buildingById;
+        query->bind(1, *buildingId);
+    } else if (auto name = textField(record, "building"); !name.empty()) {
+        query = &_buildingByName;
+        query->bind(1, name);
+    } else {
+        return std::nullopt;
+    }
+
+    std::optional<std::pair<int, int>> result;
+    if (query->executeStep()) {
+        result = std::make_pair(query->getColumn(0).getInt(), query->getColumn(1).getInt());
+        _buildingFloors[result->first] = result->second;
+    }
+    query->reset();
+    return result;
+}
+
+bool EntityImporter::importBuilding(const json &record, std::string &error) {
+    std::string name = textField(record, "name");
+    if (name.empty()) {
+        error = "Brak nazwy budynku";
+        return false;
+    }
+    if (exists(_buildingByName, name)) {
+        error = "Budynek " + name + " już istnieje";
+        return false;
+    }
+
+    int numFloors = intField(record, "numFloors").value_or(1);
+    if (numFloors < 1) {
+        error = "Nieprawidłowa liczba pięter";
+        return false;
+    }
+
+    _buildingInserter->add(Building(0, name, textField(record, "address"), numFloors));
+    return true;
+}
+
+bool EntityImporter::importDesk(const json &record, std::string &error) {
+    std::string name = textField(record, "name");
+    if (name.empty()) {
+        error = "Brak nazwy biurka";
+        return false;
+    }
+
+    auto building = resolveBuilding(record);
+    if (!building) {
+        error = "Nie znaleziono budynku biurka " + name;
+        return false;
+    }
+
+    int floor = intField(record, "floor").value_or(1);
+    if (floor < 1 || floor > building->second) {
+        error = "Piętro " + std::to_string(floor) + " poza zakresem budynku";
+        return false;
+    }
+
+    _deskInserter->add(Desk(0, name, building->first, floor));
+    return true;
+}
+
+bool EntityImporter::importUser(const json &record, std::string &error) {
+    std::string username = textField(record, "username");
+    std::string email = textField(record, "email");
+    if (username.empty() || email.empty()) {
+        error = "Brak nazwy użytkownika lub adresu email";
+        return false;
+    }
+    if (exists(_userByName, username) || exists(_emailExists, email)) {
+        error = "Użytkownik " + username + " lub email " + email + " już istnieje";
+        return false;
+    }
+
+    // Hasło w postaci jawnej jest haszowane, a hash z eksportu zapisywany bez zmian
+    std::string passwordHash = textField(record, "passwordHash");
+    std::string password = textField(record, "password");
+    if (passwordHash.empty()) {
+        if (password.empty()) {
+            error = "Brak hasła użytkownika " + username;
+            return false;
+        }
+        passwordHash = UserRepository::hashPassword(password);
+    }
+
+    User user(0, username, email);
+    user.setPasswordHash(passwordHash);
+    _userInserter->add(user);
+    return true;
+}
+
+bool EntityImporter::importBooking(const json &record, std::string &error) {
+    auto deskId = intField(record, "deskId");
+    if (!deskId || !exists(_deskExists, *deskId)) {
+        error = "Nie znaleziono biurka rezerwacji";
+        return false;
+    }
+
+    auto userId = intField(record, "userId");
+    if (!userId) {
+        if (std::string username = textField(record, "username"); !username.empty()) {
+            _userByName.bind(1, username);
+            if (_userByName.executeStep()) {
+                userId = _userByName.getColumn(0).getInt();
+            }
+            _userByName.reset();
+        }
+    } else if (!exists(_userExists, *userId)) {
+        userId.reset();
+    }
+    if (!userId) {
+        error = "Nie znaleziono użytkownika rezerwacji";
+        return false;
+    }
+
+    std::string dateFrom = textField(record, "dateFrom");
+    std::string dateTo = textField(record, "dateTo");
+    if (dateTo.empty()) {
+        dateTo = dateFrom;
+    }
+
+    Booking booking(0, *deskId, *userId, dateFrom, dateTo);
+    if (!booking.getDateFrom().isValid() || !booking.getDateTo().isValid()) {
+        error = "Nieprawidłowy format daty (oczekiwano yyyy-MM-dd)";
+        return false;
+    }
+    if (booking.getDateFrom() > booking.getDateTo()) {
+        error = "Data początkowa jest późniejsza niż końcowa";
+        return false;
+    }
+    if (!BookingRecord::inRange(booking.getDateFrom()) || !BookingRecord::inRange(booking.getDateTo())) {
+        error = "Data spoza obsługiwanego zakresu (" + BookingRecord::Epoch.toString() + " - " +
+                BookingRecord::LastDate.toString() + ")";
+        return false;
+    }
+    if (!BookingRecord::validPeriod(booking.getDateFrom(), booking.getDateTo())) {
+        error = "Rezerwacja dłuższa niż " + std::to_string(BookingRecord::MaxDays) + " dni";
+        return false;
+    }
+
+    // Rezerwacje biurka się nie nakładają, więc wystarczy sprawdzić ostatnią zaczynającą się
+    // najpóźniej w dniu końcowym (jak BookingBlock::overlaps); indeks (desk_id, date) daje ją
+    // bez przeglądania historii biurka
+    _bookingLastBefore.bind(1, *deskId);
+    _bookingLastBefore.bind(2, booking.getDateToString());
+    bool overlaps = _bookingLastBefore.executeStep() &&
+                    _bookingLastBefore.getColumn(0).getString() >= booking.getDateFromString();
+    _bookingLastBefore.reset();
+    if (overlaps) {
+        error = "Rezerwacja nakłada się na istniejącą rezerwację biurka";
+        return false;
+    }
+
+    _bookingInserter->add(booking);
+    return true;
+}
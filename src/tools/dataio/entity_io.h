@@ -0,0 +1,165 @@
+#ifndef ENTITY_IO_H
+#define ENTITY_IO_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "server/repository/building_repository.h"
+#include "server/repository/desk_repository.h"
+#include "server/repository/user_repository.h"
+#include "server/repository/booking_repository.h"
+
+using json = nlohmann::json;
+
+/**
+ * @brief Rodzaj importowanych lub eksportowanych encji
+ */
+enum class EntityKind {
+    Buildings,
+    Desks,
+    Users,
+    Bookings
+};
+
+/**
+ * @brief Format pliku z danymi
+ */
+enum class DataFormat {
+    Csv,
+    NdJson
+};
+
+/**
+ * @brief Parsuje nazwę rodzaju encji (buildings, desks, users, bookings)
+ * @param name Nazwa rodzaju encji
+ * @return Rodzaj encji lub brak dla nieznanej nazwy
+ */
+std::optional<EntityKind> parseEntityKind(const std::string &name);
+
+/**
+ * @brief Parsuje nazwę formatu (csv, ndjson)
+ * @param name Nazwa formatu
+ * @return Format lub brak dla nieznanej nazwy
+ */
+std::optional<DataFormat> parseDataFormat(const std::string &name);
+
+/**
+ * @brief Pobiera kolumny eksportowane dla rodzaju encji
+ * @param kind Rodzaj encji
+ * @return Nazwy kolumn (klucze JSON wszystkich pól encji)
+ */
+const std::vector<std::string> &exportColumns(EntityKind kind);
+
+/**
+ * @class EntityExporter
+ * @brief Eksportuje encje strumieniowo, wiersz po wierszu z kursora SQLite.
+ */
+class EntityExporter {
+public:
+    /**
+     * @brief Konstruktor
+     * @param db Współdzielony wskaźnik do bazy danych
+     * @param format Format wyjściowy
+     * @param output Strumień wyjściowy
+     */
+    EntityExporter(std::shared_ptr<SQLite::Database> db, DataFormat format, std::ostream &output);
+
+    /**
+     * @brief Eksportuje wszystkie encje wybranego rodzaju
+     * @param kind Rodzaj encji
+     * @return Liczba wyeksportowanych encji
+     */
+    size_t exportEntities(EntityKind kind);
+
+private:
+    /**
+     * @brief Zapisuje jedną encję w wybranym formacie (pola według EntityTraits)
+     * @param entity Encja
+     */
+    template<typename T>
+    void writeEntity(const T &entity);
+
+    std::shared_ptr<SQLite::Database> _db;
+    DataFormat _format;
+    std::ostream &_output;
+};
+
+/**
+ * @class EntityImporter
+ * @brief Waliduje rekordy i zapisuje je przez repozytoria.
+ *
+ * Rekordy CSV i NDJSON są przekazywane jako obiekty JSON. Pola liczbowe
+ * mogą być liczbami lub napisami. Biurka mogą wskazywać budynek przez
+ * buildingId lub nazwę (building), a rezerwacje użytkownika przez userId
+ * lub username. Zapytania walidujące są przygotowywane raz na cały import.
+ */
+class EntityImporter {
+public:
+    /**
+     * @brief Konstruktor
+     * @param db Współdzielony wskaźnik do bazy danych
+     * @param kind Rodzaj importowanych encji
+     */
+    EntityImporter(std::shared_ptr<SQLite::Database> db, EntityKind kind);
+
+    /**
+     * @brief Waliduje i zapisuje rekord
+     * @param record Rekord w postaci obiektu JSON
+     * @param error Opis błędu walidacji
+     * @return Czy rekord został zapisany
+     */
+    bool importRecord(const json &record, std::string &error);
+
+private:
+    bool importBuilding(const json &record, std::string &error);
+
+    bool importDesk(const json &record, std::string &error);
+
+    bool importUser(const json &record, std::string &error);
+
+    bool importBooking(const json &record, std::string &error);
+
+    /**
+     * @brief Wyznacza identyfikator budynku z pola buildingId lub building
+     * @return Para (identyfikator, liczba pięter) lub brak
+     */
+    std::optional<std::pair<int, int>> resolveBuilding(const json &record);
+
+    /**
+     * @brief Sprawdza czy zapytanie z jednym parametrem zwraca wiersz
+     */
+    static bool exists(SQLite::Statement &query, int id);
+
+    static bool exists(SQLite::Statement &query, const std::string &value);
+
+    std::shared_ptr<SQLite::Database> _db;
+    EntityKind _kind;
+
+    BuildingRepository _buildingRepo;
+    DeskRepository _deskRepo;
+    UserRepository _userRepo;
+    BookingRepository _bookingRepo;
+
+    std::optional<BuildingRepository::Inserter> _buildingInserter;
+    std::optional<DeskRepository::Inserter> _deskInserter;
+    std::optional<UserRepository::Inserter> _userInserter;
+    std::optional<BookingRepository::Inserter> _bookingInserter;
+
+    SQLite::Statement _buildingByName;
+    SQLite::Statement _buildingById;
+    SQLite::Statement _deskExists;
+    SQLite::Statement _userByName;
+    SQLite::Statement _userExists;
+    SQLite::Statement _emailExists;
+    SQLite::Statement _bookingLastBefore;
+
+    // Budynków jest niewiele, więc ich piętra mogą być zapamiętane
+    std::map<int, int> _buildingFloors;
+};
+
+#endif
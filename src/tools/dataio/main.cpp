@@ -0,0 +1,274 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "csv.h"
+#include "entity_io.h"
+#include "server/repository/database_schema.h"
+#include "common/logger.h"
+
+namespace {
+    /**
+     * @brief Parametry uruchomienia narzędzia
+     */
+    struct DataIoOptions {
+        std::string command;
+        std::string databasePath = "deskpp.sqlite";
+        std::string file = "-";
+        EntityKind entity = EntityKind::Bookings;
+        DataFormat format = DataFormat::Csv;
+        size_t batchSize = 10000;
+        bool strict = false;
+        bool verbose = false;
+    };
+
+    void printUsage() {
+        std::fprintf(stderr,
+            "Użycie: deskpp_dataio <import|export> --entity <rodzaj> [opcje]\n"
+            "  --entity <rodzaj>        buildings, desks, users lub bookings\n"
+            "  --database, -db <plik>   plik bazy danych (domyślnie deskpp.sqlite)\n"
+            "  --format <format>        csv lub ndjson (domyślnie csv)\n"
+            "  --file, -f <plik>        plik wejściowy lub wyjściowy, '-' oznacza stdin/stdout\n"
+            "  --batch <n>              liczba wierszy w jednej transakcji importu (domyślnie 10000)\n"
+            "  --strict                 przerywa import przy pierwszym błędnym rekordzie\n"
+            "  --verbose, -v            włącza szczegółowe logowanie\n");
+    }
+
+    bool parseOptions(int argc, char *argv[], DataIoOptions &options) {
+        if (argc < 2) {
+            return false;
+        }
+        options.command = argv[1];
+        if (options.command != "import" && options.command != "export") {
+            return false;
+        }
+
+        for (int i = 2; i < argc; i++) {
+            auto is = [&](const char *name) { return strcmp(argv[i], name) == 0; };
+            bool hasValue = i + 1 < argc;
+
+            if (is("--strict")) {
+                options.strict = true;
+            } else if (is("--verbose") || is("-v")) {
+                options.verbose = true;
+            } else if (is("--entity") && hasValue) {
+                auto entity = parseEntityKind(argv[++i]);
+                if (!entity) {
+                    return false;
+                }
+                options.entity = *entity;
+            } else if ((is("--database") || is("-db")) && hasValue) {
+                options.databasePath = argv[++i];
+            } else if (is("--format") && hasValue) {
+                auto format = parseDataFormat(argv[++i]);
+                if (!format) {
+                    return false;
+                }
+                options.format = *format;
+            } else if ((is("--file") || is("-f")) && hasValue) {
+                options.file = argv[++i];
+            } else if (is("--batch") && hasValue) {
+                options.batchSize = std::max(1, std::atoi(argv[++i]));
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @class ImportReader
+     * @brief Odczytuje kolejne rekordy pliku CSV lub NDJSON jako obiekty JSON.
+     */
+    class ImportReader {
+    public:
+        ImportReader(std::istream &input, DataFormat format)
+            : _input(input), _format(format), _csv(input) {
+            if (_format == DataFormat::Csv) {
+                _csv.next(_header);
+                // Usuń znacznik BOM z pierwszej kolumny
+                if (!_header.empty() && _header[0].rfind("\xEF\xBB\xBF", 0) == 0) {
+                    _header[0].erase(0, 3);
+                }
+            }
+        }
+
+        /**
+         * @brief Odczytuje kolejny rekord
+         * @param record Rekord (nadpisywany)
+         * @param error Opis błędu składni
+         * @return Czy odczytano rekord (także niepoprawny - wtedy error nie jest pusty)
+         */
+        bool next(json &record, std::string &error) {
+            error.clear();
+            if (_format == DataFormat::NdJson) {
+                do {
+                    if (!std::getline(_input, _line)) {
+                        return false;
+                    }
+                    ++_lineNumber;
+                } while (_line.empty());
+
+                record = json::parse(_line, nullptr, false);
+                if (record.is_discarded()) {
+                    error = "Niepoprawny JSON";
+                }
+                return true;
+            }
+
+            if (!_csv.next(_fields)) {
+                return false;
+            }
+            _lineNumber = _csv.getLine();
+            if (_fields.size() != _header.size()) {
+                error = "Liczba pól (" + std::to_string(_fields.size()) + ") różni się od nagłówka (" +
+                        std::to_string(_header.size()) + ")";
+                return true;
+            }
+
+            record = json::object();
+            for (size_t i = 0; i < _fields.size(); ++i) {
+                record[_header[i]] = std::move(_fields[i]);
+            }
+            return true;
+        }
+
+        size_t getLine() const { return _lineNumber; }
+
+    private:
+        std::istream &_input;
+        DataFormat _format;
+        CsvReader _csv;
+        std::vector<std::string> _header;
+        std::vector<std::string> _fields;
+        std::string _line;
+        size_t _lineNumber = 0;
+    };
+
+    int runExport(const DataIoOptions &options, std::shared_ptr<SQLite::Database> db) {
+        std::ofstream file;
+        if (options.file != "-") {
+            file.open(options.file, std::ios::binary);
+            if (!file) {
+                LOG_ERROR("Nie można otworzyć pliku {}", options.file);
+                return 1;
+            }
+        }
+        std::ostream &output = options.file == "-" ? std::cout : file;
+
+        auto start = std::chrono::steady_clock::now();
+        EntityExporter exporter(db, options.format, output);
+        size_t count = exporter.exportEntities(options.entity);
+        output.flush();
+
+        LOG_INFO("Wyeksportowano {} rekordów w {:.1f} s", count,
+                 std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        return output ? 0 : 1;
+    }
+
+    int runImport(const DataIoOptions &options, std::shared_ptr<SQLite::Database> db) {
+        std::ifstream file;
+        std::streamoff totalBytes = 0;
+        if (options.file != "-") {
+            file.open(options.file, std::ios::binary | std::ios::ate);
+            if (!file) {
+                LOG_ERROR("Nie można otworzyć pliku {}", options.file);
+                return 1;
+            }
+            totalBytes = file.tellg();
+            file.seekg(0);
+        }
+        std::istream &input = options.file == "-" ? std::cin : file;
+
+        createDatabaseSchema(*db);
+        EntityImporter importer(db, options.entity);
+        ImportReader reader(input, options.format);
+
+        auto start = std::chrono::steady_clock::now();
+        auto lastProgress = start;
+        size_t imported = 0, committed = 0, rejected = 0, inBatch = 0;
+        json record;
+        std::string error;
+
+        // Każda paczka wierszy jest zatwierdzana osobną transakcją
+        std::optional<SQLite::Transaction> transaction;
+        while (reader.next(record, error)) {
+            if (!transaction) {
+                transaction.emplace(*db);
+            }
+
+            if (error.empty() && importer.importRecord(record, error)) {
+                ++imported;
+            } else {
+                ++rejected;
+                LOG_WARNING("Linia {}: {}", reader.getLine(), error);
+                if (options.strict) {
+                    // Niezatwierdzona paczka jest wycofywana przez destruktor transakcji
+                    LOG_ERROR("Import przerwany, zatwierdzono {} rekordów z wcześniejszych paczek", committed);
+                    return 1;
+                }
+            }
+
+            if (++inBatch >= options.batchSize) {
+                transaction->commit();
+                transaction.reset();
+                committed = imported;
+                inBatch = 0;
+
+                auto now = std::chrono::steady_clock::now();
+                if (now - lastProgress >= std::chrono::seconds(1)) {
+                    lastProgress = now;
+                    double seconds = std::chrono::duration<double>(now - start).count();
+                    if (totalBytes > 0) {
+                        LOG_INFO("Zaimportowano {} rekordów ({:.0f}%, {:.0f} rekordów/s)", imported,
+                                 100.0 * static_cast<double>(file.tellg()) / static_cast<double>(totalBytes),
+                                 static_cast<double>(imported) / seconds);
+                    } else {
+                        LOG_INFO("Zaimportowano {} rekordów ({:.0f} rekordów/s)", imported,
+                                 static_cast<double>(imported) / seconds);
+                    }
+                }
+            }
+        }
+        if (transaction) {
+            transaction->commit();
+        }
+
+        LOG_INFO("Zaimportowano {} rekordów, odrzucono {} w {:.1f} s", imported, rejected,
+                 std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        return rejected > 0 ? 2 : 0;
+    }
+}
+
+/**
+ * @brief Narzędzie do importu i eksportu danych w formatach CSV i NDJSON
+ *
+ * Eksport odczytuje wiersze bezpośrednio z kursora SQLite, a import
+ * przetwarza plik rekord po rekordzie, więc zużycie pamięci nie zależy
+ * od rozmiaru danych.
+ */
+int main(int argc, char *argv[]) {
+    DataIoOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // Dane eksportu mogą trafiać na stdout, więc komunikaty idą na stderr
+    initLogger("DeskPP-DataIO", options.verbose, true);
+
+    try {
+        int flags = options.command == "import" ? SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE
+                                                : SQLite::OPEN_READONLY;
+        auto db = std::make_shared<SQLite::Database>(options.databasePath, flags);
+
+        return options.command == "import" ? runImport(options, db) : runExport(options, db);
+    } catch (const std::exception &e) {
+        LOG_ERROR("Błąd: {}", e.what());
+        return 1;
+    }
+}
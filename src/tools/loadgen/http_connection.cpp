@@ -0,0 +1,185 @@
+#include "http_connection.h"
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <strings.h>
+
+HttpConnection::HttpConnection(std::string host, int port)
+    : _host(std::move(host)), _port(port) {
+}
+
+HttpConnection::~HttpConnection() {
+    close();
+}
+
+bool HttpConnection::connect(std::string &error) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *addresses = nullptr;
+    int rc = getaddrinfo(_host.c_str(), std::to_string(_port).c_str(), &hints, &addresses);
+    if (rc != 0) {
+        error = gai_strerror(rc);
+        return false;
+    }
+
+    for (addrinfo *address = addresses; address; address = address->ai_next) {
+        int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+            // Zapytania są małe, więc algorytm Nagle'a tylko wydłużałby pomiar
+            int flag = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+            _fd = fd;
+            break;
+        }
+        ::close(fd);
+    }
+    freeaddrinfo(addresses);
+
+    if (_fd < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+    _buffer.clear();
+    _keepAlive = true;
+    return true;
+}
+
+void HttpConnection::close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _buffer.clear();
+}
+
+HttpResponse HttpConnection::send(const std::string &method, const std::string &target, const std::string &body) {
+    std::string request = method + " " + target + " HTTP/1.1\r\n"
+                          "Host: " + _host + "\r\n"
+                          "Connection: keep-alive\r\n";
+    if (!body.empty()) {
+        request += "Content-Type: application/json\r\n";
+    }
+    request += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+    request += body;
+
+    // Serwer mógł zamknąć bezczynne połączenie, więc jedno ponowienie jest dopuszczalne
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        HttpResponse response;
+        bool reused = _fd >= 0;
+        if (!reused && !connect(response.error)) {
+            return response;
+        }
+
+        if (writeAll(request) && readResponse(response)) {
+            if (!_keepAlive) {
+                close();
+            }
+            return response;
+        }
+
+        close();
+        if (!reused) {
+            break;
+        }
+    }
+
+    HttpResponse response;
+    response.error = "Połączenie przerwane";
+    return response;
+}
+
+bool HttpConnection::writeAll(const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool HttpConnection::fill() {
+    char chunk[16384];
+    while (true) {
+        ssize_t n = ::recv(_fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        _buffer.append(chunk, static_cast<size_t>(n));
+        return true;
+    }
+}
+
+bool HttpConnection::readResponse(HttpResponse &response) {
+    size_t headerEnd;
+    while ((headerEnd = _buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (!fill()) {
+            return false;
+        }
+    }
+
+    // Linia statusu: HTTP/1.1 200 OK
+    size_t lineEnd = _buffer.find("\r\n");
+    size_t space = _buffer.find(' ');
+    if (space == std::string::npos || space > lineEnd) {
+        return false;
+    }
+    response.status = std::atoi(_buffer.c_str() + space + 1);
+
+    long contentLength = -1;
+    _keepAlive = _buffer.compare(0, 8, "HTTP/1.0") != 0;
+    size_t pos = lineEnd + 2;
+    while (pos < headerEnd) {
+        size_t next = _buffer.find("\r\n", pos);
+        size_t colon = _buffer.find(':', pos);
+        if (colon != std::string::npos && colon < next) {
+            std::string name = _buffer.substr(pos, colon - pos);
+            size_t valueStart = _buffer.find_first_not_of(' ', colon + 1);
+            std::string value = _buffer.substr(valueStart, next - valueStart);
+            if (strcasecmp(name.c_str(), "Content-Length") == 0) {
+                contentLength = std::atol(value.c_str());
+            } else if (strcasecmp(name.c_str(), "Connection") == 0) {
+                _keepAlive = strcasecmp(value.c_str(), "keep-alive") == 0 ||
+                             (_keepAlive && strcasecmp(value.c_str(), "close") != 0);
+            }
+        }
+        pos = next + 2;
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    if (contentLength < 0) {
+        // Bez długości treść kończy się wraz z zamknięciem połączenia
+        while (fill()) {
+        }
+        response.body = _buffer.substr(bodyStart);
+        _buffer.clear();
+        _keepAlive = false;
+        return true;
+    }
+
+    while (_buffer.size() < bodyStart + static_cast<size_t>(contentLength)) {
+        if (!fill()) {
+            return false;
+        }
+    }
+    response.body = _buffer.substr(bodyStart, static_cast<size_t>(contentLength));
+    _buffer.erase(0, bodyStart + static_cast<size_t>(contentLength));
+    return true;
+}
@@ -0,0 +1,93 @@
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include <string>
+
+/**
+ * @brief Odpowiedź HTTP odebrana przez generator obciążenia
+ */
+struct HttpResponse {
+    int status = 0;
+    std::string body;
+    std::string error;
+
+    /**
+     * @brief Sprawdza czy odpowiedź dotarła z serwera
+     * @return Czy nie wystąpił błąd połączenia
+     */
+    bool isTransportOk() const { return status > 0; }
+};
+
+/**
+ * @class HttpConnection
+ * @brief Minimalny, blokujący klient HTTP/1.1 z utrzymywanym połączeniem.
+ *
+ * Używa bezpośrednio gniazd POSIX, aby narzut klienta był mały i przewidywalny
+ * w porównaniu z mierzonym serwerem. Po zerwaniu połączenia zapytanie jest
+ * ponawiane jednokrotnie na nowym połączeniu.
+ */
+class HttpConnection {
+public:
+    /**
+     * @brief Konstruktor
+     * @param host Adres serwera
+     * @param port Port serwera
+     */
+    HttpConnection(std::string host, int port);
+
+    ~HttpConnection();
+
+    HttpConnection(const HttpConnection &) = delete;
+
+    HttpConnection &operator=(const HttpConnection &) = delete;
+
+    /**
+     * @brief Wysyła zapytanie i czeka na odpowiedź
+     * @param method Metoda HTTP
+     * @param target Ścieżka wraz z parametrami
+     * @param body Ciało zapytania JSON (opcjonalne)
+     * @return Odpowiedź serwera
+     */
+    HttpResponse send(const std::string &method, const std::string &target, const std::string &body = "");
+
+private:
+    /**
+     * @brief Nawiązuje połączenie z serwerem
+     * @param error Opis błędu w przypadku niepowodzenia
+     * @return Czy połączenie zostało nawiązane
+     */
+    bool connect(std::string &error);
+
+    /**
+     * @brief Zamyka bieżące połączenie
+     */
+    void close();
+
+    /**
+     * @brief Wysyła cały bufor do gniazda
+     * @param data Dane do wysłania
+     * @return Czy wszystkie dane zostały wysłane
+     */
+    bool writeAll(const std::string &data);
+
+    /**
+     * @brief Odczytuje jedną odpowiedź HTTP z gniazda
+     * @param response Odpowiedź do wypełnienia
+     * @return Czy odpowiedź została odczytana w całości
+     */
+    bool readResponse(HttpResponse &response);
+
+    /**
+     * @brief Dopełnia bufor danymi z gniazda
+     * @return Czy odczytano nowe dane
+     */
+    bool fill();
+
+    std::string _host;
+    int _port;
+    int _fd = -1;
+    bool _keepAlive = true;
+    std::string _buffer;
+};
+
+#endif
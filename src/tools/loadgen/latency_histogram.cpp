@@ -0,0 +1,65 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < LinearBuckets) {
+        return static_cast<int>(value);
+    }
+
+    // Najstarszy bit wyznacza potęgę dwójki, a kolejne 6 bitów kubełek w jej obrębie
+    int exponent = std::bit_width(value) - 1;
+    if (exponent > MaxExponent) {
+        return BucketCount - 1;
+    }
+    int shift = exponent - 6;
+    int mantissa = static_cast<int>(value >> shift) - SubBuckets;
+    return LinearBuckets + (exponent - 7) * SubBuckets + mantissa;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < LinearBuckets) {
+        return static_cast<uint64_t>(index);
+    }
+
+    int offset = index - LinearBuckets;
+    int exponent = 7 + offset / SubBuckets;
+    uint64_t mantissa = SubBuckets + offset % SubBuckets;
+    int shift = exponent - 6;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    ++_buckets[bucketIndex(micros)];
+    ++_count;
+    _sum += micros;
+    _max = std::max(_max, micros);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    for (int i = 0; i < BucketCount; ++i) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _max = std::max(_max, other._max);
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(_count)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), _max);
+        }
+    }
+    return _max;
+}
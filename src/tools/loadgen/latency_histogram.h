@@ -0,0 +1,77 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief Histogram opóźnień o stałej precyzji względnej.
+ *
+ * Wartości w mikrosekundach są grupowane w kubełkach logarytmiczno-liniowych
+ * (64 kubełki na każdą potęgę dwójki), co daje błąd percentyli poniżej 1,6%
+ * przy stałym rozmiarze i bez alokacji podczas pomiaru. Histogramy z wielu
+ * wątków łączy się funkcją merge.
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @brief Zapisuje jedną próbkę
+     * @param micros Opóźnienie w mikrosekundach
+     */
+    void record(uint64_t micros);
+
+    /**
+     * @brief Dołącza próbki z innego histogramu
+     * @param other Histogram źródłowy
+     */
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * @brief Wyznacza percentyl
+     * @param quantile Kwantyl z przedziału [0, 1]
+     * @return Górna granica kubełka zawierającego kwantyl (w mikrosekundach)
+     */
+    uint64_t percentile(double quantile) const;
+
+    /**
+     * @brief Pobiera liczbę próbek
+     * @return Liczba zapisanych próbek
+     */
+    uint64_t getCount() const { return _count; }
+
+    /**
+     * @brief Pobiera największą zapisaną wartość
+     * @return Maksymalne opóźnienie w mikrosekundach
+     */
+    uint64_t getMax() const { return _max; }
+
+    /**
+     * @brief Pobiera średnią wartość próbek
+     * @return Średnie opóźnienie w mikrosekundach
+     */
+    double getMean() const { return _count ? static_cast<double>(_sum) / static_cast<double>(_count) : 0.0; }
+
+private:
+    static constexpr int LinearBuckets = 128;
+    static constexpr int SubBuckets = 64;
+    static constexpr int MaxExponent = 40;
+    static constexpr int BucketCount = LinearBuckets + (MaxExponent - 7 + 1) * SubBuckets;
+
+    /**
+     * @brief Wyznacza indeks kubełka dla wartości
+     */
+    static int bucketIndex(uint64_t value);
+
+    /**
+     * @brief Wyznacza górną granicę kubełka
+     */
+    static uint64_t bucketUpperBound(int index);
+
+    std::array<uint64_t, BucketCount> _buckets{};
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _max = 0;
+};
+
+#endif
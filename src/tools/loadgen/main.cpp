@@ -0,0 +1,538 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#include "http_connection.h"
+#include "latency_histogram.h"
+#include "workload.h"
+#include "common/logger.h"
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const std::string LoadPassword = "loadgen";
+
+    /**
+     * @brief Parametry uruchomienia generatora obciążenia
+     */
+    struct LoadOptions {
+        std::string host = "127.0.0.1";
+        int port = 8080;
+        double rate = 200.0;
+        int duration = 30;
+        int warmup = 5;
+        int connections = 16;
+        double zipfExponent = 1.1;
+        int users = 100;
+        int seedBookings = 0;
+        int horizonDays = 30;
+        uint64_t seed = 1;
+        std::string jsonPath;
+        bool verbose = false;
+        WorkloadMix mix;
+    };
+
+    /**
+     * @brief Wyniki pomiaru pojedynczej trasy
+     */
+    struct RouteStats {
+        LatencyHistogram latency;
+        uint64_t ok = 0;
+        uint64_t rejected = 0;
+        uint64_t errors = 0;
+
+        void merge(const RouteStats &other) {
+            latency.merge(other.latency);
+            ok += other.ok;
+            rejected += other.rejected;
+            errors += other.errors;
+        }
+    };
+
+    using RouteStatsTable = std::array<RouteStats, RouteCount>;
+
+    /**
+     * @class BookingPool
+     * @brief Identyfikatory rezerwacji utworzonych podczas testu, dostępne do anulowania.
+     */
+    class BookingPool {
+    public:
+        void add(int bookingId) {
+            std::lock_guard lock(_mutex);
+            _ids.push_back(bookingId);
+        }
+
+        std::optional<int> take(std::mt19937_64 &rng) {
+            std::lock_guard lock(_mutex);
+            if (_ids.empty()) {
+                return std::nullopt;
+            }
+            size_t index = std::uniform_int_distribution<size_t>(0, _ids.size() - 1)(rng);
+            std::swap(_ids[index], _ids.back());
+            int id = _ids.back();
+            _ids.pop_back();
+            return id;
+        }
+
+        size_t size() {
+            std::lock_guard lock(_mutex);
+            return _ids.size();
+        }
+
+    private:
+        std::mutex _mutex;
+        std::vector<int> _ids;
+    };
+
+    /**
+     * @brief Dane współdzielone przez wątki generujące ruch
+     */
+    struct LoadContext {
+        const LoadOptions &options;
+        std::vector<LoadUser> users;
+        // Biurka uporządkowane od najpopularniejszego
+        std::vector<LoadDesk> desks;
+        ZipfSampler deskSampler;
+        BookingPool bookings;
+    };
+
+    void printUsage() {
+        std::printf(
+            "Użycie: deskpp_loadgen [opcje]\n"
+            "  --host <adres>           adres serwera (domyślnie 127.0.0.1)\n"
+            "  --port, -p <port>        port serwera (domyślnie 8080)\n"
+            "  --rate <req/s>           docelowa liczba zapytań na sekundę w pętli otwartej,\n"
+            "                           0 oznacza pętlę zamkniętą (domyślnie 200)\n"
+            "  --duration <s>           czas pomiaru (domyślnie 30)\n"
+            "  --warmup <s>             czas rozgrzewki pomijany w wynikach (domyślnie 5)\n"
+            "  --connections <n>        liczba równoległych połączeń (domyślnie 16)\n"
+            "  --mix <spec>             udział tras, np. login=5,buildings=10,floor=55,book=20,cancel=10\n"
+            "  --zipf <s>               skośność popularności biurek, 0 = rozkład jednostajny (domyślnie 1.1)\n"
+            "  --users <n>              liczba użytkowników testowych (domyślnie 100)\n"
+            "  --seed-bookings <n>      liczba rezerwacji tworzonych przed pomiarem (domyślnie 0)\n"
+            "  --horizon <dni>          zakres dat nowych rezerwacji (domyślnie 30)\n"
+            "  --seed <n>               ziarno generatora liczb losowych (domyślnie 1)\n"
+            "  --json <plik>            zapisuje wyniki w formacie JSON\n"
+            "  --verbose, -v            włącza szczegółowe logowanie\n");
+    }
+
+    bool parseOptions(int argc, char *argv[], LoadOptions &options) {
+        std::string error;
+        try {
+            for (int i = 1; i < argc; i++) {
+                auto is = [&](const char *name) { return strcmp(argv[i], name) == 0; };
+                bool hasValue = i + 1 < argc;
+
+                if (is("--help") || is("-h")) {
+                    printUsage();
+                    std::exit(0);
+                } else if (is("--verbose") || is("-v")) {
+                    options.verbose = true;
+                } else if (!hasValue) {
+                    error = std::string("Brak wartości lub nieznana opcja: ") + argv[i];
+                    break;
+                } else if (is("--host")) {
+                    options.host = argv[++i];
+                } else if (is("--port") || is("-p")) {
+                    options.port = std::stoi(argv[++i]);
+                } else if (is("--rate")) {
+                    options.rate = std::stod(argv[++i]);
+                } else if (is("--duration")) {
+                    options.duration = std::stoi(argv[++i]);
+                } else if (is("--warmup")) {
+                    options.warmup = std::stoi(argv[++i]);
+                } else if (is("--connections")) {
+                    options.connections = std::max(1, std::stoi(argv[++i]));
+                } else if (is("--mix")) {
+                    if (!options.mix.parse(argv[++i], error)) {
+                        break;
+                    }
+                } else if (is("--zipf")) {
+                    options.zipfExponent = std::stod(argv[++i]);
+                } else if (is("--users")) {
+                    options.users = std::max(1, std::stoi(argv[++i]));
+                } else if (is("--seed-bookings")) {
+                    options.seedBookings = std::stoi(argv[++i]);
+                } else if (is("--horizon")) {
+                    options.horizonDays = std::max(1, std::stoi(argv[++i]));
+                } else if (is("--seed")) {
+                    options.seed = std::stoull(argv[++i]);
+                } else if (is("--json")) {
+                    options.jsonPath = argv[++i];
+                } else {
+                    error = std::string("Nieznana opcja: ") + argv[i];
+                    break;
+                }
+            }
+        } catch (const std::exception &) {
+            error = "Nieprawidłowa wartość liczbowa";
+        }
+
+        if (!error.empty()) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            printUsage();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Formatuje datę przesuniętą o podaną liczbę dni od dzisiaj
+     */
+    std::string dateFromToday(int days) {
+        using namespace std::chrono;
+        auto today = floor<std::chrono::days>(system_clock::now());
+        year_month_day ymd{today + std::chrono::days{days}};
+        char buffer[11];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u",
+                      static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()),
+                      static_cast<unsigned>(ymd.day()));
+        return buffer;
+    }
+
+    /**
+     * @brief Parsuje odpowiedź serwera (niepoprawny JSON daje wartość bez pól)
+     */
+    json parseBody(const HttpResponse &response) {
+        return json::parse(response.body, nullptr, false);
+    }
+
+    /**
+     * @brief Rejestruje (jeśli potrzeba) i loguje użytkowników testowych
+     */
+    std::vector<LoadUser> prepareUsers(HttpConnection &connection, int count) {
+        std::vector<LoadUser> users;
+        users.reserve(count);
+
+        for (int i = 1; i <= count; ++i) {
+            std::string username = "loadgen_" + std::to_string(i);
+            json credentials = {{"username", username}, {"password", LoadPassword}};
+
+            // Odpowiedź błędu oznacza zwykle, że użytkownik istnieje z poprzedniego uruchomienia
+            json registration = credentials;
+            registration["email"] = username + "@example.com";
+            connection.send("POST", "/api/users/register", registration.dump());
+
+            auto response = connection.send("POST", "/api/users/login", credentials.dump());
+            json body = parseBody(response);
+            if (response.status != 200 || !body.contains("user")) {
+                LOG_ERROR("Nie udało się zalogować użytkownika {}: {} {}", username, response.status,
+                          response.error);
+                return {};
+            }
+            users.push_back({body["user"].value("id", 0), username});
+        }
+        return users;
+    }
+
+    /**
+     * @brief Pobiera listę biurek ze wszystkich budynków
+     */
+    std::vector<LoadDesk> fetchDesks(HttpConnection &connection) {
+        std::vector<LoadDesk> desks;
+
+        json buildings = parseBody(connection.send("GET", "/api/buildings"));
+        if (!buildings.contains("buildings")) {
+            return desks;
+        }
+
+        for (const auto &building: buildings["buildings"]) {
+            int buildingId = building.value("id", 0);
+            json body = parseBody(connection.send("GET", "/api/desks?buildingId=" + std::to_string(buildingId)));
+            if (!body.contains("desks")) {
+                continue;
+            }
+            for (const auto &desk: body["desks"]) {
+                desks.push_back({desk.value("id", 0), desk.value("buildingId", buildingId), desk.value("floor", 1)});
+            }
+        }
+        return desks;
+    }
+
+    /**
+     * @brief Wysyła zapytanie dla wylosowanej trasy
+     * @return Faktycznie wykonana trasa i odpowiedź serwera
+     */
+    std::pair<Route, HttpResponse> execute(HttpConnection &connection, Route route, LoadContext &context,
+                                           std::mt19937_64 &rng) {
+        const auto &options = context.options;
+        auto randomUser = [&]() -> const LoadUser & {
+            return context.users[std::uniform_int_distribution<size_t>(0, context.users.size() - 1)(rng)];
+        };
+
+        if (route == Route::BookCancel) {
+            if (auto bookingId = context.bookings.take(rng)) {
+                return {route, connection.send("DELETE", "/api/bookings/" + std::to_string(*bookingId))};
+            }
+            // Brak rezerwacji do anulowania - utwórz nową
+            route = Route::BookCreate;
+        }
+
+        switch (route) {
+            case Route::Login: {
+                json credentials = {{"username", randomUser().username}, {"password", LoadPassword}};
+                return {route, connection.send("POST", "/api/users/login", credentials.dump())};
+            }
+            case Route::Buildings:
+                return {route, connection.send("GET", "/api/buildings")};
+            case Route::FloorView: {
+                const auto &desk = context.desks[context.deskSampler.sample(rng)];
+                return {route, connection.send("GET", "/api/desks?buildingId=" + std::to_string(desk.buildingId) +
+                                                      "&floor=" + std::to_string(desk.floor))};
+            }
+            case Route::BookCreate:
+            default: {
+                const auto &desk = context.desks[context.deskSampler.sample(rng)];
+                int day = std::uniform_int_distribution<int>(0, options.horizonDays - 1)(rng);
+                // Większość rezerwacji jest jednodniowa, część obejmuje kilka dni
+                int length = std::min(std::geometric_distribution<int>(0.7)(rng), 4);
+                json booking = {
+                    {"deskId", desk.id},
+                    {"userId", randomUser().id},
+                    {"dateFrom", dateFromToday(day)},
+                    {"dateTo", dateFromToday(day + length)}
+                };
+                auto response = connection.send("POST", "/api/bookings", booking.dump());
+                if (response.status == 200) {
+                    json body = parseBody(response);
+                    if (body.contains("booking")) {
+                        context.bookings.add(body["booking"].value("id", 0));
+                    }
+                }
+                return {Route::BookCreate, response};
+            }
+        }
+    }
+
+    /**
+     * @brief Zapisuje wynik zapytania w statystykach trasy
+     */
+    void recordResult(RouteStats &stats, const HttpResponse &response, Clock::duration latency) {
+        stats.latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+        if (response.status >= 200 && response.status < 300) {
+            ++stats.ok;
+        } else if (response.status >= 400 && response.status < 500) {
+            ++stats.rejected;
+        } else {
+            ++stats.errors;
+        }
+    }
+
+    /**
+     * @brief Tworzy rezerwacje przed pomiarem, równolegle na wszystkich połączeniach
+     */
+    void seedBookings(LoadContext &context) {
+        const auto &options = context.options;
+        std::atomic<int> remaining(options.seedBookings);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < options.connections; ++t) {
+            threads.emplace_back([&, t]() {
+                HttpConnection connection(options.host, options.port);
+                std::mt19937_64 rng(options.seed * 7919 + t);
+                while (remaining.fetch_sub(1) > 0) {
+                    execute(connection, Route::BookCreate, context, rng);
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Generuje ruch na jednym połączeniu
+     *
+     * W pętli otwartej zapytania są planowane według procesu Poissona niezależnie
+     * od czasu odpowiedzi, a opóźnienie liczone jest od zaplanowanej chwili wysłania.
+     * Dzięki temu kolejkowanie po stronie klienta przy przeciążonym serwerze jest
+     * widoczne w percentylach zamiast zaniżać wyniki.
+     */
+    void runWorker(int index, LoadContext &context, Clock::time_point start, RouteStatsTable &stats) {
+        const auto &options = context.options;
+        HttpConnection connection(options.host, options.port);
+        std::mt19937_64 rng(options.seed + static_cast<uint64_t>(index) * 104729);
+        WorkloadMix mix = options.mix;
+
+        const auto warmupEnd = start + std::chrono::seconds(options.warmup);
+        const auto end = warmupEnd + std::chrono::seconds(options.duration);
+        const bool openLoop = options.rate > 0;
+        std::exponential_distribution<double> interArrival(openLoop ? options.rate / options.connections : 1.0);
+
+        auto scheduled = start;
+        while (true) {
+            if (openLoop) {
+                scheduled += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(interArrival(rng)));
+                if (scheduled >= end) {
+                    break;
+                }
+                std::this_thread::sleep_until(scheduled);
+            } else {
+                scheduled = Clock::now();
+                if (scheduled >= end) {
+                    break;
+                }
+            }
+
+            auto [route, response] = execute(connection, mix.pick(rng), context, rng);
+            if (scheduled >= warmupEnd) {
+                recordResult(stats[static_cast<int>(route)], response, Clock::now() - scheduled);
+            }
+        }
+    }
+
+    /**
+     * @brief Wypisuje tabelę wyników i opcjonalnie zapisuje je w formacie JSON
+     */
+    void report(const LoadOptions &options, const RouteStatsTable &stats) {
+        auto ms = [](uint64_t micros) { return static_cast<double>(micros) / 1000.0; };
+        const double seconds = options.duration;
+
+        RouteStats total;
+        json routes = json::object();
+
+        std::printf("\n%-10s %9s %9s %8s %8s %9s %9s %9s %9s %9s\n",
+                    "trasa", "zapytania", "req/s", "odrzuc.", "błędy", "p50 ms", "p95 ms", "p99 ms", "p999 ms",
+                    "max ms");
+
+        auto printRow = [&](const char *name, const RouteStats &routeStats) {
+            const auto &latency = routeStats.latency;
+            std::printf("%-10s %9llu %9.1f %8llu %8llu %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                        name, static_cast<unsigned long long>(latency.getCount()),
+                        static_cast<double>(latency.getCount()) / seconds,
+                        static_cast<unsigned long long>(routeStats.rejected),
+                        static_cast<unsigned long long>(routeStats.errors),
+                        ms(latency.percentile(0.50)), ms(latency.percentile(0.95)),
+                        ms(latency.percentile(0.99)), ms(latency.percentile(0.999)), ms(latency.getMax()));
+
+            double count = static_cast<double>(std::max<uint64_t>(latency.getCount(), 1));
+            return json{
+                {"requests", latency.getCount()},
+                {"throughput", static_cast<double>(latency.getCount()) / seconds},
+                {"ok", routeStats.ok},
+                {"rejected", routeStats.rejected},
+                {"errors", routeStats.errors},
+                {"errorRate", static_cast<double>(routeStats.errors) / count},
+                {"rejectedRate", static_cast<double>(routeStats.rejected) / count},
+                {"latencyMs", {
+                    {"mean", latency.getMean() / 1000.0},
+                    {"p50", ms(latency.percentile(0.50))},
+                    {"p95", ms(latency.percentile(0.95))},
+                    {"p99", ms(latency.percentile(0.99))},
+                    {"p999", ms(latency.percentile(0.999))},
+                    {"max", ms(latency.getMax())}
+                }}
+            };
+        };
+
+        for (int i = 0; i < RouteCount; ++i) {
+            if (stats[i].latency.getCount() == 0) {
+                continue;
+            }
+            routes[routeName(static_cast<Route>(i))] = printRow(routeName(static_cast<Route>(i)), stats[i]);
+            total.merge(stats[i]);
+        }
+        json totalJson = printRow("razem", total);
+
+        if (options.rate > 0) {
+            std::printf("\nDocelowe obciążenie: %.1f req/s, osiągnięte: %.1f req/s\n", options.rate,
+                        static_cast<double>(total.latency.getCount()) / seconds);
+        }
+
+        if (!options.jsonPath.empty()) {
+            json result = {
+                {"host", options.host},
+                {"port", options.port},
+                {"targetRate", options.rate},
+                {"durationSeconds", options.duration},
+                {"warmupSeconds", options.warmup},
+                {"connections", options.connections},
+                {"mix", options.mix.describe()},
+                {"zipfExponent", options.zipfExponent},
+                {"routes", routes},
+                {"total", totalJson}
+            };
+            std::ofstream file(options.jsonPath);
+            file << result.dump(2) << '\n';
+            LOG_INFO("Wyniki zapisano w {}", options.jsonPath);
+        }
+    }
+}
+
+/**
+ * @brief Generator obciążenia HTTP dla serwera DeskPP
+ *
+ * Przygotowuje użytkowników testowych i opcjonalnie rezerwacje, a następnie
+ * generuje ruch o zadanej mieszance tras i raportuje percentyle opóźnień,
+ * przepustowość oraz odsetek błędów dla każdej trasy.
+ */
+int main(int argc, char *argv[]) {
+    LoadOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    initLogger("DeskPP-LoadGen", options.verbose);
+    LOG_INFO("Cel: {}:{}, mieszanka: {}", options.host, options.port, options.mix.describe());
+
+    HttpConnection setupConnection(options.host, options.port);
+    auto users = prepareUsers(setupConnection, options.users);
+    if (users.empty()) {
+        LOG_ERROR("Brak użytkowników testowych - czy serwer działa?");
+        return 1;
+    }
+
+    auto desks = fetchDesks(setupConnection);
+    if (desks.empty()) {
+        LOG_ERROR("Serwer nie zwrócił żadnych biurek");
+        return 1;
+    }
+
+    // Popularność biurek nie powinna zależeć od kolejności identyfikatorów
+    std::mt19937_64 shuffleRng(options.seed);
+    std::shuffle(desks.begin(), desks.end(), shuffleRng);
+
+    LoadContext context{options, std::move(users), std::move(desks), ZipfSampler(0, 0), {}};
+    context.deskSampler = ZipfSampler(context.desks.size(), options.zipfExponent);
+    LOG_INFO("Użytkownicy: {}, biurka: {}", context.users.size(), context.desks.size());
+
+    if (options.seedBookings > 0) {
+        auto seedStart = Clock::now();
+        seedBookings(context);
+        LOG_INFO("Utworzono {} rezerwacji w {:.1f} s", context.bookings.size(),
+                 std::chrono::duration<double>(Clock::now() - seedStart).count());
+    }
+
+    LOG_INFO("Rozgrzewka {} s, pomiar {} s, połączenia: {}, obciążenie: {}", options.warmup, options.duration,
+             options.connections,
+             options.rate > 0 ? std::to_string(options.rate) + " req/s" : std::string("pętla zamknięta"));
+
+    std::vector<RouteStatsTable> workerStats(options.connections);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int i = 0; i < options.connections; ++i) {
+        workers.emplace_back(runWorker, i, std::ref(context), start, std::ref(workerStats[i]));
+    }
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    RouteStatsTable stats;
+    for (const auto &table: workerStats) {
+        for (int i = 0; i < RouteCount; ++i) {
+            stats[i].merge(table[i]);
+        }
+    }
+    report(options, stats);
+    return 0;
+}
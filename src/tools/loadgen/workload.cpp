@@ -0,0 +1,98 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+    constexpr std::array<const char *, RouteCount> RouteNames = {
+        "login", "buildings", "floor", "book", "cancel"
+    };
+}
+
+const char *routeName(Route route) {
+    return RouteNames[static_cast<int>(route)];
+}
+
+WorkloadMix::WorkloadMix()
+    : _weights{5, 10, 55, 20, 10},
+      _distribution(_weights.begin(), _weights.end()) {
+}
+
+bool WorkloadMix::parse(const std::string &spec, std::string &error) {
+    std::array<double, RouteCount> weights{};
+    std::stringstream stream(spec);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        auto separator = item.find('=');
+        if (separator == std::string::npos) {
+            error = "Oczekiwano pary trasa=waga: " + item;
+            return false;
+        }
+
+        std::string name = item.substr(0, separator);
+        auto it = std::find(RouteNames.begin(), RouteNames.end(), name);
+        if (it == RouteNames.end()) {
+            error = "Nieznana trasa: " + name;
+            return false;
+        }
+
+        try {
+            double weight = std::stod(item.substr(separator + 1));
+            if (weight < 0) {
+                throw std::invalid_argument("ujemna waga");
+            }
+            weights[it - RouteNames.begin()] = weight;
+        } catch (const std::exception &) {
+            error = "Nieprawidłowa waga: " + item;
+            return false;
+        }
+    }
+
+    if (std::all_of(weights.begin(), weights.end(), [](double w) { return w == 0; })) {
+        error = "Mieszanka ruchu nie zawiera żadnej trasy";
+        return false;
+    }
+
+    _weights = weights;
+    _distribution = std::discrete_distribution<int>(_weights.begin(), _weights.end());
+    return true;
+}
+
+Route WorkloadMix::pick(std::mt19937_64 &rng) {
+    return static_cast<Route>(_distribution(rng));
+}
+
+std::string WorkloadMix::describe() const {
+    std::string result;
+    for (int i = 0; i < RouteCount; ++i) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        std::ostringstream weight;
+        weight << _weights[i];
+        result += std::string(RouteNames[i]) + "=" + weight.str();
+    }
+    return result;
+}
+
+ZipfSampler::ZipfSampler(size_t count, double exponent) {
+    _cdf.reserve(count);
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+        _cdf.push_back(sum);
+    }
+    for (auto &value: _cdf) {
+        value /= sum;
+    }
+}
+
+size_t ZipfSampler::sample(std::mt19937_64 &rng) const {
+    if (_cdf.empty()) {
+        return 0;
+    }
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    auto it = std::lower_bound(_cdf.begin(), _cdf.end(), u);
+    return std::min(static_cast<size_t>(it - _cdf.begin()), _cdf.size() - 1);
+}
@@ -0,0 +1,109 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Trasy API obciążane przez generator
+ */
+enum class Route {
+    Login,
+    Buildings,
+    FloorView,
+    BookCreate,
+    BookCancel
+};
+
+constexpr int RouteCount = 5;
+
+/**
+ * @brief Pobiera nazwę trasy używaną w parametrach i raporcie
+ * @param route Trasa
+ * @return Nazwa trasy
+ */
+const char *routeName(Route route);
+
+/**
+ * @class WorkloadMix
+ * @brief Udział poszczególnych tras w generowanym ruchu.
+ */
+class WorkloadMix {
+public:
+    /**
+     * @brief Tworzy domyślną mieszankę ruchu (przewaga widoku piętra)
+     */
+    WorkloadMix();
+
+    /**
+     * @brief Parsuje mieszankę w formacie "login=5,buildings=10,floor=55,book=20,cancel=10"
+     * @param spec Opis mieszanki
+     * @param error Opis błędu w przypadku niepowodzenia
+     * @return Czy opis był poprawny
+     */
+    bool parse(const std::string &spec, std::string &error);
+
+    /**
+     * @brief Losuje trasę zgodnie z wagami
+     * @param rng Generator liczb losowych
+     * @return Wylosowana trasa
+     */
+    Route pick(std::mt19937_64 &rng);
+
+    /**
+     * @brief Zwraca opis mieszanki
+     * @return Opis w formacie akceptowanym przez parse
+     */
+    std::string describe() const;
+
+private:
+    std::array<double, RouteCount> _weights;
+    std::discrete_distribution<int> _distribution;
+};
+
+/**
+ * @class ZipfSampler
+ * @brief Losuje indeksy z rozkładu Zipfa, modelując popularne biurka.
+ *
+ * Indeks 0 jest najczęściej wybierany. Wykładnik 0 daje rozkład jednostajny.
+ */
+class ZipfSampler {
+public:
+    /**
+     * @brief Konstruktor
+     * @param count Liczba elementów
+     * @param exponent Wykładnik rozkładu (skośność)
+     */
+    ZipfSampler(size_t count, double exponent);
+
+    /**
+     * @brief Losuje indeks elementu
+     * @param rng Generator liczb losowych
+     * @return Indeks z przedziału [0, count)
+     */
+    size_t sample(std::mt19937_64 &rng) const;
+
+private:
+    std::vector<double> _cdf;
+};
+
+/**
+ * @brief Biurko znane generatorowi obciążenia
+ */
+struct LoadDesk {
+    int id = 0;
+    int buildingId = 0;
+    int floor = 0;
+};
+
+/**
+ * @brief Użytkownik testowy znany generatorowi obciążenia
+ */
+struct LoadUser {
+    int id = 0;
+    std::string username;
+};
+
+#endif